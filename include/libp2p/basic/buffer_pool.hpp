@@ -0,0 +1,66 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <libp2p/common/types.hpp>
+
+namespace libp2p::basic {
+
+  /// Pool of byte buffers of power of 2 size classes, reduces heap churn of
+  /// buffers which are allocated and freed frequently (i.e. read buffer
+  /// fragments). Thread safe, so it may be shared by connections running on
+  /// different threads
+  class BufferPool {
+   public:
+    static constexpr size_t kMinSizeClassLog2 = 12;  // 4 KiB
+    static constexpr size_t kMaxSizeClassLog2 = 22;  // 4 MiB
+    static constexpr size_t kSizeClasses =
+        kMaxSizeClassLog2 - kMinSizeClassLog2 + 1;
+    static constexpr size_t kDefaultMaxResidentBytes = 16 * 1024 * 1024;
+
+    struct Stats {
+      /// Buffers taken from the pool
+      uint64_t hits = 0;
+
+      /// Buffers allocated since the pool had no buffer of that class
+      uint64_t misses = 0;
+
+      /// Buffers not returned to the pool due to resident bytes limit
+      uint64_t drops = 0;
+
+      /// Capacity of buffers kept in the pool
+      size_t resident_bytes = 0;
+    };
+
+    explicit BufferPool(
+        size_t max_resident_bytes = kDefaultMaxResidentBytes);
+
+    /// Returns empty buffer with capacity >= size
+    Bytes acquire(size_t size);
+
+    /// Returns buffer to the pool, buffers of unsupported capacity and
+    /// buffers exceeding resident bytes limit are deallocated
+    void release(Bytes &&buffer);
+
+    /// Deallocates all buffers kept
+    void clear();
+
+    Stats stats() const;
+
+   private:
+    mutable std::mutex mutex_;
+    size_t max_resident_bytes_;
+    Stats stats_;
+    std::array<std::vector<Bytes>, kSizeClasses> free_;
+  };
+
+}  // namespace libp2p::basic
@@ -0,0 +1,65 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace libp2p::basic {
+
+  /// Accounts memory reserved for received data (i.e. muxed streams' receive
+  /// windows). Connection-wide budget may have parent (host-wide) budget,
+  /// reservations are made in both. Thread safe, as host-wide budget is
+  /// shared by connections
+  class MemoryBudget {
+   public:
+    explicit MemoryBudget(size_t limit,
+                          std::shared_ptr<MemoryBudget> parent = nullptr);
+
+    MemoryBudget(const MemoryBudget &) = delete;
+    MemoryBudget &operator=(const MemoryBudget &) = delete;
+    MemoryBudget(MemoryBudget &&) = delete;
+    MemoryBudget &operator=(MemoryBudget &&) = delete;
+
+    /// Returns reservations to parent
+    ~MemoryBudget();
+
+    /// Reserves bytes if they fit into this and parent budgets
+    bool reserve(size_t bytes);
+
+    /// Reserves as many bytes as available, up to bytes
+    /// @return reserved bytes
+    size_t reserveUpTo(size_t bytes);
+
+    /// Returns previously reserved bytes
+    void release(size_t bytes);
+
+    /// Bytes which may be reserved, with respect to parent budget
+    size_t available() const;
+
+    size_t used() const {
+      return used_.load(std::memory_order_relaxed);
+    }
+
+    size_t limit() const {
+      return limit_;
+    }
+
+   private:
+    /// Reserves up to bytes in this budget only
+    size_t take(size_t bytes);
+
+    /// Returns bytes to this budget only
+    void put(size_t bytes);
+
+    size_t limit_;
+    std::atomic<size_t> used_ = 0;
+    std::shared_ptr<MemoryBudget> parent_;
+  };
+
+}  // namespace libp2p::basic
@@ -7,26 +7,78 @@
 #pragma once
 
 #include <deque>
+#include <memory>
 #include <vector>
 
 #include <boost/optional.hpp>
 
+#include <libp2p/basic/buffer_pool.hpp>
 #include <libp2p/common/types.hpp>
 
 namespace libp2p::basic {
 
+  /// Fixed size byte array allocated without zero initialization, for
+  /// receive buffers which are overwritten by reads anyway
+  class UninitializedBytes {
+   public:
+    explicit UninitializedBytes(size_t size)
+        : data_{std::make_unique_for_overwrite<uint8_t[]>(size)},
+          size_{size} {}
+
+    uint8_t *data() {
+      return data_.get();
+    }
+
+    const uint8_t *data() const {
+      return data_.get();
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    uint8_t *begin() {
+      return data();
+    }
+
+    uint8_t *end() {
+      return data() + size_;
+    }
+
+    const uint8_t *begin() const {
+      return data();
+    }
+
+    const uint8_t *end() const {
+      return data() + size_;
+    }
+
+   private:
+    std::unique_ptr<uint8_t[]> data_;
+    size_t size_;
+  };
+
   class ReadBuffer {
    public:
     static constexpr size_t kDefaultAllocGranularity = 65536;
 
+    /// Shared data is referenced only if it takes at least 1/N of its owner's
+    /// memory, smaller pieces are copied not to pin large buffers
+    static constexpr size_t kMaxSharedOverhead = 4;
+
+    /// Memory which fragments may reference instead of copying
+    using SharedBytes = std::shared_ptr<const UninitializedBytes>;
+
     ReadBuffer(const ReadBuffer &) = delete;
     ReadBuffer &operator=(const ReadBuffer &) = delete;
 
-    ~ReadBuffer() = default;
+    ~ReadBuffer();
     ReadBuffer(ReadBuffer &&) = default;
     ReadBuffer &operator=(ReadBuffer &&) = default;
 
-    explicit ReadBuffer(size_t alloc_granularity = kDefaultAllocGranularity);
+    /// If pool is set, fragments are allocated from and returned to it
+    explicit ReadBuffer(size_t alloc_granularity = kDefaultAllocGranularity,
+                        std::shared_ptr<BufferPool> pool = nullptr);
 
     size_t size() const {
       return total_size_;
@@ -36,20 +88,40 @@ namespace libp2p::basic {
       return total_size_ == 0;
     }
 
-    /// Adds new data to the buffer
-    void add(BytesIn bytes);
+    /// Adds new data to the buffer. If owner of bytes is passed, then bytes
+    /// may be referenced instead of copying (see kMaxSharedOverhead)
+    void add(BytesIn bytes, const SharedBytes &owner = nullptr);
 
     /// Returns # of bytes actually copied into out
     size_t consume(BytesOut out);
 
-    /// Returns # of bytes actually copied into out
-    size_t addAndConsume(BytesIn in, BytesOut out);
+    /// Returns # of bytes actually copied into out, see add() for owner
+    size_t addAndConsume(BytesIn in,
+                         BytesOut out,
+                         const SharedBytes &owner = nullptr);
 
     /// Clears and deallocates
     void clear();
 
+    /// Clears, fragments are deallocated (returned to pool if set), but the
+    /// fragments table is kept for reuse
+    void reset();
+
    private:
-    using Fragment = std::vector<uint8_t>;
+    struct Fragment {
+      /// Bytes owned by fragment, if not shared
+      Bytes bytes;
+
+      /// Owner of shared bytes
+      SharedBytes owner;
+
+      /// Shared bytes
+      BytesIn shared;
+
+      BytesIn data() const {
+        return owner ? shared : BytesIn{bytes};
+      }
+    };
 
     /// Consumes all data into out
     size_t consumeAll(BytesOut out);
@@ -57,16 +129,30 @@ namespace libp2p::basic {
     /// Consumes the 1st fragment or part of it
     size_t consumePart(uint8_t *out, size_t n);
 
+    /// Capacity to allocate for a fragment holding size bytes: size plus
+    /// granularity, or pool size class of at least granularity if pool is set
+    size_t capacityFor(size_t size) const;
+
+    /// Reallocates bytes to given capacity, using pool if set
+    void reserve(Bytes &bytes, size_t capacity);
+
+    /// Returns fragment memory to pool if set
+    void deallocate(Fragment &fragment);
+
     /// Granularity for coarse allocation
     size_t alloc_granularity_;
 
+    /// Optional fragments pool
+    std::shared_ptr<BufferPool> pool_;
+
     /// Total size of unconsumed bytes
     size_t total_size_;
 
     /// The 1st fragment may advance
     size_t first_byte_offset_;
 
-    /// Available allocated bytes remains in the last fragment
+    /// Available allocated bytes remains in the last fragment, zero if it is
+    /// shared
     size_t capacity_remains_;
 
     /// Fragments allocated
@@ -60,6 +60,6 @@ namespace libp2p::basic {
     };
     Callbacks callbacks_;
 
-    Time timer_;
+    Time timer_{};
   };
 }  // namespace libp2p::basic
@@ -42,4 +42,51 @@ namespace libp2p {
           write(writer, in.subspan(n), std::move(cb));
         });
   }
+
+  /// Write exactly total size of `in` buffers.
+  /// `in` is advanced during the operation, so caller must keep both buffers
+  /// and their spans alive until callback is called
+  inline void writeV(const std::shared_ptr<basic::Writer> &writer,
+                     std::span<BytesIn> in,
+                     std::function<void(outcome::result<void>)> cb) {
+    while (!in.empty() && in.front().empty()) {
+      in = in.subspan(1);
+    }
+    if (in.empty()) {
+      return cb(outcome::success());
+    }
+    writer->writeSomeV(
+        in,
+        [weak{std::weak_ptr{writer}}, in, cb{std::move(cb)}](
+            outcome::result<size_t> n_res) mutable {
+          if (n_res.has_error()) {
+            return cb(n_res.error());
+          }
+          auto n = n_res.value();
+          if (n == 0) {
+            throw std::logic_error{"libp2p::writeV zero bytes written"};
+          }
+          while (n != 0 && !in.empty()) {
+            if (n < in.front().size()) {
+              in.front() = in.front().subspan(n);
+              break;
+            }
+            n -= in.front().size();
+            in = in.subspan(1);
+          }
+          if (in.empty()) {
+            if (n != 0) {
+              throw std::logic_error{"libp2p::writeV too much bytes written"};
+            }
+            // successfully wrote last bytes
+            return cb(outcome::success());
+          }
+          // write remaining bytes
+          auto writer = weak.lock();
+          if (!writer) {
+            return cb(make_error_code(boost::asio::error::operation_aborted));
+          }
+          writeV(writer, in, std::move(cb));
+        });
+  }
 }  // namespace libp2p
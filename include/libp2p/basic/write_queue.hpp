@@ -55,6 +55,9 @@ namespace libp2p::basic {
     /// Deallocates memory
     void clear();
 
+    /// Clears, keeps memory allocated for reuse
+    void reset();
+
    private:
     /// Data item w/callback
     struct Data {
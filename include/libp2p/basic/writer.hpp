@@ -7,6 +7,7 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 
 #include <libp2p/common/types.hpp>
 #include <libp2p/outcome/outcome.hpp>
@@ -34,6 +35,48 @@ namespace libp2p::basic {
      */
     virtual void writeSome(BytesIn in, WriteCallbackFunc cb) = 0;
 
+    /**
+     * @brief Vectored (gather) version of writeSome: writes up to total size
+     * of {@code} in {@nocode} buffers, in order.
+     * Default implementation joins several non-empty buffers into one and
+     * writes it with writeSome(), so that secure and message based
+     * transports don't split them into separate frames. Implementations able
+     * to write several buffers at once should override
+     * @param in buffers to write, their content must be valid until callback
+     * is executed, but the span of buffers itself may be released on return
+     * @param cb callback with result of operation
+     */
+    virtual void writeSomeV(std::span<const BytesIn> in, WriteCallbackFunc cb) {
+      const BytesIn *single = nullptr;
+      size_t total = 0;
+      for (auto &buffer : in) {
+        if (buffer.empty()) {
+          continue;
+        }
+        if (total == 0) {
+          single = &buffer;
+        } else {
+          single = nullptr;
+        }
+        total += buffer.size();
+      }
+      if (total == 0) {
+        return writeSome(BytesIn{}, std::move(cb));
+      }
+      if (single != nullptr) {
+        return writeSome(*single, std::move(cb));
+      }
+      auto joined = std::make_shared<Bytes>();
+      joined->reserve(total);
+      for (auto &buffer : in) {
+        joined->insert(joined->end(), buffer.begin(), buffer.end());
+      }
+      writeSome(*joined,
+                [joined, cb{std::move(cb)}](outcome::result<size_t> r) {
+                  cb(r);
+                });
+    }
+
     /**
      * @brief Defers reporting error state to callback to avoid reentrancy
      * (i.e. callback will not be called before initiator function returns)
@@ -0,0 +1,123 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+
+#include <libp2p/outcome/outcome.hpp>
+
+namespace libp2p {
+
+  /// Lookup counters of LruCache
+  struct LruCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+
+    /// Share of lookups served from cache, 0 if there were no lookups
+    double hitRate() const {
+      auto total = hits + misses;
+      return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+    }
+  };
+
+  /**
+   * Bounded thread-safe cache, evicts least recently used entries.
+   * Values are returned by copy, so they should be cheap to copy (e.g.
+   * shared_ptr to parsed objects)
+   */
+  template <typename Key, typename Value>
+  class LruCache {
+   public:
+    explicit LruCache(size_t capacity) : capacity_{capacity} {}
+
+    LruCache(const LruCache &) = delete;
+    LruCache &operator=(const LruCache &) = delete;
+
+    /// Returns cached value and marks it as recently used
+    std::optional<Value> get(const Key &key) {
+      std::lock_guard lock{mutex_};
+      auto it = index_.find(key);
+      if (it == index_.end()) {
+        ++stats_.misses;
+        return std::nullopt;
+      }
+      ++stats_.hits;
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->second;
+    }
+
+    /// Inserts or replaces value, evicts the oldest entry if full
+    void put(const Key &key, Value value) {
+      if (capacity_ == 0) {
+        return;
+      }
+      std::lock_guard lock{mutex_};
+      auto it = index_.find(key);
+      if (it != index_.end()) {
+        it->second->second = std::move(value);
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return;
+      }
+      if (index_.size() == capacity_) {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+        ++stats_.evictions;
+      }
+      entries_.emplace_front(key, std::move(value));
+      index_.emplace(key, entries_.begin());
+    }
+
+    /// Removes entry, returns false if there was none
+    bool erase(const Key &key) {
+      std::lock_guard lock{mutex_};
+      auto it = index_.find(key);
+      if (it == index_.end()) {
+        return false;
+      }
+      entries_.erase(it->second);
+      index_.erase(it);
+      return true;
+    }
+
+    /// Returns cached value or caches the one made by `make`, errors are not
+    /// cached. `make` is called without lock
+    template <typename Make>
+    outcome::result<Value> getOrMake(const Key &key, const Make &make) {
+      if (auto value = get(key)) {
+        return std::move(*value);
+      }
+      OUTCOME_TRY(value, make());
+      put(key, value);
+      return value;
+    }
+
+    size_t size() const {
+      std::lock_guard lock{mutex_};
+      return index_.size();
+    }
+
+    LruCacheStats stats() const {
+      std::lock_guard lock{mutex_};
+      return stats_;
+    }
+
+   private:
+    using Entries = std::list<std::pair<Key, Value>>;
+
+    const size_t capacity_;
+    mutable std::mutex mutex_;
+    Entries entries_;
+    std::map<Key, typename Entries::iterator> index_;
+    LruCacheStats stats_;
+  };
+
+}  // namespace libp2p
@@ -44,6 +44,7 @@ namespace libp2p::connection {
       STREAM_INVALID_WINDOW_SIZE,
       STREAM_WRITE_OVERFLOW,
       STREAM_RECEIVE_OVERFLOW,
+      STREAM_RECEIVE_BUDGET_EXHAUSTED,
     };
 
     using VoidResultHandlerFunc = std::function<void(outcome::result<void>)>;
@@ -93,6 +94,17 @@ namespace libp2p::connection {
     virtual void adjustWindowSize(uint32_t new_size,
                                   VoidResultHandlerFunc cb) = 0;
 
+    /// Weight of a stream, if not set by setWeight()
+    static constexpr uint32_t kDefaultWeight = 16;
+
+    /**
+     * Set weight of this stream: muxers, which schedule outbound data of
+     * streams, give them shares of connection bandwidth proportional to their
+     * weights. Ignored by other muxers
+     * @param weight - relative weight of the stream, positive
+     */
+    virtual void setWeight([[maybe_unused]] uint32_t weight) {}
+
     /**
      * Is that stream opened over a connection, which was an initiator?
      */
@@ -17,6 +17,9 @@ namespace libp2p::crypto::chachapoly {
   using Key = std::array<uint8_t, 32>;
   using Nonce = std::array<uint8_t, 12>;
 
+  /// Size of authentication tag appended to ciphertext
+  constexpr size_t kTagSize = 16;
+
   class ChaCha20Poly1305 {
    public:
     virtual ~ChaCha20Poly1305() = default;
@@ -43,6 +46,28 @@ namespace libp2p::crypto::chachapoly {
                                            BytesIn ciphertext,
                                            BytesIn aad) = 0;
 
+    /**
+     * Does authenticated encryption into caller-provided buffer
+     * @param out - at least plaintext.size() + kTagSize bytes, may begin at
+     * plaintext.data() for in-place encryption
+     * @return number of bytes written to out
+     */
+    virtual outcome::result<size_t> seal(const Nonce &nonce,
+                                         BytesIn plaintext,
+                                         BytesIn aad,
+                                         BytesOut out) = 0;
+
+    /**
+     * Does authenticated decryption into caller-provided buffer
+     * @param out - at least ciphertext.size() - kTagSize bytes, may begin at
+     * ciphertext.data() for in-place decryption
+     * @return number of bytes written to out
+     */
+    virtual outcome::result<size_t> open(const Nonce &nonce,
+                                         BytesIn ciphertext,
+                                         BytesIn aad,
+                                         BytesOut out) = 0;
+
     /**
      * Convert 64-bit integer to 12-bit long byte sequence with four zero bytes
      * at the beginning
@@ -50,11 +75,10 @@ namespace libp2p::crypto::chachapoly {
      * @return - bytes vector
      */
     inline Nonce uint64toNonce(uint64_t n) const {
-      Bytes result(4, 0);
-      result.reserve(12);
-      libp2p::common::putUint64LE(result, n);
-      Nonce nonce;
-      std::copy_n(result.begin(), nonce.size(), nonce.begin());
+      Nonce nonce{};
+      for (size_t i = 0; i < sizeof(n); ++i) {
+        nonce[4 + i] = static_cast<uint8_t>(n >> (8 * i));
+      }
       return nonce;
     }
   };
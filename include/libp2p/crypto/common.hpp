@@ -51,4 +51,9 @@ namespace libp2p::crypto::common {
    * Supported cipher types
    */
   enum class CipherType { AES128, AES256 };
+
+  /**
+   * Number of parsed public keys cached by each crypto provider
+   */
+  constexpr size_t kPublicKeyCacheSize = 1024;
 }  // namespace libp2p::crypto::common
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <span>
 #include <vector>
 
 #include <boost/filesystem.hpp>
@@ -14,6 +15,13 @@
 #include <libp2p/outcome/outcome.hpp>
 
 namespace libp2p::crypto {
+  /// Signature to check by CryptoProvider::verifyBatch
+  struct SignatureBatchItem {
+    BytesIn message;
+    BytesIn signature;
+    PublicKey public_key;
+  };
+
   /**
    * @class CryptoProvider provides interface for key generation, singing,
    * signature verification functions for private/public key cryptography
@@ -62,6 +70,17 @@ namespace libp2p::crypto {
     virtual outcome::result<bool> verify(BytesIn message,
                                          BytesIn signature,
                                          const PublicKey &public_key) const = 0;
+
+    /**
+     * @brief verifies a batch of signatures, cheaper than one by one calls
+     * for key types which support it
+     * @param items messages with their signatures and public keys
+     * @return validity of each item in the same order, malformed items are
+     * reported as invalid
+     */
+    virtual outcome::result<std::vector<bool>> verifyBatch(
+        std::span<const SignatureBatchItem> items) const = 0;
+
     /**
      * Generate an ephemeral public key and return a function that will
      * compute the shared secret key
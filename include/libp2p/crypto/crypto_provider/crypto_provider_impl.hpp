@@ -58,6 +58,9 @@ namespace libp2p::crypto {
                                  BytesIn signature,
                                  const PublicKey &public_key) const override;
 
+    outcome::result<std::vector<bool>> verifyBatch(
+        std::span<const SignatureBatchItem> items) const override;
+
     outcome::result<EphemeralKeyPair> generateEphemeralKeyPair(
         common::CurveType curve) const override;
 
@@ -10,6 +10,8 @@
 
 #include <openssl/ec.h>
 
+#include <libp2p/common/lru_cache.hpp>
+#include <libp2p/crypto/common.hpp>
 #include <libp2p/crypto/ecdsa_provider.hpp>
 
 namespace libp2p::crypto::ecdsa {
@@ -35,6 +37,9 @@ namespace libp2p::crypto::ecdsa {
         const Signature &signature,
         const PublicKey &public_key) const override;
 
+    /// Lookup counters of parsed public keys cache
+    LruCacheStats keyCacheStats() const;
+
    private:
     /**
      * @brief Convert EC_KEY to bytes
@@ -58,5 +63,8 @@ namespace libp2p::crypto::ecdsa {
     outcome::result<std::shared_ptr<EC_KEY>> convertBytesToEcKey(
         const KeyType &key,
         EC_KEY *(*converter)(EC_KEY **, const uint8_t **, long)) const;
+
+    mutable LruCache<PublicKey, std::shared_ptr<EC_KEY>> key_cache_{
+        common::kPublicKeyCacheSize};
   };
 }  // namespace libp2p::crypto::ecdsa
@@ -7,6 +7,8 @@
 #pragma once
 
 #include <array>
+#include <span>
+#include <vector>
 
 #include <libp2p/common/types.hpp>
 #include <libp2p/outcome/outcome.hpp>
@@ -21,6 +23,13 @@ namespace libp2p::crypto::ed25519 {
   };
   using Signature = std::array<uint8_t, 64u>;
 
+  /// Signature to check by Ed25519Provider::verifyBatch
+  struct BatchItem {
+    BytesIn message;
+    Signature signature;
+    PublicKey public_key;
+  };
+
   /**
    * An interface for Ed25519 private/public key cryptography operations.
    */
@@ -60,6 +69,15 @@ namespace libp2p::crypto::ed25519 {
                                          const Signature &signature,
                                          const PublicKey &public_key) const = 0;
 
+    /**
+     * Verify a batch of signatures
+     * @param items - messages with signatures and public keys
+     * @return validity of each item in the same order, malformed items are
+     * reported as invalid
+     */
+    virtual outcome::result<std::vector<bool>> verifyBatch(
+        std::span<const BatchItem> items) const = 0;
+
     virtual ~Ed25519Provider() = default;
   };
 
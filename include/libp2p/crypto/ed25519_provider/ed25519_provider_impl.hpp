@@ -8,7 +8,11 @@
 
 #include <libp2p/crypto/ed25519_provider.hpp>
 
+#include <openssl/evp.h>
+
+#include <libp2p/common/lru_cache.hpp>
 #include <libp2p/common/types.hpp>
+#include <libp2p/crypto/common.hpp>
 
 namespace libp2p::crypto::ed25519 {
 
@@ -25,6 +29,19 @@ namespace libp2p::crypto::ed25519 {
     outcome::result<bool> verify(BytesIn message,
                                  const Signature &signature,
                                  const PublicKey &public_key) const override;
+
+    outcome::result<std::vector<bool>> verifyBatch(
+        std::span<const BatchItem> items) const override;
+
+    /// Lookup counters of parsed public keys cache
+    LruCacheStats keyCacheStats() const;
+
+   private:
+    outcome::result<std::shared_ptr<EVP_PKEY>> parsePublicKey(
+        const PublicKey &public_key) const;
+
+    mutable LruCache<PublicKey, std::shared_ptr<EVP_PKEY>> key_cache_{
+        common::kPublicKeyCacheSize};
   };
 
 }  // namespace libp2p::crypto::ed25519
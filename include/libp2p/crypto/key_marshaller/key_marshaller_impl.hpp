@@ -8,6 +8,8 @@
 
 #include <memory>
 
+#include <libp2p/common/lru_cache.hpp>
+#include <libp2p/crypto/common.hpp>
 #include <libp2p/crypto/error.hpp>
 #include <libp2p/crypto/key.hpp>
 #include <libp2p/crypto/key_marshaller.hpp>
@@ -31,7 +33,15 @@ namespace libp2p::crypto::marshaller {
     outcome::result<PrivateKey> unmarshalPrivateKey(
         const ProtobufKey &key) const override;
 
+    /// Lookup counters of unmarshalled public keys cache
+    LruCacheStats keyCacheStats() const;
+
    private:
+    outcome::result<PublicKey> decodePublicKey(const ProtobufKey &key) const;
+
     std::shared_ptr<validator::KeyValidator> key_validator_;
+    /// Validated public keys by their protobuf encoding
+    mutable LruCache<Bytes, PublicKey> key_cache_{
+        common::kPublicKeyCacheSize};
   };
 }  // namespace libp2p::crypto::marshaller
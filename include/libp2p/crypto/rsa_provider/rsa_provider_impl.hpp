@@ -9,6 +9,8 @@
 #include <memory>
 
 #include <openssl/rsa.h>
+#include <libp2p/common/lru_cache.hpp>
+#include <libp2p/crypto/common.hpp>
 #include <libp2p/crypto/error.hpp>
 #include <libp2p/crypto/rsa_provider.hpp>
 
@@ -31,6 +33,9 @@ namespace libp2p::crypto::rsa {
                                  const Signature &signature,
                                  const PublicKey &key) const override;
 
+    /// Lookup counters of parsed public keys cache
+    LruCacheStats keyCacheStats() const;
+
    private:
     /**
      * @brief Convert key to OpenSSL type
@@ -39,5 +44,16 @@ namespace libp2p::crypto::rsa {
      */
     static outcome::result<std::shared_ptr<X509_PUBKEY>> getPublicKeyFromBytes(
         const PublicKey &input_key);
+
+    /**
+     * @brief Parse public key into OpenSSL RSA object
+     * @param public_key - public key bytes
+     * @return parsed key or error code
+     */
+    static outcome::result<std::shared_ptr<RSA>> parsePublicKey(
+        const PublicKey &public_key);
+
+    mutable LruCache<PublicKey, std::shared_ptr<RSA>> key_cache_{
+        common::kPublicKeyCacheSize};
   };
 };  // namespace libp2p::crypto::rsa
@@ -9,6 +9,8 @@
 #include <secp256k1.h>
 #include <memory>
 
+#include <libp2p/common/lru_cache.hpp>
+#include <libp2p/crypto/common.hpp>
 #include <libp2p/crypto/secp256k1_provider.hpp>
 
 namespace libp2p::crypto::random {
@@ -31,8 +33,16 @@ namespace libp2p::crypto::secp256k1 {
                                  const Signature &signature,
                                  const PublicKey &key) const override;
 
+    /// Lookup counters of parsed public keys cache
+    LruCacheStats keyCacheStats() const;
+
    private:
+    outcome::result<secp256k1_pubkey> parsePublicKey(
+        const PublicKey &key) const;
+
     std::shared_ptr<random::CSPRNG> random_;
     std::unique_ptr<secp256k1_context, void (*)(secp256k1_context *)> ctx_;
+    mutable LruCache<PublicKey, secp256k1_pubkey> key_cache_{
+        common::kPublicKeyCacheSize};
   };
 }  // namespace libp2p::crypto::secp256k1
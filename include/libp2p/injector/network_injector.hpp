@@ -34,6 +34,7 @@
 #include <libp2p/peer/address_repository/inmem_address_repository.hpp>
 #include <libp2p/peer/impl/identity_manager_impl.hpp>
 #include <libp2p/protocol_muxer/multiselect.hpp>
+#include <libp2p/security/crypto_thread_pool.hpp>
 #include <libp2p/security/noise.hpp>
 #include <libp2p/security/plaintext.hpp>
 #include <libp2p/security/plaintext/exchange_message_marshaller_impl.hpp>
@@ -323,6 +324,8 @@ namespace libp2p::injector {
         di::bind<security::plaintext::ExchangeMessageMarshaller>().to<security::plaintext::ExchangeMessageMarshallerImpl>(),
         di::bind<security::secio::ProposeMessageMarshaller>().to<security::secio::ProposeMessageMarshallerImpl>(),
         di::bind<security::secio::ExchangeMessageMarshaller>().to<security::secio::ExchangeMessageMarshallerImpl>(),
+        di::bind<security::CryptoThreadPool::Config>.to(security::CryptoThreadPool::Config{}),
+        di::bind<security::CryptoExecutor>().to<security::CryptoThreadPool>(),
         di::bind<layer::WsConnectionConfig>.to(layer::WsConnectionConfig{}),
         di::bind<layer::WssCertificate>.to(layer::WssCertificate{}),
 
@@ -15,7 +15,8 @@ namespace libp2p::multi::detail {
     INVALID_BASE64_INPUT,
     INVALID_BASE32_INPUT,
     NON_UPPERCASE_INPUT,
-    NON_LOWERCASE_INPUT
+    NON_LOWERCASE_INPUT,
+    INVALID_BASE16_INPUT
   };
 
 }
@@ -6,11 +6,10 @@
 
 #pragma once
 
-#include <deque>
-#include <mutex>
-
 #include <boost/asio/streambuf.hpp>
 #include <boost/noncopyable.hpp>
+#include <libp2p/basic/memory_budget.hpp>
+#include <libp2p/basic/write_queue.hpp>
 #include <libp2p/connection/stream.hpp>
 #include <libp2p/log/logger.hpp>
 
@@ -30,6 +29,11 @@ namespace libp2p::connection {
      * were opened from two different sides
      */
     using StreamNumber = uint32_t;
+
+    static constexpr size_t kDefaultReceiveWindowSize = 256 * 1024;
+
+    /// Max data size of message frames written by stream
+    static constexpr size_t kMaxWriteFrameSize = 64 * 1024;
     struct StreamId {
       StreamNumber number;
       bool initiator;
@@ -44,11 +48,17 @@ namespace libp2p::connection {
      * Create an instance of Mplex stream
      * @param connection, over which this stream is opened
      * @param stream_id of this stream
+     * @param receive_window_size - how much unread data the stream can hold
+     * @param memory_budget - connection's receive memory budget, buffered
+     * unread data is reserved there
      */
     MplexStream(std::weak_ptr<MplexedConnection> connection,
-                StreamId stream_id);
+                StreamId stream_id,
+                size_t receive_window_size = kDefaultReceiveWindowSize,
+                std::shared_ptr<basic::MemoryBudget> memory_budget = nullptr);
 
-    ~MplexStream() override = default;
+    /// Returns buffered bytes to memory budget
+    ~MplexStream() override;
 
     void readSome(BytesOut out, ReadCallbackFunc cb) override;
 
@@ -88,6 +98,12 @@ namespace libp2p::connection {
     void readDone(outcome::result<size_t> res);
     bool readTry();
 
+    /// Writes next part of write queue, if not writing
+    void doWrite();
+
+    /// Fails write callbacks and clears write queue
+    void writeFailed(std::error_code ec);
+
     std::weak_ptr<MplexedConnection> connection_;
     StreamId stream_id_;
     log::Logger log_ = log::createLogger("MplexStream");
@@ -97,10 +113,9 @@ namespace libp2p::connection {
 
     boost::optional<Reading> reading_;
 
-    /// Queue of write requests that were received when stream was writing
-    std::deque<std::tuple<Bytes, WriteCallbackFunc>> write_queue_{};
-
-    mutable std::mutex write_queue_mutex_;
+    /// Data to write, referenced until its callback is called. Bounded,
+    /// writes are refused with STREAM_WRITE_OVERFLOW if it is full
+    basic::WriteQueue write_queue_;
 
     /// is the stream opened for reads?
     bool is_readable_ = true;
@@ -114,7 +129,14 @@ namespace libp2p::connection {
 
     /// how much unread data can be in this stream at one time; if new data
     /// exceeding this value is received, the stream is reset
-    uint32_t receive_window_size_ = 256 * 1024;  // 256 MB
+    size_t receive_window_size_;
+
+    /// Connection's receive memory budget, buffered unread data is reserved
+    /// there; if it is exhausted, the stream is reset as on window overflow
+    std::shared_ptr<basic::MemoryBudget> memory_budget_;
+
+    /// Bytes reserved in memory_budget_
+    size_t reserved_bytes_ = 0;
 
     /// MplexedConnection API starts here
     friend class MplexedConnection;
@@ -126,6 +148,10 @@ namespace libp2p::connection {
      * @param data_size - size of the received data
      */
     outcome::result<void> commitData(BytesIn data, size_t data_size);
+
+    /// True if data doesn't fit into receive buffer or memory budget now, but
+    /// will fit after reader frees the buffer
+    bool mustWait(size_t data_size) const;
   };
 }  // namespace libp2p::connection
 
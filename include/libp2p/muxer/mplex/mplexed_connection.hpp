@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <optional>
 #include <queue>
 #include <unordered_map>
 #include <utility>
@@ -23,6 +24,20 @@ namespace libp2p::connection {
       : public CapableConnection,
         public std::enable_shared_from_this<MplexedConnection> {
    public:
+    struct Stats {
+      /// Received bytes buffered by streams, not read yet
+      size_t receive_buffered_bytes = 0;
+
+      /// Bytes of frames queued for writing
+      size_t write_queued_bytes = 0;
+
+      /// Streams reset since data didn't fit into their receive buffers
+      uint64_t overflow_resets = 0;
+
+      /// Times reading was paused since data didn't fit into receive buffer
+      uint64_t read_pauses = 0;
+    };
+
     /**
      * Create a new instance of MplexedConnection
      * @param connection to be multiplexed
@@ -63,6 +78,8 @@ namespace libp2p::connection {
 
     bool isClosed() const override;
 
+    Stats stats() const;
+
     /// usage of these four methods is highly not recommended or even forbidden:
     /// use stream over this connection instead
     void readSome(BytesOut out, ReadCallbackFunc cb) override;
@@ -80,6 +97,14 @@ namespace libp2p::connection {
     std::queue<WriteData> write_queue_;
     bool is_writing_ = false;
 
+    /// Message frame which didn't fit into stream's receive buffer, reading
+    /// is paused until it fits (MplexOverflowPolicy::PAUSE)
+    struct PausedFrame {
+      MplexStream::StreamId stream_id;
+      Bytes data;
+    };
+    std::optional<PausedFrame> paused_frame_;
+
     /**
      * Write (\param data) to the connection
      */
@@ -117,6 +142,12 @@ namespace libp2p::connection {
     void processMessageFrame(const MplexFrame &frame,
                              MplexStream::StreamId stream_id);
 
+    /**
+     * Pass data to stream, reset it on overflow
+     */
+    void commitStreamData(const std::shared_ptr<MplexStream> &stream,
+                          BytesIn data);
+
     /**
      * Process a close stream (\package frame)
      */
@@ -160,6 +191,11 @@ namespace libp2p::connection {
     std::shared_ptr<SecureConnection> connection_;
     muxer::MuxedConnectionConfig config_;
 
+    /// Receive memory budget shared by streams
+    std::shared_ptr<basic::MemoryBudget> memory_budget_;
+
+    Stats stats_;
+
     std::unordered_map<MplexStream::StreamId, std::shared_ptr<MplexStream>>
         streams_;
     MplexStream::StreamNumber last_issued_stream_number_ = 1;
@@ -171,6 +207,12 @@ namespace libp2p::connection {
     /// MPLEX STREAM API
     friend class MplexStream;
 
+    /**
+     * Continue reading if it was paused and paused frame fits now; called when
+     * stream's receive buffer is freed or stream is removed
+     */
+    void resumeReading();
+
     /**
      * Write bytes to the connection; before calling this method, the stream
      * must ensure that no write operations are currently running
@@ -9,6 +9,12 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+
+namespace libp2p::basic {
+  class BufferPool;
+  class MemoryBudget;
+}  // namespace libp2p::basic
 
 namespace libp2p::muxer {
   /**
@@ -36,5 +42,55 @@ namespace libp2p::muxer {
     /// Dial timeout for outgoing connection
     static constexpr std::chrono::seconds kDefaultDialTimeout{10};
     std::chrono::milliseconds dial_timeout = kDefaultDialTimeout;
+
+    /// Streams buffer received data by reference to connection's receive
+    /// buffer instead of copying it, so that the only copy is into the reader's
+    /// buffer. Costs allocation of a new receive buffer if the previous one is
+    /// still referenced
+    bool zero_copy_receive = false;
+
+    /// Grow streams' receive windows towards bandwidth-delay product: window
+    /// is doubled (up to maximum_window_size) each time the reader consumes it
+    /// within 2 round trips, measured by pings
+    bool window_auto_tuning = false;
+
+    /// Connection-wide limit of memory for received data: sum of streams'
+    /// receive windows (yamux) or buffered unread bytes (mplex). Windows are
+    /// not grown beyond it, new streams are refused when it is exhausted
+    static constexpr size_t kDefaultReceiveMemoryLimit = 256 * 1024 * 1024;
+    size_t receive_memory_limit = kDefaultReceiveMemoryLimit;
+
+    /// Host-wide receive memory budget shared by connections, parent of
+    /// connections' budgets, not used if null
+    std::shared_ptr<basic::MemoryBudget> host_memory_budget;
+
+    /// Frames enqueued while connection is idle are not written immediately,
+    /// but collected for write_coalescing_delay (until the end of current
+    /// event loop iteration if zero) and written at once, up to
+    /// write_coalescing_max_size bytes. Frames enqueued while connection is
+    /// writing are written at once too. Reduces writes of small messages
+    bool write_coalescing = false;
+    std::chrono::milliseconds write_coalescing_delay{0};
+    static constexpr size_t kDefaultWriteCoalescingMaxSize = 64 * 1024;
+    size_t write_coalescing_max_size = kDefaultWriteCoalescingMaxSize;
+
+    /// Mplex has no flow control, policy for data which doesn't fit into
+    /// stream's receive buffer or into receive memory budget
+    enum class MplexOverflowPolicy {
+      /// Reset the stream
+      RESET,
+      /// Stop reading the connection until readers free receive buffers, so
+      /// that transport flow control slows the sender down
+      PAUSE,
+    };
+    MplexOverflowPolicy mplex_overflow_policy = MplexOverflowPolicy::RESET;
+
+    /// Mplex stream's receive buffer size
+    static constexpr size_t kDefaultMplexReceiveBufferSize = 256 * 1024;
+    size_t mplex_receive_buffer_size = kDefaultMplexReceiveBufferSize;
+
+    /// Pool for streams' read buffers, may be shared by connections. Not used
+    /// if null
+    std::shared_ptr<basic::BufferPool> buffer_pool;
   };
 }  // namespace libp2p::muxer
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <optional>
 
 #include <libp2p/basic/read_buffer.hpp>
@@ -22,12 +23,35 @@ namespace libp2p::connection {
    public:
     virtual ~YamuxStreamFeedback() = default;
 
-    /// Stream transfers data to connection
+    /// Stream transfers data to connection. Data is not copied, it must stay
+    /// valid until acknowledged by onDataWritten() or released by
+    /// releaseStreamData()
     virtual void writeStreamData(uint32_t stream_id, BytesIn data) = 0;
 
+    /// Stream is going to release data passed to writeStreamData(), cb is
+    /// called as soon as connection no longer references it
+    virtual void releaseStreamData(uint32_t stream_id,
+                                   std::function<void()> cb) = 0;
+
     /// Stream acknowledges received bytes
     virtual void ackReceivedBytes(uint32_t stream_id, uint32_t bytes) = 0;
 
+    /// Stream's reader consumed the whole receive window within elapsed time,
+    /// returns receive window size the stream may grow to
+    virtual size_t tuneReceiveWindow(uint32_t stream_id,
+                                     size_t window_size,
+                                     std::chrono::microseconds elapsed) = 0;
+
+    /// Stream grows its receive window by bytes, returns false if receive
+    /// memory budget doesn't allow it
+    virtual bool reserveReceiveWindow(uint32_t stream_id, size_t bytes) = 0;
+
+    /// Stream sets its share of connection's outbound bandwidth
+    virtual void setStreamWeight(uint32_t stream_id, uint32_t weight) = 0;
+
+    /// Current steady clock time, used to measure receive window consumption
+    virtual std::chrono::microseconds now() const = 0;
+
     /// Stream defers callback to avoid reentrancy
     virtual void deferCall(std::function<void()>) = 0;
 
@@ -52,7 +76,8 @@ namespace libp2p::connection {
                 YamuxStreamFeedback &feedback,
                 uint32_t stream_id,
                 size_t maximum_window_size,
-                size_t write_queue_limit);
+                size_t write_queue_limit,
+                std::shared_ptr<basic::BufferPool> buffer_pool = nullptr);
 
     void readSome(BytesOut out, ReadCallbackFunc cb) override;
 
@@ -75,6 +100,8 @@ namespace libp2p::connection {
 
     void adjustWindowSize(uint32_t new_size, VoidResultHandlerFunc cb) override;
 
+    void setWeight(uint32_t weight) override;
+
     outcome::result<peer::PeerId> remotePeerId() const override;
 
     outcome::result<bool> isInitiator() const override;
@@ -94,7 +121,9 @@ namespace libp2p::connection {
 
     /// Called from Connection. New data received
     /// Returns kRemoveStreamAndSendRst on window overflow
-    DataFromConnectionResult onDataReceived(BytesOut bytes);
+    /// If owner of bytes is passed, they may be buffered by reference
+    DataFromConnectionResult onDataReceived(
+        BytesOut bytes, const basic::ReadBuffer::SharedBytes &owner = nullptr);
 
     /// Called from Connection on FIN received
     /// Returns kRemoveStream if FIN was sent from this side
@@ -109,6 +138,14 @@ namespace libp2p::connection {
     /// Connection closed by network error
     void closedByConnection(std::error_code ec);
 
+    /// Called from Connection when the stream object is released by all
+    /// owners. Drops state, so that the object may be reused with its buffers
+    void recycle();
+
+    /// Called from Connection, reinitializes recycled object for a new stream
+    void reuse(std::shared_ptr<connection::SecureConnection> connection,
+               uint32_t stream_id);
+
    private:
     struct Reading {
       BytesOut out;
@@ -121,6 +158,10 @@ namespace libp2p::connection {
     /// Called by read*() functions
     void doRead(BytesOut out, ReadCallbackFunc cb);
 
+    /// Acknowledges bytes consumed by reader, grows receive window if it was
+    /// consumed fast enough
+    void ackConsumedBytes(size_t bytes);
+
     /// Dequeues data from write queue and sends to the wire in async manner
     void doWrite();
 
@@ -161,6 +202,12 @@ namespace libp2p::connection {
     /// Maximum window size allowed for peer
     size_t maximum_window_size_;
 
+    /// Bytes consumed by reader since window_epoch_
+    size_t consumed_in_epoch_ = 0;
+
+    /// Time when reader started consuming current receive window
+    std::chrono::microseconds window_epoch_;
+
     /// Write queue with callbacks
     basic::WriteQueue write_queue_;
 
@@ -6,8 +6,12 @@
 
 #pragma once
 
+#include <deque>
 #include <unordered_map>
 
+#include <boost/container/flat_map.hpp>
+
+#include <libp2p/basic/memory_budget.hpp>
 #include <libp2p/basic/read_buffer.hpp>
 #include <libp2p/basic/scheduler.hpp>
 #include <libp2p/common/metrics/instance_count.hpp>
@@ -31,6 +35,27 @@ namespace libp2p::connection {
    public:
     using StreamId = uint32_t;
 
+    /// Receive buffer size in zero copy receive mode. Smaller than default
+    /// since a buffer cannot be reused while streams reference it
+    static constexpr size_t kZeroCopyReadBufferSize = 64 * 1024;
+
+    /// Streams' data is sent in frames of at most this size, so that frames
+    /// of other streams and control frames are not delayed by bulk transfers
+    static constexpr size_t kMaxDataFrameSize = 32 * 1024;
+
+    /// Deficit round robin quantum per unit of stream weight, streams of
+    /// default weight send one max size frame per round
+    static constexpr size_t kQuantumPerWeight =
+        (kMaxDataFrameSize + YamuxFrame::kHeaderLength + Stream::kDefaultWeight
+         - 1)
+        / Stream::kDefaultWeight;
+
+    /// Max released stream objects kept by connection for reuse
+    static constexpr size_t kMaxPooledStreams = 16;
+
+    /// Stream table capacity allocated in advance
+    static constexpr size_t kStreamTableReserve = 16;
+
     YamuxedConnection(const YamuxedConnection &other) = delete;
     YamuxedConnection &operator=(const YamuxedConnection &other) = delete;
     YamuxedConnection(YamuxedConnection &&other) = delete;
@@ -79,7 +104,13 @@ namespace libp2p::connection {
     void deferWriteCallback(std::error_code ec, WriteCallbackFunc cb) override;
 
    private:
-    using Streams = std::unordered_map<StreamId, std::shared_ptr<YamuxStream>>;
+    /// Stream ids grow monotonically, so sorted vector is a compact table
+    /// with cheap insertion
+    using Streams =
+        boost::container::flat_map<StreamId, std::shared_ptr<YamuxStream>>;
+
+    /// Released stream objects for reuse
+    using StreamPool = std::vector<std::unique_ptr<YamuxStream>>;
 
     using PendingOutboundStreams =
         std::unordered_map<StreamId, StreamHandlerFunc>;
@@ -87,10 +118,41 @@ namespace libp2p::connection {
     using Buffer = Bytes;
 
     struct WriteQueueItem {
-      // TODO(artem): reform in buffers (shared + vector writes)
+      /// Frame header, or the whole frame if it carries no data
+      Buffer header;
+
+      /// Frame payload, borrowed from stream's write queue until the stream
+      /// releases it, then points to payload_copy
+      BytesIn payload;
+
+      /// Owns payload released by stream before it was written
+      Buffer payload_copy;
+
+      /// Stream id to ack written payload to, 0 for control frames
+      StreamId stream_id = 0;
 
-      Buffer packet;
-      StreamId stream_id;
+      /// Stream released payload while it was being written
+      bool released = false;
+    };
+
+    /// Frames written by one write operation
+    struct WriteBatch {
+      std::vector<WriteQueueItem> items;
+
+      /// Buffer sequence {header, payload, header, payload...} being written
+      std::vector<BytesIn> buffers;
+
+      /// Called after write completion, streams released payload being
+      /// written
+      std::vector<std::function<void()>> on_written;
+    };
+
+    /// Outbound frames of one stream, scheduled by deficit round robin
+    struct StreamWriteQueue {
+      std::deque<WriteQueueItem> items;
+
+      /// Bytes the stream may send in current round
+      size_t deficit = 0;
     };
 
     // YamuxStreamFeedback interface overrides
@@ -98,9 +160,28 @@ namespace libp2p::connection {
     /// Stream transfers data to connection
     void writeStreamData(uint32_t stream_id, BytesIn data) override;
 
+    /// Stream is going to release data passed to writeStreamData()
+    void releaseStreamData(uint32_t stream_id,
+                           std::function<void()> cb) override;
+
     /// Stream acknowledges received bytes
     void ackReceivedBytes(uint32_t stream_id, uint32_t bytes) override;
 
+    /// Grows stream's receive window if it was consumed within 2 RTT
+    size_t tuneReceiveWindow(uint32_t stream_id,
+                             size_t window_size,
+                             std::chrono::microseconds elapsed) override;
+
+    /// Reserves receive window growth in memory budget
+    bool reserveReceiveWindow(uint32_t stream_id, size_t bytes) override;
+
+    /// Sets stream's weight for outbound frames scheduling
+    void setStreamWeight(uint32_t stream_id, uint32_t weight) override;
+
+    /// Current steady clock time, scheduler's clock is too coarse to measure
+    /// RTT of fast links
+    std::chrono::microseconds now() const override;
+
     /// Stream defers callback to avoid reentrancy
     void deferCall(std::function<void()>) override;
 
@@ -150,15 +231,36 @@ namespace libp2p::connection {
     void close(std::error_code notify_streams_code,
                boost::optional<YamuxFrame::GoAwayError> reply_to_peer_code);
 
-    /// Writes data to underlying connection or (if is_writing_) enqueues them
-    /// If stream_id != 0, stream will be acknowledged about data written
-    void enqueue(Buffer packet, StreamId stream_id = 0);
+    /// Enqueues control frame, control frames are written before streams'
+    /// frames
+    void enqueue(Buffer packet);
+
+    /// Enqueues stream's frame, it is written after stream's frames enqueued
+    /// before. Stream will be acknowledged about payload written
+    void enqueueStreamFrame(StreamId stream_id,
+                            Buffer header,
+                            BytesIn payload = {});
+
+    /// Takes next frame from write queues: control frame if any, or frame
+    /// of the next stream in deficit round robin order
+    std::optional<WriteQueueItem> dequeue();
+
+    /// Writes queued frames if not writing, in write coalescing mode
+    /// schedules the write to collect more frames
+    void writeNext();
 
-    /// Performs write into connection
-    void doWrite(WriteQueueItem packet);
+    /// Writes frames from write queues into connection as one write (one
+    /// frame unless write coalescing is on), returns false if nothing to write
+    bool writeBatch();
+
+    /// Clears write queues
+    void clearWriteQueues();
+
+    /// Drops frames queued by stream, as peer discards them after RST
+    void dropStreamFrames(StreamId stream_id);
 
     /// Write callback
-    void onDataWritten(outcome::result<void> res, WriteQueueItem &&packet);
+    void onDataWritten(outcome::result<void> res);
 
     /// Creates new yamux stream
     std::shared_ptr<Stream> createStream(StreamId stream_id);
@@ -166,6 +268,9 @@ namespace libp2p::connection {
     /// Erases stream by id, may affect incactivity timer
     void eraseStream(StreamId stream_id);
 
+    /// True if memory budget allows receive window of one more stream
+    bool canReserveStreamWindow() const;
+
     /// Erases entry from pending streams, may affect incactivity timer
     void erasePendingOutboundStream(PendingOutboundStreams::iterator it);
 
@@ -179,6 +284,9 @@ namespace libp2p::connection {
     void setTimerCleanup();
     void setTimerPing();
 
+    /// Sends ping, remembers its time to measure RTT on pong
+    void sendPing();
+
     /// Copy of config
     const muxer::MuxedConnectionConfig config_;
 
@@ -191,8 +299,8 @@ namespace libp2p::connection {
     /// True if started
     bool started_ = false;
 
-    /// TODO(artem): change read() interface to reduce copying
-    std::shared_ptr<Buffer> raw_read_buffer_;
+    /// Receive buffer, streams may reference it in zero copy receive mode
+    std::shared_ptr<basic::UninitializedBytes> raw_read_buffer_;
 
     /// Buffering and segmenting
     YamuxReadingState reading_state_;
@@ -200,10 +308,29 @@ namespace libp2p::connection {
     /// True if waiting for current write operation to complete
     bool is_writing_ = false;
 
-    std::shared_ptr<Bytes> writing_buf_ = std::make_shared<Bytes>();
+    /// Frames being written, shared with write callback
+    std::shared_ptr<WriteBatch> writing_ = std::make_shared<WriteBatch>();
+
+    /// True if coalesced write is scheduled
+    bool write_scheduled_ = false;
 
-    /// Write queue
-    std::deque<WriteQueueItem> write_queue_;
+    /// Timer handle for coalesced write
+    basic::Scheduler::Handle write_handle_;
+
+    /// Control frames write queue
+    std::deque<WriteQueueItem> control_queue_;
+
+    /// Streams' frames write queues
+    std::unordered_map<StreamId, StreamWriteQueue> stream_queues_;
+
+    /// Streams with queued frames, in round robin order
+    std::deque<StreamId> active_streams_;
+
+    /// True if the front of active_streams_ got its quantum in current round
+    bool round_started_ = false;
+
+    /// Weights of streams set by setStreamWeight()
+    std::unordered_map<StreamId, uint32_t> stream_weights_;
 
     /// Active streams
     Streams streams_;
@@ -238,6 +365,22 @@ namespace libp2p::connection {
 
     uint32_t ping_counter_ = 0;
 
+    /// Time when the last ping was sent
+    std::chrono::microseconds ping_sent_at_{};
+
+    /// Smoothed round trip time, measured by pings
+    std::optional<std::chrono::microseconds> rtt_;
+
+    /// Receive memory budget, streams' receive windows are reserved there
+    std::shared_ptr<basic::MemoryBudget> memory_budget_;
+
+    /// Receive window bytes reserved in memory_budget_, per stream
+    boost::container::flat_map<StreamId, size_t> window_reserved_;
+
+    /// Released stream objects, weak references to it are held by streams'
+    /// deleters
+    std::shared_ptr<StreamPool> stream_pool_ = std::make_shared<StreamPool>();
+
     bool close_after_write_ = false;
 
    public:
@@ -8,6 +8,7 @@
 
 #include <chrono>
 #include <functional>
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
@@ -18,6 +19,7 @@
 #include <libp2p/multi/multiaddress.hpp>
 #include <libp2p/peer/peer_id.hpp>
 #include <libp2p/protocol/common/subscription.hpp>
+#include <libp2p/security/crypto_executor.hpp>
 
 namespace libp2p {
   struct Host;
@@ -54,6 +56,91 @@ namespace libp2p::protocol::gossip {
     size_t max_ihave_message_ids = 5000;
     size_t max_iwant_message_ids = 5000;
     size_t max_prune_peer_infos = 16;
+
+    /// Limits of IDONTWANT control messages and their message ids
+    size_t max_idontwant_messages = 5000;
+    size_t max_idontwant_message_ids = 5000;
+  };
+
+  /// Gossipsub v1.1 score parameters of one topic
+  struct TopicScoreParams {
+    /// Weight of the topic score in peer score
+    double topic_weight = 1.0;
+
+    /// P1: time in mesh, counted in quantums and capped
+    double time_in_mesh_weight = 0.01;
+    std::chrono::milliseconds time_in_mesh_quantum{std::chrono::seconds(1)};
+    double time_in_mesh_cap = 3600;
+
+    /// P2: first deliveries of valid messages
+    double first_message_deliveries_weight = 1.0;
+    double first_message_deliveries_decay = 0.5;
+    double first_message_deliveries_cap = 2000;
+
+    /// P3: deficit of message deliveries by mesh peer, squared. Depends on
+    /// message rate of the topic, so it is off by default
+    double mesh_message_deliveries_weight = 0;
+    double mesh_message_deliveries_decay = 0.5;
+    double mesh_message_deliveries_threshold = 20;
+    double mesh_message_deliveries_cap = 100;
+    /// Time in mesh before the deficit is counted
+    std::chrono::milliseconds mesh_message_deliveries_activation{
+        std::chrono::seconds(5)};
+    /// Duplicates received within this time after first delivery are counted
+    std::chrono::milliseconds mesh_message_deliveries_window{10};
+
+    /// P3b: deficit of mesh deliveries at the moment peer was pruned
+    double mesh_failure_penalty_weight = 0;
+    double mesh_failure_penalty_decay = 0.5;
+
+    /// P4: invalid messages, squared
+    double invalid_message_deliveries_weight = -1.0;
+    double invalid_message_deliveries_decay = 0.3;
+  };
+
+  /// Gossipsub v1.1 peer scoring config
+  struct ScoreConfig {
+    /// Peers are not scored and meshes are maintained at random if false
+    bool enabled = false;
+
+    /// Parameters of topics without their own ones
+    TopicScoreParams default_topic_params;
+    std::map<std::string, TopicScoreParams> topic_params;
+
+    /// Cap of positive topics contribution, 0 means no cap
+    double topic_score_cap = 0;
+
+    /// P6: number of peers sharing IP address above threshold, squared
+    double ip_colocation_factor_weight = -1.0;
+    size_t ip_colocation_factor_threshold = 1;
+
+    /// P7: protocol misbehaviour counter above threshold, squared
+    double behaviour_penalty_weight = -1.0;
+    double behaviour_penalty_threshold = 0;
+    double behaviour_penalty_decay = 0.9;
+
+    /// Counters are multiplied by their decays once per interval and dropped
+    /// to zero below decay_to_zero
+    std::chrono::milliseconds decay_interval{std::chrono::seconds(1)};
+    double decay_to_zero = 0.01;
+
+    /// Score of disconnected peer is kept for this time
+    std::chrono::milliseconds retain_score{std::chrono::minutes(10)};
+
+    /// No gossip is emitted to or accepted from peers below this score
+    double gossip_threshold = -10;
+
+    /// Locally published messages are not sent to peers below this score
+    double publish_threshold = -50;
+
+    /// RPCs from peers below this score are ignored
+    double graylist_threshold = -80;
+
+    /// If median score of mesh falls below this threshold, better scored
+    /// peers are grafted every opportunistic_graft_ticks heartbeats
+    double opportunistic_graft_threshold = 1;
+    size_t opportunistic_graft_ticks = 60;
+    size_t opportunistic_graft_peers = 2;
   };
 
   /// Gossip pub-sub protocol config
@@ -87,7 +174,8 @@ namespace libp2p::protocol::gossip {
     std::chrono::milliseconds seen_cache_lifetime_msec{
         message_cache_lifetime_msec * 3 / 4};
 
-    /// Topic's seen cache limit
+    /// Max number of recently seen message ids announced to peer on its
+    /// subscription to topic
     unsigned seen_cache_limit = 100;
 
     /// Heartbeat interval
@@ -105,14 +193,46 @@ namespace libp2p::protocol::gossip {
     /// Max RPC message size
     size_t max_message_size = 1 << 24;
 
-    /// Protocol version
-    std::string protocol_version = "/meshsub/1.0.0";
+    /// IDONTWANT (gossipsub v1.2) is sent to mesh peers on receiving a new
+    /// message with data of this size or more, 0 disables sending it
+    size_t idontwant_message_size_threshold = 1024;
+
+    /// Time message ids received in IDONTWANT are kept
+    std::chrono::milliseconds idontwant_lifetime_msec{std::chrono::seconds(3)};
+
+    /// Max number of message ids kept per peer from its IDONTWANT messages
+    size_t idontwant_max_messages = 1000;
+
+    /// Deprecated, use protocol_versions. If set, it is the only protocol
+    /// version advertised
+    std::string protocol_version;
+
+    /// Protocol versions in order of preference, IDONTWANT is sent only to
+    /// peers which negotiated /meshsub/1.2.0. If empty, /meshsub/1.0.0 is
+    /// advertised, preceded by /meshsub/1.1.0 if peer scoring is enabled, and
+    /// by /meshsub/1.2.0 if sending IDONTWANT is enabled as well
+    std::vector<std::string> protocol_versions;
 
     /// Sign published messages
     bool sign_messages = false;
 
+    /// Verify signatures of received messages, unsigned messages are dropped.
+    /// Messages of one dispatch tick are verified as a batch
+    bool verify_signatures = false;
+
     /// RPC Parsing limits
     std::shared_ptr<RPCLimits> rpc_limits = std::make_shared<RPCLimits>();
+
+    /// Runs message validators off the io thread (e.g.
+    /// security::CryptoThreadPool), null runs them inline
+    std::shared_ptr<security::CryptoExecutor> validation_executor;
+
+    /// Max number of messages of one topic being validated at once, newer
+    /// messages of the topic are dropped while the limit is reached
+    size_t max_pending_validations = 1024;
+
+    /// Peer scoring, used in mesh maintenance and gossip
+    ScoreConfig score;
   };
 
   using TopicId = std::string;
@@ -147,12 +267,34 @@ namespace libp2p::protocol::gossip {
       const Bytes &data;
     };
 
-    /// Validator of messages arriving from the wire
+    /// Validator of messages arriving from the wire. Runs on
+    /// Config::validation_executor if set, so must be thread safe then
     using Validator = std::function<bool(const Bytes &from, const Bytes &data)>;
 
     /// Sets message validator for topic
     virtual void setValidator(const TopicId &topic, Validator validator) = 0;
 
+    /// Outcome of message validation (gossipsub v1.1). Rejected messages
+    /// penalize the peer, ignored ones are just dropped
+    enum class ValidationResult {
+      ACCEPT,
+      REJECT,
+      IGNORE,
+    };
+
+    using ValidationCallback = std::function<void(ValidationResult)>;
+
+    /// Asynchronous validator of messages arriving from the wire. Called on
+    /// the io thread, must call `done` once and on the io thread. `from` and
+    /// `data` are valid until then
+    using AsyncValidator = std::function<void(
+        const Bytes &from, const Bytes &data, ValidationCallback done)>;
+
+    /// Sets asynchronous message validator for topic. Message is forwarded
+    /// only after it is accepted
+    virtual void setAsyncValidator(const TopicId &topic,
+                                   AsyncValidator validator) = 0;
+
     /// Creates unique message ID out of message fields
     using MessageIdFn = std::function<Bytes(
         const Bytes &from, const Bytes &seq, const Bytes &data)>;
@@ -0,0 +1,53 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
+namespace libp2p::security {
+
+  /**
+   * Runs CPU heavy computations (handshake key agreement and signatures,
+   * message validation) so they don't delay io of established connections
+   */
+  class CryptoExecutor {
+   public:
+    virtual ~CryptoExecutor() = default;
+
+    /// Calls `work` off the io thread, then `done` on the io thread
+    virtual void post(std::function<void()> work,
+                      std::function<void()> done) = 0;
+
+    /// False if `work` actually runs inline on the io thread
+    virtual bool concurrent() const = 0;
+  };
+
+  /**
+   * Calls `work` on `executor` and passes its result to `done` on the io
+   * thread. Both are called inline if there is no executor
+   */
+  template <typename Work, typename Done>
+  void runCrypto(const std::shared_ptr<CryptoExecutor> &executor,
+                 Work work,
+                 Done done) {
+    if (executor == nullptr) {
+      done(work());
+      return;
+    }
+    using Result = std::invoke_result_t<Work>;
+    auto result = std::make_shared<std::optional<Result>>();
+    executor->post(
+        [result, work{std::move(work)}]() mutable { result->emplace(work()); },
+        [result, done{std::move(done)}]() mutable {
+          done(std::move(result->value()));
+        });
+  }
+
+}  // namespace libp2p::security
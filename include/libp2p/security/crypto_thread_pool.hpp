@@ -0,0 +1,43 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <optional>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <libp2p/security/crypto_executor.hpp>
+
+namespace libp2p::security {
+
+  /// Crypto executor with worker threads, results are posted to io_context
+  class CryptoThreadPool : public CryptoExecutor {
+   public:
+    struct Config {
+      /// Number of worker threads, 0 runs computations inline on io thread
+      size_t threads = 0;
+    };
+
+    CryptoThreadPool(std::shared_ptr<boost::asio::io_context> io_context,
+                     Config config);
+
+    CryptoThreadPool(const CryptoThreadPool &) = delete;
+    CryptoThreadPool &operator=(const CryptoThreadPool &) = delete;
+
+    /// Stops workers, pending computations are discarded
+    ~CryptoThreadPool() override;
+
+    void post(std::function<void()> work, std::function<void()> done) override;
+
+    bool concurrent() const override;
+
+   private:
+    std::shared_ptr<boost::asio::io_context> io_context_;
+    std::optional<boost::asio::thread_pool> pool_;
+  };
+
+}  // namespace libp2p::security
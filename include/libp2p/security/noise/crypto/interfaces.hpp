@@ -87,6 +87,20 @@ namespace libp2p::security::noise {
                                            uint64_t nonce,
                                            BytesIn ciphertext,
                                            BytesIn aad) = 0;
+
+    /// Encrypts into `out`, which may begin at `plaintext` (in place),
+    /// returns number of bytes written
+    virtual outcome::result<size_t> seal(uint64_t nonce,
+                                         BytesIn plaintext,
+                                         BytesIn aad,
+                                         BytesOut out) = 0;
+
+    /// Decrypts into `out`, which may begin at `ciphertext` (in place),
+    /// returns number of bytes written
+    virtual outcome::result<size_t> open(uint64_t nonce,
+                                         BytesIn ciphertext,
+                                         BytesIn aad,
+                                         BytesOut out) = 0;
   };
 
   class NamedAEADCipher {
@@ -24,6 +24,16 @@ namespace libp2p::security::noise {
                                    BytesIn ciphertext,
                                    BytesIn aad) override;
 
+    outcome::result<size_t> seal(uint64_t nonce,
+                                 BytesIn plaintext,
+                                 BytesIn aad,
+                                 BytesOut out) override;
+
+    outcome::result<size_t> open(uint64_t nonce,
+                                 BytesIn ciphertext,
+                                 BytesIn aad,
+                                 BytesOut out) override;
+
    private:
     std::unique_ptr<crypto::chachapoly::ChaCha20Poly1305> ccp_;
   };
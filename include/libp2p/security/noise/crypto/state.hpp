@@ -43,6 +43,24 @@ namespace libp2p::security::noise {
                                    BytesIn ciphertext,
                                    BytesIn aad);
 
+    /// Encrypts with the next nonce into `out`, which needs room for the tag
+    /// and may begin at `plaintext`. Returns number of bytes written
+    outcome::result<size_t> seal(BytesIn plaintext, BytesIn aad, BytesOut out);
+
+    /// Decrypts with the next nonce into `out`, which may begin at
+    /// `ciphertext`. Returns number of bytes written
+    outcome::result<size_t> open(BytesIn ciphertext, BytesIn aad, BytesOut out);
+
+    /// Splits `plaintext` into transport frames of at most kMaxPlainText
+    /// bytes, seals them with consecutive nonces and writes them to `out`,
+    /// each one with a length prefix. `out` needs framedSize() bytes. The
+    /// plaintext may be in `out` only if it fits into one frame and begins
+    /// right after the length prefix. Returns number of bytes written
+    outcome::result<size_t> sealFrames(BytesIn plaintext, BytesOut out);
+
+    /// Size of sealFrames() output for plaintext of given size
+    static size_t framedSize(size_t plaintext_size);
+
     outcome::result<void> rekey();
 
     std::shared_ptr<CipherSuite> cipherSuite() const;
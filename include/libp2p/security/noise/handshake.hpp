@@ -12,8 +12,10 @@
 #include <libp2p/crypto/x25519_provider.hpp>
 #include <libp2p/log/logger.hpp>
 #include <libp2p/peer/peer_id.hpp>
+#include <libp2p/security/crypto_executor.hpp>
 #include <libp2p/security/noise/crypto/interfaces.hpp>
 #include <libp2p/security/noise/crypto/state.hpp>
+#include <libp2p/security/noise/handshake_keys.hpp>
 #include <libp2p/security/noise/handshake_message_marshaller.hpp>
 #include <libp2p/security/noise/insecure_rw.hpp>
 #include <libp2p/security/security_adaptor.hpp>
@@ -33,7 +35,9 @@ namespace libp2p::security::noise {
         bool is_initiator,
         boost::optional<peer::PeerId> remote_peer_id,
         SecurityAdaptor::SecConnCallbackFunc cb,
-        std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller);
+        std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+        std::shared_ptr<HandshakeKeys> handshake_keys,
+        std::shared_ptr<CryptoExecutor> crypto_executor = nullptr);
 
     void connect();
 
@@ -52,7 +56,15 @@ namespace libp2p::security::noise {
 
     outcome::result<void> handleRemoteHandshakePayload(BytesIn payload);
 
-    outcome::result<void> runHandshake();
+    /// Runs handleRemoteHandshakePayload on crypto executor
+    void verifyRemoteHandshakePayload(std::shared_ptr<Bytes> payload,
+                                      CbOutcomeVoid cb);
+
+    /// Initializes handshake state with cached static key and pooled
+    /// ephemeral key, returns signed handshake payload
+    outcome::result<Bytes> prepareHandshake();
+
+    void runHandshake(Bytes payload);
 
     // handshake callback
     void hscb(outcome::result<bool> secured);
@@ -67,6 +79,8 @@ namespace libp2p::security::noise {
     SecurityAdaptor::SecConnCallbackFunc connection_cb_;
 
     std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller_;
+    std::shared_ptr<HandshakeKeys> handshake_keys_;
+    std::shared_ptr<CryptoExecutor> crypto_executor_;
     std::shared_ptr<Bytes> read_buffer_;
     std::shared_ptr<InsecureReadWriter> rw_;
 
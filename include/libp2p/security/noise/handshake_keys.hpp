@@ -0,0 +1,68 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+
+#include <libp2p/crypto/key.hpp>
+#include <libp2p/security/crypto_executor.hpp>
+#include <libp2p/security/noise/crypto/interfaces.hpp>
+
+namespace libp2p::security::noise {
+
+  /// Number of pregenerated ephemeral keys kept by HandshakeKeys
+  constexpr size_t kEphemeralKeyPoolSize = 16;
+
+  /**
+   * Key material shared by Noise handshakes of one identity.
+   * Static DH key and its signed handshake payload are made once per identity
+   * key, ephemeral keys are pregenerated on crypto executor if it has worker
+   * threads
+   */
+  class HandshakeKeys : public std::enable_shared_from_this<HandshakeKeys> {
+   public:
+    /// Static DH key with handshake payload signed by identity key
+    struct StaticKey {
+      DHKey keypair;
+      Bytes payload;
+    };
+
+    using MakePayload =
+        std::function<outcome::result<Bytes>(const DHKey &keypair)>;
+
+    HandshakeKeys(std::shared_ptr<CryptoExecutor> crypto_executor,
+                  size_t pool_size = kEphemeralKeyPoolSize);
+
+    /// Returns cached static key, makes new one if `identity` changed
+    outcome::result<StaticKey> staticKey(const crypto::PublicKey &identity,
+                                         const MakePayload &make_payload);
+
+    /// Takes pregenerated ephemeral key or generates it if pool is empty.
+    /// Each key is returned only once
+    outcome::result<DHKey> ephemeralKey();
+
+    /// Number of pregenerated ephemeral keys
+    size_t pooled() const;
+
+   private:
+    /// Posts generation of missing ephemeral keys
+    void refill();
+
+    std::shared_ptr<CryptoExecutor> crypto_executor_;
+    const size_t pool_size_;
+
+    mutable std::mutex mutex_;
+    std::optional<crypto::PublicKey> identity_;
+    std::optional<StaticKey> static_key_;
+    std::deque<DHKey> ephemeral_keys_;
+    size_t generating_ = 0;
+  };
+
+}  // namespace libp2p::security::noise
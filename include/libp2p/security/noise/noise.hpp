@@ -10,8 +10,13 @@
 #include <libp2p/crypto/key.hpp>
 #include <libp2p/crypto/key_marshaller.hpp>
 #include <libp2p/log/logger.hpp>
+#include <libp2p/security/crypto_executor.hpp>
 #include <libp2p/security/security_adaptor.hpp>
 
+namespace libp2p::security::noise {
+  class HandshakeKeys;
+}  // namespace libp2p::security::noise
+
 namespace libp2p::security {
 
   class Noise : public SecurityAdaptor,
@@ -21,7 +26,8 @@ namespace libp2p::security {
 
     Noise(crypto::KeyPair local_key,
           std::shared_ptr<crypto::CryptoProvider> crypto_provider,
-          std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller);
+          std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+          std::shared_ptr<CryptoExecutor> crypto_executor);
 
     ~Noise() override = default;
 
@@ -39,6 +45,8 @@ namespace libp2p::security {
     libp2p::crypto::KeyPair local_key_;
     std::shared_ptr<crypto::CryptoProvider> crypto_provider_;
     std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller_;
+    std::shared_ptr<CryptoExecutor> crypto_executor_;
+    std::shared_ptr<noise::HandshakeKeys> handshake_keys_;
   };
 
 }  // namespace libp2p::security
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <array>
 #include <list>
 
 #include <libp2p/connection/secure_connection.hpp>
@@ -18,12 +19,14 @@
 #include <libp2p/log/logger.hpp>
 #include <libp2p/security/noise/crypto/state.hpp>
 #include <libp2p/security/noise/handshake_message_marshaller_impl.hpp>
-#include <libp2p/security/noise/insecure_rw.hpp>
 
 namespace libp2p::connection {
   class NoiseConnection : public SecureConnection,
                           public std::enable_shared_from_this<NoiseConnection> {
    public:
+    /// Max number of frames sealed and sent by one write
+    static constexpr size_t kMaxFramesPerWrite = 4;
+
     ~NoiseConnection() override = default;
 
     NoiseConnection(
@@ -45,6 +48,9 @@ namespace libp2p::connection {
 
     void writeSome(BytesIn in, WriteCallbackFunc cb) override;
 
+    void writeSomeV(std::span<const BytesIn> in,
+                    WriteCallbackFunc cb) override;
+
     void deferWriteCallback(std::error_code ec, WriteCallbackFunc cb) override;
 
     bool isInitiator() const override;
@@ -60,14 +66,26 @@ namespace libp2p::connection {
     outcome::result<crypto::PublicKey> remotePublicKey() const override;
 
    private:
+    /// Decrypts `frame` into `out` if it fits, otherwise in place
+    void onFrame(BytesOut frame, BytesOut out, ReadCallbackFunc cb);
+
+    /// Seals `plaintext` into `write_buffer_` and sends resulting frames
+    void writeFrames(BytesIn plaintext, WriteCallbackFunc cb);
+
     std::shared_ptr<LayerConnection> connection_;
     crypto::PublicKey local_;
     crypto::PublicKey remote_;
     std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller_;
     std::shared_ptr<security::noise::CipherState> encoder_cs_;
     std::shared_ptr<security::noise::CipherState> decoder_cs_;
-    std::shared_ptr<Bytes> frame_buffer_;
-    std::shared_ptr<security::noise::InsecureReadWriter> framer_;
+    std::array<uint8_t, security::noise::kLengthPrefixSize> read_prefix_{};
+    /// Frame being read, decrypted in place; [read_offset_, read_end_) is
+    /// plaintext not consumed yet
+    Bytes read_buffer_;
+    size_t read_offset_ = 0;
+    size_t read_end_ = 0;
+    /// Length prefixes and ciphertext of outgoing frames
+    Bytes write_buffer_;
     log::Logger log_ = log::createLogger("NoiseConnection");
 
    public:
@@ -42,6 +42,9 @@ namespace libp2p::connection {
 
     void writeSome(BytesIn in, WriteCallbackFunc cb) override;
 
+    void writeSomeV(std::span<const BytesIn> in,
+                    WriteCallbackFunc cb) override;
+
     void deferWriteCallback(std::error_code ec, WriteCallbackFunc cb) override;
 
     bool isClosed() const override;
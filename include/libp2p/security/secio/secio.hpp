@@ -13,6 +13,8 @@
 #include <libp2p/crypto/random_generator.hpp>
 #include <libp2p/log/logger.hpp>
 #include <libp2p/peer/identity_manager.hpp>
+#include <libp2p/security/crypto_executor.hpp>
+#include <libp2p/security/secio/exchange_message.hpp>
 #include <libp2p/security/secio/exchange_message_marshaller.hpp>
 #include <libp2p/security/secio/propose_message_marshaller.hpp>
 #include <libp2p/security/security_adaptor.hpp>
@@ -47,7 +49,8 @@ namespace libp2p::security {
           std::shared_ptr<secio::ExchangeMessageMarshaller> exchange_marshaller,
           std::shared_ptr<peer::IdentityManager> idmgr,
           std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
-          std::shared_ptr<crypto::hmac::HmacProvider> hmac_provider);
+          std::shared_ptr<crypto::hmac::HmacProvider> hmac_provider,
+          std::shared_ptr<CryptoExecutor> crypto_executor);
 
     peer::ProtocolName getProtocolId() const override;
 
@@ -79,6 +82,21 @@ namespace libp2p::security {
         const std::shared_ptr<secio::Dialer> &dialer,
         SecConnCallbackFunc cb) const;
 
+    /// Generates ephemeral key and signs it, runs on crypto executor
+    outcome::result<secio::ExchangeMessage> makeExchangeMessage(
+        secio::Dialer &dialer) const;
+
+    /// Verifies remote exchange and derives stretched keys, runs on crypto
+    /// executor
+    outcome::result<void> deriveKeys(
+        secio::Dialer &dialer,
+        const secio::ExchangeMessage &remote_exchange) const;
+
+    void establishConnection(
+        const std::shared_ptr<connection::LayerConnection> &conn,
+        const std::shared_ptr<secio::Dialer> &dialer,
+        SecConnCallbackFunc cb) const;
+
     void closeConnection(
         const std::shared_ptr<libp2p::connection::LayerConnection> &conn,
         const std::error_code &err) const;
@@ -91,6 +109,7 @@ namespace libp2p::security {
     std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller_;
     // secio conn deps go below
     std::shared_ptr<crypto::hmac::HmacProvider> hmac_provider_;
+    std::shared_ptr<CryptoExecutor> crypto_executor_;
     //
     secio::ProposeMessage propose_message_;
     mutable Bytes remote_peer_rand_;
@@ -21,6 +21,8 @@ namespace libp2p::crypto::marshaller {
 }  // namespace libp2p::crypto::marshaller
 
 namespace libp2p::security {
+  class TlsSessionCache;
+
   /**
    * SSL context with libp2p TLS 1.3 certificate
    */
@@ -30,5 +32,8 @@ namespace libp2p::security {
 
     std::shared_ptr<boost::asio::ssl::context> tls;
     std::shared_ptr<boost::asio::ssl::context> quic;
+
+    /// Sessions for resumption of outbound `tls` connections
+    std::shared_ptr<TlsSessionCache> tls_sessions;
   };
 }  // namespace libp2p::security
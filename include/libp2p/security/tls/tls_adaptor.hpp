@@ -11,11 +11,14 @@
 
 #include <libp2p/crypto/key_marshaller.hpp>
 #include <libp2p/peer/identity_manager.hpp>
+#include <libp2p/security/crypto_executor.hpp>
 #include <libp2p/security/security_adaptor.hpp>
+#include <libp2p/security/tls/tls_details.hpp>
 #include <libp2p/security/tls/tls_errors.hpp>
 
 namespace libp2p::security {
   struct SslContext;
+  class TlsSessionCache;
 
   /// TLS 1.3 security adaptor
   class TlsAdaptor : public SecurityAdaptor,
@@ -29,7 +32,8 @@ namespace libp2p::security {
         std::shared_ptr<peer::IdentityManager> idmgr,
         std::shared_ptr<boost::asio::io_context> io_context,
         const SslContext &ssl_context,
-        std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller);
+        std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+        std::shared_ptr<CryptoExecutor> crypto_executor);
 
     /// Returns "/tls/1.0.0"
     peer::ProtocolName getProtocolId() const override;
@@ -60,5 +64,14 @@ namespace libp2p::security {
 
     /// Shared ssl context
     std::shared_ptr<boost::asio::ssl::context> ssl_context_;
+
+    /// Sessions for resumption of outbound connections
+    std::shared_ptr<TlsSessionCache> session_cache_;
+
+    /// Identities of verified peer certificates
+    std::shared_ptr<tls_details::CertificateCache> certificate_cache_;
+
+    /// Runs peer certificate verification off the io thread
+    std::shared_ptr<CryptoExecutor> crypto_executor_;
   };
 }  // namespace libp2p::security
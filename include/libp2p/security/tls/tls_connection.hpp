@@ -17,7 +17,12 @@
 #include <libp2p/connection/secure_connection.hpp>
 #include <libp2p/crypto/key_marshaller.hpp>
 #include <libp2p/peer/identity_manager.hpp>
+#include <libp2p/security/crypto_executor.hpp>
+#include <libp2p/security/tls/tls_details.hpp>
 #include <libp2p/security/tls/tls_errors.hpp>
+#include <libp2p/security/tls/tls_session_cache.hpp>
+
+struct ssl_st;
 
 namespace libp2p::connection {
 
@@ -39,20 +44,34 @@ namespace libp2p::connection {
     /// \param io_context Asio io context
     /// \param remote_peer Expected peer id of remote peer, has value for
     /// outbound connections
-    TlsConnection(std::shared_ptr<LayerConnection> original_connection,
-                  std::shared_ptr<boost::asio::ssl::context> ssl_context,
-                  const peer::IdentityManager &idmgr,
-                  std::shared_ptr<boost::asio::io_context> io_context,
-                  boost::optional<peer::PeerId> remote_peer);
+    /// \param session_cache Sessions for resumption of outbound connections,
+    /// may be null
+    /// \param certificate_cache Identities of verified peer certificates, may
+    /// be null
+    TlsConnection(
+        std::shared_ptr<LayerConnection> original_connection,
+        std::shared_ptr<boost::asio::ssl::context> ssl_context,
+        const peer::IdentityManager &idmgr,
+        std::shared_ptr<boost::asio::io_context> io_context,
+        boost::optional<peer::PeerId> remote_peer,
+        std::shared_ptr<security::TlsSessionCache> session_cache = nullptr,
+        std::shared_ptr<security::tls_details::CertificateCache>
+            certificate_cache = nullptr);
+
+    /// OpenSSL new session callback, stores tickets of outbound connections
+    /// into session cache. Returns 1 if session was taken
+    static int onNewSession(ssl_st *ssl, ssl_session_st *session);
 
     /// Performs async handshake and passes its result into callback. This fn is
     /// distinct from the ctor because it uses shared_from_this()
     /// \param cb Protocol upgraders callback
     /// \param key_marshaller Key marshaller, we need it to deal with our tricky
     /// certificate extension
+    /// \param crypto_executor Runs peer certificate verification, may be null
     void asyncHandshake(
         HandshakeCallback cb,
-        std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller);
+        std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+        std::shared_ptr<security::CryptoExecutor> crypto_executor);
 
     /// Dtor.
     /// TODO(artem): research whether the connection is closed automatically
@@ -86,6 +105,11 @@ namespace libp2p::connection {
     /// Async writes up to the # of bytes given
     void writeSome(BytesIn in, WriteCallbackFunc cb) override;
 
+    /// Async writes up to the # of bytes given, small buffers are coalesced
+    /// into one TLS record
+    void writeSomeV(std::span<const BytesIn> in,
+                    WriteCallbackFunc cb) override;
+
     /// Defers error callback to avoid reentrancy in async calls
     void deferWriteCallback(std::error_code ec, ReadCallbackFunc cb) override;
 
@@ -96,12 +120,24 @@ namespace libp2p::connection {
     outcome::result<void> close() override;
 
    private:
+    /// Offers cached session of remote peer for resumption
+    void resumeSession();
+
     /// Async handshake callback. Performs libp2p-specific verification and
-    /// extraction of remote peer's identity fields
+    /// extraction of remote peer's identity fields on crypto executor
     void onHandshakeResult(
         const boost::system::error_code &error,
-        const HandshakeCallback &cb,
-        const crypto::marshaller::KeyMarshaller &key_marshaller);
+        HandshakeCallback cb,
+        std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+        std::shared_ptr<security::CryptoExecutor> crypto_executor);
+
+    /// Checks remote peer's identity extracted from certificate
+    void onRemoteIdentity(
+        outcome::result<security::tls_details::PubkeyAndPeerId> id_res,
+        const HandshakeCallback &cb);
+
+    /// Closes connection and reports handshake error
+    void onHandshakeError(std::error_code ec, const HandshakeCallback &cb);
 
     /// Local peer id
     const peer::PeerId local_peer_;
@@ -121,6 +157,22 @@ namespace libp2p::connection {
     /// Remote public key, extracted from peer certificate during handshake
     boost::optional<crypto::PublicKey> remote_pubkey_;
 
+    std::shared_ptr<security::TlsSessionCache> session_cache_;
+
+    /// Key of this connection in session cache, empty if not cached
+    std::string session_key_;
+
+    /// Identities of verified peer certificates, shared among connections
+    std::shared_ptr<security::tls_details::CertificateCache>
+        certificate_cache_;
+
+    /// Identity verified with the session offered for resumption
+    std::optional<security::tls_details::PubkeyAndPeerId> resumed_identity_;
+
+    /// Coalesces buffers of vectored writes, SSL stream writes only the first
+    /// buffer of a sequence
+    Bytes write_gather_buffer_;
+
    public:
     LIBP2P_METRICS_INSTANCE_COUNT_IF_ENABLED(libp2p::connection::TlsConnection);
   };
@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include <array>
+
+#include <libp2p/common/lru_cache.hpp>
 #include <libp2p/crypto/key_marshaller.hpp>
 #include <libp2p/log/logger.hpp>
 #include <libp2p/peer/peer_id.hpp>
@@ -51,13 +54,24 @@ namespace libp2p::security::tls_details {
     peer::PeerId peer_id;
   };
 
+  /// Number of verified certificates remembered by CertificateCache
+  constexpr size_t kCertificateCacheSize = 1024;
+
+  /// SHA-256 fingerprint of certificate
+  using CertificateFingerprint = std::array<uint8_t, 32>;
+
+  /// Identities extracted from verified certificates, by fingerprint
+  using CertificateCache = LruCache<CertificateFingerprint, PubkeyAndPeerId>;
+
   /// Extract libp2p-special extension from certificate which contains
-  /// peer's public key. Also verifies signature using that key
+  /// peer's public key. Also verifies signature using that key.
   /// \param peer_certificate remote peer's certificate
   /// \param key_marshaller key marshaller (needed to deal with extension data)
+  /// \param certificate_cache verified certificates, may be null
   /// \return pubkey and peer id, or error
   outcome::result<PubkeyAndPeerId> verifyPeerAndExtractIdentity(
       x509_st *peer_certificate,
-      const crypto::marshaller::KeyMarshaller &key_marshaller);
+      const crypto::marshaller::KeyMarshaller &key_marshaller,
+      CertificateCache *certificate_cache);
 
 }  // namespace libp2p::security::tls_details
@@ -0,0 +1,51 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <libp2p/common/lru_cache.hpp>
+#include <libp2p/multi/multiaddress.hpp>
+#include <libp2p/security/tls/tls_details.hpp>
+
+struct ssl_session_st;
+
+namespace libp2p::security {
+
+  /// Number of TLS sessions kept for resumption
+  constexpr size_t kTlsSessionCacheSize = 1024;
+
+  /**
+   * Client side TLS 1.3 sessions (tickets) received from remote peers, keyed
+   * by peer id and address. Each session is used for one resumption only
+   */
+  class TlsSessionCache {
+   public:
+    struct Entry {
+      std::shared_ptr<ssl_session_st> session;
+
+      /// Identity verified in the handshake which produced the session
+      tls_details::PubkeyAndPeerId identity;
+    };
+
+    explicit TlsSessionCache(size_t capacity = kTlsSessionCacheSize);
+
+    /// Cache key of connection to `peer` at `address`
+    static std::string key(const peer::PeerId &peer,
+                           const multi::Multiaddress &address);
+
+    void put(const std::string &key, Entry entry);
+
+    /// Removes and returns session stored for `key`. Session made with
+    /// identity other than `peer` is dropped, so full handshake is done
+    std::optional<Entry> take(const std::string &key, const peer::PeerId &peer);
+
+    LruCacheStats stats() const;
+
+   private:
+    LruCache<std::string, Entry> sessions_;
+  };
+
+}  // namespace libp2p::security
@@ -68,6 +68,9 @@ namespace libp2p::transport {
 
     void writeSome(BytesIn in, WriteCallbackFunc cb) override;
 
+    void writeSomeV(std::span<const BytesIn> in,
+                    WriteCallbackFunc cb) override;
+
     void deferWriteCallback(std::error_code ec, WriteCallbackFunc cb) override;
 
     outcome::result<multi::Multiaddress> remoteMultiaddr() override;
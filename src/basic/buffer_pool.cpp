@@ -0,0 +1,71 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/basic/buffer_pool.hpp>
+
+#include <bit>
+
+namespace libp2p::basic {
+
+  BufferPool::BufferPool(size_t max_resident_bytes)
+      : max_resident_bytes_(max_resident_bytes) {}
+
+  Bytes BufferPool::acquire(size_t size) {
+    Bytes buffer;
+    size_t size_log2 = std::bit_width(size - 1);
+    if (size == 0 || size_log2 > kMaxSizeClassLog2) {
+      buffer.reserve(size);
+      return buffer;
+    }
+    size_log2 = std::max<size_t>(size_log2, kMinSizeClassLog2);
+    std::lock_guard lock{mutex_};
+    auto &free = free_.at(size_log2 - kMinSizeClassLog2);
+    if (free.empty()) {
+      ++stats_.misses;
+      buffer.reserve(size_t{1} << size_log2);
+      return buffer;
+    }
+    ++stats_.hits;
+    buffer = std::move(free.back());
+    free.pop_back();
+    stats_.resident_bytes -= buffer.capacity();
+    return buffer;
+  }
+
+  void BufferPool::release(Bytes &&buffer) {
+    auto capacity = buffer.capacity();
+    if (capacity < (size_t{1} << kMinSizeClassLog2)) {
+      return;
+    }
+    // size class is the largest one fitting into capacity
+    size_t capacity_log2 = std::bit_width(capacity) - 1;
+    if (capacity_log2 > kMaxSizeClassLog2) {
+      return;
+    }
+    std::lock_guard lock{mutex_};
+    if (stats_.resident_bytes + capacity > max_resident_bytes_) {
+      ++stats_.drops;
+      return;
+    }
+    buffer.clear();
+    stats_.resident_bytes += capacity;
+    free_.at(capacity_log2 - kMinSizeClassLog2).emplace_back(std::move(buffer));
+  }
+
+  void BufferPool::clear() {
+    std::lock_guard lock{mutex_};
+    for (auto &free : free_) {
+      std::vector<Bytes>{}.swap(free);
+    }
+    stats_.resident_bytes = 0;
+  }
+
+  BufferPool::Stats BufferPool::stats() const {
+    std::lock_guard lock{mutex_};
+    return stats_;
+  }
+
+}  // namespace libp2p::basic
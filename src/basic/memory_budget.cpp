@@ -0,0 +1,78 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/basic/memory_budget.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace libp2p::basic {
+
+  MemoryBudget::MemoryBudget(size_t limit,
+                             std::shared_ptr<MemoryBudget> parent)
+      : limit_(limit), parent_(std::move(parent)) {}
+
+  MemoryBudget::~MemoryBudget() {
+    if (parent_) {
+      parent_->release(used());
+    }
+  }
+
+  bool MemoryBudget::reserve(size_t bytes) {
+    auto reserved = reserveUpTo(bytes);
+    if (reserved < bytes) {
+      release(reserved);
+      return false;
+    }
+    return true;
+  }
+
+  size_t MemoryBudget::reserveUpTo(size_t bytes) {
+    bytes = take(bytes);
+    if (parent_ && bytes != 0) {
+      auto reserved = parent_->reserveUpTo(bytes);
+      put(bytes - reserved);
+      bytes = reserved;
+    }
+    return bytes;
+  }
+
+  void MemoryBudget::release(size_t bytes) {
+    assert(bytes <= used());
+    bytes = std::min(bytes, used());
+    put(bytes);
+    if (parent_) {
+      parent_->release(bytes);
+    }
+  }
+
+  size_t MemoryBudget::available() const {
+    auto used = this->used();
+    auto available = limit_ > used ? limit_ - used : 0;
+    if (parent_) {
+      available = std::min(available, parent_->available());
+    }
+    return available;
+  }
+
+  size_t MemoryBudget::take(size_t bytes) {
+    auto used = used_.load(std::memory_order_relaxed);
+    size_t taken = 0;
+    do {
+      taken = std::min(bytes, limit_ > used ? limit_ - used : 0);
+      if (taken == 0) {
+        return 0;
+      }
+    } while (!used_.compare_exchange_weak(
+        used, used + taken, std::memory_order_relaxed));
+    return taken;
+  }
+
+  void MemoryBudget::put(size_t bytes) {
+    used_.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+
+}  // namespace libp2p::basic
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <cstring>
 
@@ -11,45 +13,54 @@
 
 namespace libp2p::basic {
 
-  ReadBuffer::ReadBuffer(size_t alloc_granularity)
+  ReadBuffer::ReadBuffer(size_t alloc_granularity,
+                         std::shared_ptr<BufferPool> pool)
       : alloc_granularity_(alloc_granularity),
+        pool_(std::move(pool)),
         total_size_(0),
         first_byte_offset_(0),
         capacity_remains_(0) {
     assert(alloc_granularity > 0);
   }
 
-  void ReadBuffer::add(BytesIn bytes) {
+  ReadBuffer::~ReadBuffer() {
+    clear();
+  }
+
+  void ReadBuffer::add(BytesIn bytes, const SharedBytes &owner) {
     size_t sz = bytes.size();
     if (sz == 0) {
       return;
     }
 
-    if (capacity_remains_ >= sz) {
+    if (owner && sz * kMaxSharedOverhead >= owner->size()) {
+      fragments_.push_back(Fragment{.owner = owner, .shared = bytes});
+      capacity_remains_ = 0;
+    } else if (capacity_remains_ >= sz) {
       assert(!fragments_.empty());
 
-      auto &vec = fragments_.back();
+      auto &vec = fragments_.back().bytes;
       vec.insert(vec.end(), bytes.begin(), bytes.end());
 
       capacity_remains_ -= sz;
     } else if (capacity_remains_ > 0) {
-      auto &vec = fragments_.back();
+      auto &vec = fragments_.back().bytes;
 
-      size_t new_capacity = vec.size() + sz + alloc_granularity_;
-      vec.reserve(new_capacity);
+      size_t new_capacity = capacityFor(vec.size() + sz);
+      reserve(vec, new_capacity);
       vec.insert(vec.end(), bytes.begin(), bytes.end());
 
-      capacity_remains_ = alloc_granularity_;
+      capacity_remains_ = vec.capacity() - vec.size();
     } else {
       fragments_.emplace_back();
-      auto &vec = fragments_.back();
+      auto &vec = fragments_.back().bytes;
 
-      size_t new_capacity = sz + alloc_granularity_;
+      size_t new_capacity = capacityFor(sz);
 
-      vec.reserve(new_capacity);
+      reserve(vec, new_capacity);
       vec.insert(vec.end(), bytes.begin(), bytes.end());
 
-      capacity_remains_ = alloc_granularity_;
+      capacity_remains_ = vec.capacity() - vec.size();
     }
 
     total_size_ += sz;
@@ -81,13 +92,15 @@ namespace libp2p::basic {
     return n_bytes;
   }
 
-  size_t ReadBuffer::addAndConsume(BytesIn in, BytesOut out) {
+  size_t ReadBuffer::addAndConsume(BytesIn in,
+                                   BytesOut out,
+                                   const SharedBytes &owner) {
     if (in.empty()) {
       return consume(out);
     }
 
     if (out.empty()) {
-      add(in);
+      add(in, owner);
       return 0;
     }
 
@@ -98,7 +111,7 @@ namespace libp2p::basic {
       }
       memcpy(out.data(), in.data(), out.size());
       in = in.subspan(out.size());
-      add(in);
+      add(in, owner);
       return out.size();
     }
 
@@ -107,35 +120,71 @@ namespace libp2p::basic {
 
     if (out_size <= total_size_) {
       consumed = consume(out);
-      add(in);
+      add(in, owner);
       return consumed;
     }
 
     consumed = consumeAll(out);
     auto out_remains = out.subspan(consumed);
-    return consumed + addAndConsume(in, out_remains);
+    return consumed + addAndConsume(in, out_remains, owner);
   }
 
   void ReadBuffer::clear() {
+    reset();
+    std::deque<Fragment>{}.swap(fragments_);
+  }
+
+  void ReadBuffer::reset() {
     total_size_ = 0;
     first_byte_offset_ = 0;
     capacity_remains_ = 0;
-    std::deque<Fragment>{}.swap(fragments_);
+    for (auto &f : fragments_) {
+      deallocate(f);
+    }
+    fragments_.clear();
+  }
+
+  size_t ReadBuffer::capacityFor(size_t size) const {
+    if (!pool_) {
+      return size + alloc_granularity_;
+    }
+    // pool rounds capacity up to power of 2, so size + granularity would
+    // waste up to a half of the buffer
+    return std::max(std::bit_ceil(size), alloc_granularity_);
+  }
+
+  void ReadBuffer::reserve(Bytes &bytes, size_t capacity) {
+    if (!pool_) {
+      bytes.reserve(capacity);
+      return;
+    }
+    auto reserved = pool_->acquire(capacity);
+    reserved.assign(bytes.begin(), bytes.end());
+    pool_->release(std::move(bytes));
+    bytes = std::move(reserved);
+  }
+
+  void ReadBuffer::deallocate(Fragment &fragment) {
+    if (pool_ && !fragment.owner) {
+      pool_->release(std::move(fragment.bytes));
+    }
   }
 
   size_t ReadBuffer::consumeAll(BytesOut out) {
     assert(!fragments_.empty());
     auto *p = out.data();
-    auto n = fragments_.front().size() - first_byte_offset_;
-    assert(n <= fragments_.front().size());
+    auto front = fragments_.front().data();
+    auto n = front.size() - first_byte_offset_;
+    assert(n <= front.size());
 
-    memcpy(p, fragments_.front().data() + first_byte_offset_, n);  // NOLINT
+    memcpy(p, front.data() + first_byte_offset_, n);  // NOLINT
 
     auto it = ++fragments_.begin();
     while (it != fragments_.end()) {
       p += n;  // NOLINT
-      n = it->size();
-      memcpy(p, it->data(), n);
+      auto data = it->data();
+      n = data.size();
+      memcpy(p, data.data(), n);
       ++it;
     }
 
@@ -146,23 +195,21 @@ namespace libp2p::basic {
     capacity_remains_ = 0;
 
     // Find one fragment if not too large to avoid further allocations
-    bool keep_one_fragment = false;
-    bool is_first = true;
+    Bytes kept;
     for (auto &f : fragments_) {
-      if (f.capacity() <= alloc_granularity_ * 2) {
-        f.clear();
-        capacity_remains_ = f.capacity();
-        if (!is_first) {
-          fragments_.front() = std::move(f);
-        }
-        keep_one_fragment = true;
-        break;
-      }
-      if (is_first) {
-        is_first = false;
+      if (kept.capacity() == 0 && !f.owner
+          && f.bytes.capacity() <= alloc_granularity_ * 2) {
+        kept = std::move(f.bytes);
+      } else {
+        deallocate(f);
       }
     }
-    fragments_.resize(keep_one_fragment ? 1 : 0);
+    fragments_.clear();
+    if (kept.capacity() != 0) {
+      kept.clear();
+      capacity_remains_ = kept.capacity();
+      fragments_.emplace_back(Fragment{.bytes = std::move(kept)});
+    }
 
     return ret;
   }
@@ -172,7 +219,7 @@ namespace libp2p::basic {
       return 0;
     }
 
-    auto &f = fragments_.front();
+    auto f = fragments_.front().data();
 
     assert(f.size() > first_byte_offset_);
 
@@ -187,6 +234,7 @@ namespace libp2p::basic {
       first_byte_offset_ += n;
     } else {
       first_byte_offset_ = 0;
+      deallocate(fragments_.front());
       fragments_.pop_front();
     }
 
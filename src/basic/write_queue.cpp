@@ -138,4 +138,10 @@ namespace libp2p::basic {
     queue_.swap(tmp_queue);
   }
 
+  void WriteQueue::reset() {
+    active_index_ = 0;
+    total_unsent_size_ = 0;
+    queue_.clear();
+  }
+
 }  // namespace libp2p::basic
@@ -60,6 +60,8 @@ OUTCOME_CPP_DEFINE_CATEGORY(libp2p::connection, Stream::Error, e) {
       return "Stream: write buffers overflow";
     case E::STREAM_RECEIVE_OVERFLOW:
       return "Stream: read window overflow";
+    case E::STREAM_RECEIVE_BUDGET_EXHAUSTED:
+      return "Stream: receive memory budget exhausted";
     default:
       break;
   }
@@ -9,7 +9,6 @@
 #include <libp2p/crypto/error.hpp>
 
 namespace libp2p::crypto::chachapoly {
-  constexpr size_t kTagSize = 16;
 
 #define IF1(expr, err, result) \
   if (1 != (expr)) {           \
@@ -36,22 +35,50 @@ namespace libp2p::crypto::chachapoly {
     return outcome::success();
   }
 
+  outcome::result<EVP_AEAD_CTX *> ChaCha20Poly1305Impl::context(
+      bool encrypt) {
+    auto &ctx = encrypt ? seal_ctx_ : open_ctx_;
+    auto &ready = encrypt ? seal_ctx_ready_ : open_ctx_ready_;
+    if (!ready) {
+      OUTCOME_TRY(init(ctx.get(), encrypt));
+      ready = true;
+    }
+    return ctx.get();
+  }
+
   outcome::result<Bytes> ChaCha20Poly1305Impl::encrypt(const Nonce &nonce,
                                                        BytesIn plaintext,
                                                        BytesIn aad) {
-    bssl::ScopedEVP_AEAD_CTX ctx;
-    OUTCOME_TRY(init(ctx.get(), true));
     Bytes result;
-    // just reserving the space, possibly without actual memory allocation:
-    // ciphertext length equals to plaintext length
-    // one block size for EncryptFinal_ex (usually not required)
-    // 16 bytes for the tag
+    // ciphertext length equals to plaintext length, plus the tag
     result.resize(plaintext.size() + overhead_);
+    OUTCOME_TRY(out_size, seal(nonce, plaintext, aad, result));
+    result.resize(out_size);
+    return result;
+  }
+
+  outcome::result<Bytes> ChaCha20Poly1305Impl::decrypt(const Nonce &nonce,
+                                                       BytesIn ciphertext,
+                                                       BytesIn aad) {
+    Bytes result;
+    // plain text should take less bytes than cipher text,
+    // at least it would not contain tag-length bytes (16).
+    result.resize(ciphertext.size());
+    OUTCOME_TRY(out_size, open(nonce, ciphertext, aad, result));
+    result.resize(out_size);
+    return result;
+  }
+
+  outcome::result<size_t> ChaCha20Poly1305Impl::seal(const Nonce &nonce,
+                                                     BytesIn plaintext,
+                                                     BytesIn aad,
+                                                     BytesOut out) {
+    OUTCOME_TRY(ctx, context(true));
     size_t out_size = 0;
-    IF1(EVP_AEAD_CTX_seal(ctx.get(),
-                          result.data(),
+    IF1(EVP_AEAD_CTX_seal(ctx,
+                          out.data(),
                           &out_size,
-                          result.size(),
+                          out.size(),
                           nonce.data(),
                           nonce.size(),
                           plaintext.data(),
@@ -60,25 +87,19 @@ namespace libp2p::crypto::chachapoly {
                           aad.size()),
         "EVP_AEAD_CTX_seal",
         OpenSslError::FAILED_ENCRYPT_UPDATE);
-    result.resize(out_size);
-    return result;
+    return out_size;
   }
 
-  outcome::result<Bytes> ChaCha20Poly1305Impl::decrypt(const Nonce &nonce,
-                                                       BytesIn ciphertext,
-                                                       BytesIn aad) {
-    bssl::ScopedEVP_AEAD_CTX ctx;
-    OUTCOME_TRY(init(ctx.get(), false));
-    Bytes result;
-    // plain text should take less bytes than cipher text,
-    // at least it would not contain tag-length bytes (16).
-    // single block size for the case when len(in) == len(out)
-    result.resize(ciphertext.size());
+  outcome::result<size_t> ChaCha20Poly1305Impl::open(const Nonce &nonce,
+                                                     BytesIn ciphertext,
+                                                     BytesIn aad,
+                                                     BytesOut out) {
+    OUTCOME_TRY(ctx, context(false));
     size_t out_size = 0;
-    IF1(EVP_AEAD_CTX_open(ctx.get(),
-                          result.data(),
+    IF1(EVP_AEAD_CTX_open(ctx,
+                          out.data(),
                           &out_size,
-                          result.size(),
+                          out.size(),
                           nonce.data(),
                           nonce.size(),
                           ciphertext.data(),
@@ -87,8 +108,7 @@ namespace libp2p::crypto::chachapoly {
                           aad.size()),
         "EVP_AEAD_CTX_open",
         OpenSslError::FAILED_DECRYPT_UPDATE);
-    result.resize(out_size);
-    return result;
+    return out_size;
   }
 
 }  // namespace libp2p::crypto::chachapoly
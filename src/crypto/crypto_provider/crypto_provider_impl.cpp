@@ -270,6 +270,42 @@ namespace libp2p::crypto {
     }
   }
 
+  outcome::result<std::vector<bool>> CryptoProviderImpl::verifyBatch(
+      std::span<const SignatureBatchItem> items) const {
+    std::vector<bool> result(items.size(), false);
+    std::vector<ed25519::BatchItem> ed_items;
+    std::vector<size_t> ed_indices;
+    for (size_t i = 0; i < items.size(); ++i) {
+      const auto &item = items[i];
+      if (item.public_key.type == Key::Type::Ed25519) {
+        ed25519::BatchItem ed_item{.message = item.message};
+        if (item.public_key.data.size() != ed_item.public_key.size()
+            || item.signature.size() != ed_item.signature.size()) {
+          continue;
+        }
+        std::copy_n(item.public_key.data.begin(),
+                    ed_item.public_key.size(),
+                    ed_item.public_key.begin());
+        std::copy_n(item.signature.begin(),
+                    ed_item.signature.size(),
+                    ed_item.signature.begin());
+        ed_items.emplace_back(ed_item);
+        ed_indices.emplace_back(i);
+        continue;
+      }
+      // other key types have no batch api, verify them one by one
+      auto res = verify(item.message, item.signature, item.public_key);
+      result[i] = res && res.value();
+    }
+    if (!ed_items.empty()) {
+      OUTCOME_TRY(ed_result, ed25519_provider_->verifyBatch(ed_items));
+      for (size_t i = 0; i < ed_indices.size(); ++i) {
+        result[ed_indices[i]] = ed_result[i];
+      }
+    }
+    return result;
+  }
+
   outcome::result<bool> CryptoProviderImpl::verifyRsa(
       BytesIn message, BytesIn signature, const PublicKey &public_key) const {
     rsa::PublicKey rsa_pub;
@@ -79,12 +79,18 @@ namespace libp2p::crypto::ecdsa {
       const PrehashedMessage &message,
       const Signature &signature,
       const PublicKey &public_key) const {
-    OUTCOME_TRY(ec_key, convertBytesToEcKey(public_key, d2i_EC_PUBKEY));
+    OUTCOME_TRY(ec_key, key_cache_.getOrMake(public_key, [&] {
+      return convertBytesToEcKey(public_key, d2i_EC_PUBKEY);
+    }));
     OUTCOME_TRY(signature_status,
                 VerifyEcSignature(message, signature, ec_key));
     return signature_status;
   }
 
+  LruCacheStats EcdsaProviderImpl::keyCacheStats() const {
+    return key_cache_.stats();
+  }
+
   template <typename KeyType>
   outcome::result<KeyType> EcdsaProviderImpl::convertEcKeyToBytes(
       const std::shared_ptr<EC_KEY> &ec_key, auto converter) const {
@@ -105,9 +105,7 @@ namespace libp2p::crypto::ed25519 {
       BytesIn message,
       const Signature &signature,
       const PublicKey &public_key) const {
-    OUTCOME_TRY(evp_pkey,
-                NewEvpPkeyFromBytes(
-                    EVP_PKEY_ED25519, public_key, EVP_PKEY_new_raw_public_key));
+    OUTCOME_TRY(evp_pkey, parsePublicKey(public_key));
     constexpr auto FAILED{CryptoProviderError::SIGNATURE_VERIFICATION_FAILED};
 
     std::shared_ptr<EVP_MD_CTX> mctx{EVP_MD_CTX_new(), EVP_MD_CTX_free};
@@ -131,4 +129,46 @@ namespace libp2p::crypto::ed25519 {
 
     return FAILED;
   }
+
+  outcome::result<std::vector<bool>> Ed25519ProviderImpl::verifyBatch(
+      std::span<const BatchItem> items) const {
+    // OpenSSL has no batch verification equation for Ed25519, so the batch
+    // shares one digest context and takes parsed keys from cache
+    std::shared_ptr<EVP_MD_CTX> mctx{EVP_MD_CTX_new(), EVP_MD_CTX_free};
+    if (nullptr == mctx) {
+      return CryptoProviderError::SIGNATURE_VERIFICATION_FAILED;
+    }
+    std::vector<bool> result;
+    result.reserve(items.size());
+    for (const auto &item : items) {
+      auto evp_pkey = parsePublicKey(item.public_key);
+      if (!evp_pkey) {
+        result.push_back(false);
+        continue;
+      }
+      EVP_MD_CTX_reset(mctx.get());
+      auto *pkey = evp_pkey.value().get();
+      result.push_back(
+          1 == EVP_DigestVerifyInit(mctx.get(), nullptr, nullptr, nullptr, pkey)
+          && 1
+                 == EVP_DigestVerify(mctx.get(),
+                                     item.signature.data(),
+                                     item.signature.size(),
+                                     item.message.data(),
+                                     item.message.size()));
+    }
+    return result;
+  }
+
+  LruCacheStats Ed25519ProviderImpl::keyCacheStats() const {
+    return key_cache_.stats();
+  }
+
+  outcome::result<std::shared_ptr<EVP_PKEY>>
+  Ed25519ProviderImpl::parsePublicKey(const PublicKey &public_key) const {
+    return key_cache_.getOrMake(public_key, [&] {
+      return NewEvpPkeyFromBytes(
+          EVP_PKEY_ED25519, public_key, EVP_PKEY_new_raw_public_key);
+    });
+  }
 }  // namespace libp2p::crypto::ed25519
@@ -83,6 +83,16 @@ namespace libp2p::crypto::marshaller {
 
   outcome::result<PublicKey> KeyMarshallerImpl::unmarshalPublicKey(
       const ProtobufKey &proto_key) const {
+    return key_cache_.getOrMake(proto_key.key,
+                                [&] { return decodePublicKey(proto_key); });
+  }
+
+  LruCacheStats KeyMarshallerImpl::keyCacheStats() const {
+    return key_cache_.stats();
+  }
+
+  outcome::result<PublicKey> KeyMarshallerImpl::decodePublicKey(
+      const ProtobufKey &proto_key) const {
     protobuf::PublicKey protobuf_key;
     if (!protobuf_key.ParseFromArray(proto_key.key.data(),
                                      static_cast<int>(proto_key.key.size()))) {
@@ -156,7 +156,27 @@ namespace libp2p::crypto::rsa {
       BytesIn message,
       const Signature &signature,
       const PublicKey &public_key) const {
-    OUTCOME_TRY(x509_key, RsaProviderImpl::getPublicKeyFromBytes(public_key));
+    OUTCOME_TRY(rsa, key_cache_.getOrMake(public_key, [&] {
+      return parsePublicKey(public_key);
+    }));
+
+    OUTCOME_TRY(digest, sha256(message));
+    int result = RSA_verify(NID_sha256,
+                            digest.data(),
+                            digest.size(),
+                            signature.data(),
+                            signature.size(),
+                            rsa.get());
+    return 1 == result;
+  }
+
+  LruCacheStats RsaProviderImpl::keyCacheStats() const {
+    return key_cache_.stats();
+  }
+
+  outcome::result<std::shared_ptr<RSA>> RsaProviderImpl::parsePublicKey(
+      const PublicKey &public_key) {
+    OUTCOME_TRY(x509_key, getPublicKeyFromBytes(public_key));
 
     EVP_PKEY *key = X509_PUBKEY_get(x509_key.get());
     if (!key) {
@@ -164,20 +184,11 @@ namespace libp2p::crypto::rsa {
     }
     std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> key_ptr{key,
                                                                 EVP_PKEY_free};
-    std::unique_ptr<RSA, decltype(&RSA_free)> rsa{
-        EVP_PKEY_get1_RSA(key_ptr.get()), RSA_free};
+    std::shared_ptr<RSA> rsa{EVP_PKEY_get1_RSA(key_ptr.get()), RSA_free};
     if (!rsa) {
       return CryptoProviderError::SIGNATURE_VERIFICATION_FAILED;
     }
-
-    OUTCOME_TRY(digest, sha256(message));
-    int result = RSA_verify(NID_sha256,
-                            digest.data(),
-                            digest.size(),
-                            signature.data(),
-                            signature.size(),
-                            rsa.get());
-    return 1 == result;
+    return rsa;
   }
 
   outcome::result<std::shared_ptr<X509_PUBKEY>>
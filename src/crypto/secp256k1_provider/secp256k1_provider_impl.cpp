@@ -77,11 +77,7 @@ namespace libp2p::crypto::secp256k1 {
   outcome::result<bool> Secp256k1ProviderImpl::verify(
       BytesIn message, const Signature &signature, const PublicKey &key) const {
     OUTCOME_TRY(digest, sha256(message));
-    secp256k1_pubkey ffi_pub;
-    if (secp256k1_ec_pubkey_parse(ctx_.get(), &ffi_pub, key.data(), key.size())
-        == 0) {
-      return CryptoProviderError::SIGNATURE_VERIFICATION_FAILED;
-    }
+    OUTCOME_TRY(ffi_pub, parsePublicKey(key));
     secp256k1_ecdsa_signature ffi_sig;
     if (secp256k1_ecdsa_signature_parse_der(
             ctx_.get(), &ffi_sig, signature.data(), signature.size())
@@ -91,4 +87,22 @@ namespace libp2p::crypto::secp256k1 {
     return secp256k1_ecdsa_verify(ctx_.get(), &ffi_sig, digest.data(), &ffi_pub)
         == 1;
   }
+
+  LruCacheStats Secp256k1ProviderImpl::keyCacheStats() const {
+    return key_cache_.stats();
+  }
+
+  outcome::result<secp256k1_pubkey> Secp256k1ProviderImpl::parsePublicKey(
+      const PublicKey &key) const {
+    return key_cache_.getOrMake(
+        key, [&]() -> outcome::result<secp256k1_pubkey> {
+          secp256k1_pubkey ffi_pub;
+          if (secp256k1_ec_pubkey_parse(
+                  ctx_.get(), &ffi_pub, key.data(), key.size())
+              == 0) {
+            return CryptoProviderError::SIGNATURE_VERIFICATION_FAILED;
+          }
+          return ffi_pub;
+        });
+  }
 }  // namespace libp2p::crypto::secp256k1
@@ -6,52 +6,107 @@
 
 #include <libp2p/multi/multibase_codec/codecs/base16.hpp>
 
-#include <algorithm>
-#include <cctype>
+#include <array>
 
 #include <libp2p/multi/multibase_codec/codecs/base_error.hpp>
-#include <qtils/hex.hpp>
-#include <qtils/unhex.hpp>
 
 namespace {
+  using libp2p::BytesIn;
+  using libp2p::multi::detail::BaseError;
+
+  constexpr int8_t kInvalid = -1;
+
+  /// Pairs of hex digits for every byte value
+  constexpr std::array<std::array<char, 2>, 256> makeEncodeTable(
+      std::string_view digits) {
+    std::array<std::array<char, 2>, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+      table[i] = {digits[i >> 4], digits[i & 0xf]};
+    }
+    return table;
+  }
+
+  constexpr auto kUpperTable = makeEncodeTable("0123456789ABCDEF");
+  constexpr auto kLowerTable = makeEncodeTable("0123456789abcdef");
+
+  /// Value of hex digit of any case for every char
+  constexpr std::array<int8_t, 256> kDecodeTable = [] {
+    std::array<int8_t, 256> table{};
+    table.fill(kInvalid);
+    for (int i = 0; i < 10; ++i) {
+      table['0' + i] = static_cast<int8_t>(i);
+    }
+    for (int i = 0; i < 6; ++i) {
+      table['a' + i] = static_cast<int8_t>(10 + i);
+      table['A' + i] = static_cast<int8_t>(10 + i);
+    }
+    return table;
+  }();
+
+  std::string encode(BytesIn bytes,
+                     const std::array<std::array<char, 2>, 256> &table) {
+    std::string out(bytes.size() * 2, '\0');
+    auto *dst = out.data();
+    for (auto byte : bytes) {
+      const auto &pair = table[byte];
+      *dst++ = pair[0];
+      *dst++ = pair[1];
+    }
+    return out;
+  }
+
+  enum class Case { UPPER, LOWER };
+
   /**
-   * Check, if hex string is in uppercase
-   * @param string to be checked
-   * @return true, if provided string is uppercase hex-encoded, false otherwise
+   * Decodes hex string in one pass. Uppercase input must not contain
+   * lowercase letters, lowercase input must contain at least one
+   * @param string to be decoded
+   * @param expected case of letters
+   * @return decoded bytes
    */
-  bool encodingCaseIsUpper(std::string_view string) {
-    return std::all_of(string.begin(), string.end(), [](const char &c) {
-      // NOLINTNEXTLINE(readability-implicit-bool-conversion)
-      return !std::isalpha(c) || static_cast<bool>(std::isupper(c));
-    });
+  outcome::result<libp2p::Bytes> decode(std::string_view string,
+                                        Case expected) {
+    libp2p::Bytes out(string.size() / 2);
+    bool has_lower = false;
+    bool valid = string.size() % 2 == 0;
+    for (size_t i = 0; i < string.size(); ++i) {
+      auto c = static_cast<uint8_t>(string[i]);
+      has_lower |= c >= 'a' && c <= 'z';
+      auto value = kDecodeTable[c];
+      valid &= value != kInvalid;
+      if (i / 2 < out.size()) {
+        out[i / 2] = static_cast<uint8_t>(out[i / 2] << 4 | (value & 0xf));
+      }
+    }
+    // case checks take precedence over malformed body
+    if (expected == Case::UPPER && has_lower) {
+      return BaseError::NON_UPPERCASE_INPUT;
+    }
+    if (expected == Case::LOWER && !has_lower) {
+      return BaseError::NON_LOWERCASE_INPUT;
+    }
+    if (!valid) {
+      return BaseError::INVALID_BASE16_INPUT;
+    }
+    return out;
   }
 }  // namespace
 
 namespace libp2p::multi::detail {
   std::string encodeBase16Upper(BytesIn bytes) {
-    return fmt::format("{:X}", bytes);
+    return encode(bytes, kUpperTable);
   }
 
   std::string encodeBase16Lower(BytesIn bytes) {
-    return fmt::format("{:x}", bytes);
+    return encode(bytes, kLowerTable);
   }
 
   outcome::result<Bytes> decodeBase16Upper(std::string_view string) {
-    // we need this check, because Boost can unhex any kind of base16 with one
-    // func, but the base must be specified correctly
-    if (!encodingCaseIsUpper(string)) {
-      return BaseError::NON_UPPERCASE_INPUT;
-    }
-    return qtils::unhex(string);
+    return decode(string, Case::UPPER);
   }
 
   outcome::result<Bytes> decodeBase16Lower(std::string_view string) {
-    // we need this check, because Boost can unhex any kind of base16 with one
-    // func, but the base must be specified correctly
-    if (encodingCaseIsUpper(string)) {
-      return BaseError::NON_LOWERCASE_INPUT;
-    }
-    return qtils::unhex(string);
+    return decode(string, Case::LOWER);
   }
 
 }  // namespace libp2p::multi::detail
@@ -28,7 +28,7 @@
  * THE SOFTWARE.
  **/
 
-#include <span>
+#include <array>
 
 #include <libp2p/multi/multibase_codec/codecs/base32.hpp>
 #include <libp2p/multi/multibase_codec/codecs/base_error.hpp>
@@ -42,70 +42,58 @@ namespace libp2p::multi::detail {
     UPPER,
   };
 
-  int get_byte(int block) {
-    return block * 5 / 8;
-  }
-
-  int get_bit(int block) {
-    return 8 - 5 - block * 5 % 8;
-  }
+  constexpr int8_t kInvalid = -1;
 
-  char encode_char(unsigned char c, Base32Mode mode) {
-    if (mode == Base32Mode::UPPER) {
-      return kUpperBase32Alphabet[c & 0x1F];  // 0001 1111
+  /// Value of base32 digit for every char, letters of one case only
+  constexpr std::array<int8_t, 256> makeDecodeTable(char first_letter) {
+    std::array<int8_t, 256> table{};
+    table.fill(kInvalid);
+    for (int i = 0; i < 26; ++i) {
+      table[first_letter + i] = static_cast<int8_t>(i);
     }
-    return kLowerBase32Alphabet[c & 0x1F];
-  }
-
-  unsigned char shift_right(uint8_t byte, int8_t offset) {
-    if (offset > 0) {
-      return byte >> offset;
+    for (int i = 0; i < 6; ++i) {
+      table['2' + i] = static_cast<int8_t>(26 + i);
     }
-
-    return byte << -offset;
-  }
-
-  unsigned char shift_left(uint8_t byte, int8_t offset) {
-    return shift_right(byte, -offset);
+    return table;
   }
 
-  int encode_sequence(BytesIn plain, std::span<char> coded, Base32Mode mode) {
-    for (int block = 0; block < 8; block++) {
-      size_t byte = get_byte(block);
-      int bit = get_bit(block);
-
-      if (byte >= plain.size()) {
-        return block;
-      }
+  constexpr auto kUpperDecodeTable = makeDecodeTable('A');
+  constexpr auto kLowerDecodeTable = makeDecodeTable('a');
 
-      unsigned char c = shift_right(plain[byte], bit);
-
-      if (bit < 0 && byte < plain.size() - 1) {
-        c |= shift_right(plain[byte + 1], 8 + bit);
-      }
-      coded[block] = encode_char(c, mode);
-    }
-    return 8;
+  /// Number of chars encoding `n` bytes, without padding
+  constexpr size_t encodedSize(size_t n) {
+    return (n * 8 + 4) / 5;
   }
 
   std::string encodeBase32(BytesIn bytes, Base32Mode mode) {
-    std::string result;
-    if (bytes.size() % 5 == 0) {
-      result = std::string(bytes.size() / 5 * 8, ' ');
-    } else {
-      result = std::string((bytes.size() / 5 + 1) * 8, ' ');
+    const auto &alphabet =
+        mode == Base32Mode::UPPER ? kUpperBase32Alphabet : kLowerBase32Alphabet;
+    std::string result(encodedSize(bytes.size()), '\0');
+    auto *out = result.data();
+    size_t i = 0;
+    // 5 bytes make 8 chars
+    for (; i + 5 <= bytes.size(); i += 5) {
+      uint64_t group = 0;
+      for (size_t j = 0; j < 5; ++j) {
+        group = group << 8 | bytes[i + j];
+      }
+      for (int shift = 35; shift >= 0; shift -= 5) {
+        *out++ = alphabet[(group >> shift) & 0x1f];
+      }
     }
-
-    for (size_t i = 0, j = 0; i < bytes.size(); i += 5, j += 8) {
-      int n = encode_sequence(
-          std::span(&bytes[i], std::min<size_t>(bytes.size() - i, 5)),
-          std::span(&result[j], 8),
-          mode);
-      if (n < 8) {
-        result.erase(result.end() - (8 - n), result.end());
+    // tail is zero padded to a whole number of chars
+    if (auto tail = bytes.size() - i; tail != 0) {
+      uint64_t group = 0;
+      for (size_t j = 0; j < tail; ++j) {
+        group = group << 8 | bytes[i + j];
+      }
+      auto chars = encodedSize(tail);
+      group <<= chars * 5 - tail * 8;
+      for (auto shift = static_cast<int>(chars * 5) - 5; shift >= 0;
+           shift -= 5) {
+        *out++ = alphabet[(group >> shift) & 0x1f];
       }
     }
-
     return result;
   }
 
@@ -117,67 +105,43 @@ namespace libp2p::multi::detail {
     return encodeBase32(bytes, Base32Mode::LOWER);
   }
 
-  int decode_char(unsigned char c, Base32Mode mode) {
-    char decoded_ch = -1;
-
-    if (mode == Base32Mode::UPPER) {
-      if (c >= 'A' && c <= 'Z') {
-        decoded_ch = c - 'A';  // NOLINT
-      }
-    } else {
-      if (c >= 'a' && c <= 'z') {
-        decoded_ch = c - 'a';  // NOLINT
-      }
-    }
-    if (c >= '2' && c <= '7') {
-      decoded_ch = c - '2' + 26;  // NOLINT
-    }
-
-    return decoded_ch;
-  }
-
-  outcome::result<int> decode_sequence(std::span<const char> coded,
-                                       BytesOut plain,
-                                       Base32Mode mode) {
-    plain[0] = 0;
-    for (size_t block = 0; block < 8; block++) {
-      int bit = get_bit(block);
-      int byte = get_byte(block);
-
-      if (block >= coded.size()) {
-        return byte;
+  outcome::result<Bytes> decodeBase32(std::string_view string,
+                                      Base32Mode mode) {
+    const auto &table =
+        mode == Base32Mode::UPPER ? kUpperDecodeTable : kLowerDecodeTable;
+    // trailing bits which don't make a whole byte are dropped
+    Bytes result(string.size() / 8 * 5 + string.size() % 8 * 5 / 8);
+    auto *out = result.data();
+    size_t i = 0;
+    // 8 chars make 5 bytes
+    for (; i + 8 <= string.size(); i += 8) {
+      uint64_t group = 0;
+      int8_t check = 0;
+      for (size_t j = 0; j < 8; ++j) {
+        auto value = table[static_cast<uint8_t>(string[i + j])];
+        check |= value;
+        group = group << 5 | static_cast<uint8_t>(value & 0x1f);
       }
-      int c = decode_char(coded[block], mode);
-      if (c < 0) {
+      if (check < 0) {
         return BaseError::INVALID_BASE32_INPUT;
       }
-
-      plain[byte] |= shift_left(c, bit);
-      if (bit < 0) {
-        plain[byte + 1] = shift_left(c, 8 + bit);
+      for (int shift = 32; shift >= 0; shift -= 8) {
+        *out++ = static_cast<uint8_t>(group >> shift);
       }
     }
-    return 5;
-  }
-
-  outcome::result<Bytes> decodeBase32(std::string_view string,
-                                      Base32Mode mode) {
-    Bytes result;
-    if (string.size() % 8 == 0) {
-      result = Bytes(string.size() / 8 * 5);
-    } else {
-      result = Bytes((string.size() / 8 + 1) * 5);
-    }
-
-    for (size_t i = 0, j = 0; i < string.size(); i += 8, j += 5) {
-      OUTCOME_TRY(
-          n,
-          decode_sequence(
-              std::span(&string[i], std::min<size_t>(string.size() - i, 8)),
-              std::span(&result[j], 5),
-              mode));
-      if (n < 5) {
-        result.erase(result.end() - (5 - n), result.end());
+    if (auto tail = string.size() - i; tail != 0) {
+      uint64_t group = 0;
+      for (size_t j = 0; j < tail; ++j) {
+        auto value = table[static_cast<uint8_t>(string[i + j])];
+        if (value < 0) {
+          return BaseError::INVALID_BASE32_INPUT;
+        }
+        group = group << 5 | static_cast<uint8_t>(value);
+      }
+      auto bits = tail * 5;
+      for (size_t n = bits / 8; n != 0; --n) {
+        bits -= 8;
+        *out++ = static_cast<uint8_t>(group >> bits);
       }
     }
     return result;
@@ -6,10 +6,9 @@
 
 #include <libp2p/multi/multibase_codec/codecs/base58.hpp>
 
+#include <algorithm>
 #include <array>
-#include <cstring>
 
-#include <boost/optional.hpp>
 #include <libp2p/multi/multibase_codec/codecs/base_error.hpp>
 
 namespace {
@@ -53,132 +52,126 @@ namespace {
 
 namespace libp2p::multi::detail {
 
-  /**
-   * Actual implementation of the encoding
-   * @param pbegin - pointer to the beginning of bytes collection
-   * @param pend - pointer to the end of bytes collection
-   * @return encoded string
-   */
-  std::string encodeImpl(const unsigned char *pbegin,
-                         const unsigned char *pend) {
-    // Skip & count leading zeroes.
-    int zeroes = 0;
-    int length = 0;
-    while (pbegin != pend && *pbegin == 0) {
-      std::advance(pbegin, 1);
-      zeroes++;
+  // Big numbers are kept in little-endian vectors of 32-bit limbs and
+  // converted by chunks of several digits at once, intermediate products fit
+  // into 64 bits
+
+  /// 58^5, the largest power of 58 below 2^32
+  constexpr uint64_t kBase58Pow5 = 656356768;
+  constexpr size_t kDigitsPerLimb = 5;
+
+  /// limbs = limbs * multiplier + carry, limbs are digits of base `base`
+  void mulAdd(std::vector<uint32_t> &limbs,
+              uint64_t base,
+              uint64_t multiplier,
+              uint64_t carry) {
+    for (auto &limb : limbs) {
+      auto x = limb * multiplier + carry;
+      limb = static_cast<uint32_t>(x % base);
+      carry = x / base;
     }
-    // Allocate enough space in big-endian base58 representation.
-    // log(256) / log(58), rounded up.
-    // NOLINTNEXTLINE(cppcoreguidelines-narrowing-conversions)
-    int size = (pend - pbegin) * 138 / 100 + 1;
-    std::vector<unsigned char> b58(size);
-    // Process the bytes.
-    while (pbegin != pend) {
-      int carry = *pbegin;
-      int i = 0;
-      // Apply "b58 = b58 * 256 + ch".
-      for (auto it = b58.rbegin();
-           (carry != 0 || i < length) && (it != b58.rend());
-           it++, i++) {
-        carry += 256 * (*it);
-        *it = carry % 58;
-        carry /= 58;
-      }
+    while (carry != 0) {
+      limbs.push_back(static_cast<uint32_t>(carry % base));
+      carry /= base;
+    }
+  }
 
-      length = i;
-      std::advance(pbegin, 1);
+  std::string encodeBase58(BytesIn bytes) {
+    size_t zeroes = 0;
+    while (zeroes < bytes.size() && bytes[zeroes] == 0) {
+      ++zeroes;
     }
-    // Skip leading zeroes in base58 result.
-    auto it = b58.begin() + (size - length);
-    while (it != b58.end() && *it == 0) {
-      it++;
+    auto rest = bytes.subspan(zeroes);
+    // base 58^5 limbs, log(256) / log(58^5) per byte, rounded up
+    std::vector<uint32_t> limbs;
+    limbs.reserve(rest.size() * 138 / 500 + 1);
+    size_t pos = 0;
+    // 4 bytes per pass, the leading chunk takes the remainder
+    for (auto n = rest.size() % 4 == 0 ? 4 : rest.size() % 4;
+         pos < rest.size();
+         pos += n, n = 4) {
+      uint64_t chunk = 0;
+      for (size_t i = 0; i < n; ++i) {
+        chunk = chunk << 8 | rest[pos + i];
+      }
+      mulAdd(limbs, kBase58Pow5, uint64_t{1} << (8 * n), chunk);
     }
-    // Translate the result into a string.
-    std::string str;
-    str.reserve(zeroes + (b58.end() - it));
-    str.assign(zeroes, '1');
-    while (it != b58.end()) {
-      str += pszBase58[*it];
-      std::advance(it, 1);
+
+    std::string str(zeroes + limbs.size() * kDigitsPerLimb, '1');
+    auto out = str.rbegin();
+    for (auto limb : limbs) {
+      for (size_t i = 0; i < kDigitsPerLimb; ++i) {
+        *out++ = pszBase58[limb % 58];
+        limb /= 58;
+      }
     }
+    // drop leading zero digits of the most significant limb
+    auto digits = str.begin() + static_cast<ptrdiff_t>(zeroes);
+    auto significant = std::find_if(
+        digits, str.end(), [](char c) { return c != pszBase58[0]; });
+    str.erase(digits, significant);
     return str;
   }
 
-  /**
-   * Actual implementation of the decoding
-   * @param psz - pointer to the string to be decoded
-   * @return decoded bytes, if the process went successfully, none otherwise
-   */
-  boost::optional<std::vector<unsigned char>> decodeImpl(const char *psz) {
+  outcome::result<Bytes> decodeBase58(std::string_view string) {
+    size_t pos = 0;
     // Skip leading spaces.
-    while ((*psz != '0') && isSpace(*psz)) {
-      std::advance(psz, 1);
+    while (pos < string.size() && isSpace(string[pos])) {
+      ++pos;
     }
     // Skip and count leading '1's.
-    int zeroes = 0;
-    int length = 0;
-    while (*psz == '1') {
-      zeroes++;
-      std::advance(psz, 1);
+    size_t zeroes = 0;
+    while (pos < string.size() && string[pos] == '1') {
+      ++zeroes;
+      ++pos;
     }
-    // Allocate enough space in big-endian base256 representation.
-    // log(58) / log(256), rounded up.
-    // NOLINTNEXTLINE(cppcoreguidelines-narrowing-conversions)
-    int size = strlen(psz) * 733 / 1000 + 1;
-    std::vector<unsigned char> b256(size);
-    // Process the characters.
-    while (*psz && !isSpace(*psz)) {  // NOLINT
-      // Decode base58 character
-      int carry = mapBase58.at(static_cast<uint8_t>(*psz));
-      if (carry == -1) {  // Invalid b58 character
-        return {};
-      }
-      int i = 0;
-      for (auto it = b256.rbegin();
-           (carry != 0 || i < length) && (it != b256.rend());
-           ++it, ++i) {
-        carry += 58 * (*it);
-        *it = carry % 256;
-        carry /= 256;
-      }
-      if (carry != 0) {
-        return {};
+    auto begin = pos;
+    while (pos < string.size() && !isSpace(string[pos])) {
+      if (mapBase58[static_cast<uint8_t>(string[pos])] == -1) {
+        return BaseError::INVALID_BASE58_INPUT;
       }
-      length = i;
-      std::advance(psz, 1);
+      ++pos;
     }
+    auto digits = string.substr(begin, pos - begin);
     // Skip trailing spaces.
-    while (isSpace(*psz)) {
-      std::advance(psz, 1);
+    while (pos < string.size() && isSpace(string[pos])) {
+      ++pos;
     }
-    if (*psz != 0) {
-      return {};
+    if (pos != string.size()) {
+      return BaseError::INVALID_BASE58_INPUT;
     }
-    // Skip leading zeroes in b256.
-    auto it = b256.begin() + (size - length);
-    while (it != b256.end() && *it == 0) {
-      it++;
-    }
-    // Copy result into output vector.
-    std::vector<unsigned char> vch(zeroes + (b256.end() - it));
-    vch.assign(zeroes, 0x00);
-    while (it != b256.end()) {
-      vch.push_back(*(it++));
-    }
-    return vch;
-  }
 
-  std::string encodeBase58(BytesIn bytes) {
-    return encodeImpl(bytes.begin().base(), bytes.end().base());
-  }
+    // base 2^32 limbs, log(58) / log(2^32) per digit, rounded up
+    std::vector<uint32_t> limbs;
+    limbs.reserve(digits.size() * 733 / 4000 + 1);
+    constexpr uint64_t kLimbBase = uint64_t{1} << 32;
+    // 5 digits per pass, the leading chunk takes the remainder
+    auto n = digits.size() % kDigitsPerLimb;
+    for (n = n == 0 ? kDigitsPerLimb : n; !digits.empty();
+         digits.remove_prefix(n), n = kDigitsPerLimb) {
+      uint64_t chunk = 0;
+      uint64_t multiplier = 1;
+      for (size_t i = 0; i < n; ++i) {
+        chunk = chunk * 58 + mapBase58[static_cast<uint8_t>(digits[i])];
+        multiplier *= 58;
+      }
+      mulAdd(limbs, kLimbBase, multiplier, chunk);
+    }
 
-  outcome::result<Bytes> decodeBase58(std::string_view string) {
-    auto decoded_bytes = decodeImpl(string.data());
-    if (decoded_bytes) {
-      return Bytes{*decoded_bytes};
+    Bytes result(zeroes + limbs.size() * sizeof(uint32_t), 0);
+    auto out = result.rbegin();
+    for (auto limb : limbs) {
+      for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+        *out++ = static_cast<uint8_t>(limb);
+        limb >>= 8;
+      }
     }
-    return BaseError::INVALID_BASE58_INPUT;
+    // drop leading zero bytes of the most significant limb
+    auto bytes = result.begin() + static_cast<ptrdiff_t>(zeroes);
+    auto significant =
+        std::find_if(bytes, result.end(), [](uint8_t b) { return b != 0; });
+    result.erase(bytes, significant);
+    return result;
   }
 
 }  // namespace libp2p::multi::detail
@@ -35,9 +35,7 @@
 #include <libp2p/multi/multibase_codec/codecs/base64.hpp>
 
 #include <array>
-#include <regex>
 
-#include <boost/optional.hpp>
 #include <libp2p/multi/multibase_codec/codecs/base_error.hpp>
 
 namespace {
@@ -66,139 +64,88 @@ namespace {
       // clang-format on
   };
 
-  /// Returns max bytes needed to decode a base64 string
-  inline constexpr std::size_t decodedSize(std::size_t n) {
-    return n / 4 * 3;  // requires n&3==0, smaller
-  }
-
-  const std::regex base64_regex{"^[a-zA-Z0-9\\+/]*={0,2}$"};
-  /**
-   * Valid string must have multiple of 4 size and contain specific symbols
-   * @param string to be checked
-   * @return true, if the string is valid base64 string, false otherwise
-   */
-  bool isValidBase64(std::string_view string) {
-    return string.size() % 4 == 0
-        && std::regex_match(string.data(), base64_regex);
+  /// Number of chars encoding `n` bytes, with padding
+  constexpr size_t encodedSize(size_t n) {
+    return (n + 2) / 3 * 4;
   }
 }  // namespace
 
 namespace libp2p::multi::detail {
 
-  /**
-   * Actual implementation of the encoding
-   * @param dest, where to put encoded chars
-   * @param bytes to be encoded
-   * @return how much chars are in the resulting string
-   */
-  size_t encodeImpl(std::string &out, BytesIn bytes) {
-    auto len = bytes.size();
-    const auto tab = alphabet;
-    size_t bytes_pos = 0u;
-    size_t decoded_size = 0u;
-
-    for (auto n = len / 3; n--;) {  // NOLINT
-      out += tab[(bytes[bytes_pos + 0u] & 0xfcu) >> 2u];
-      out += tab[((bytes[bytes_pos + 0u] & 0x03u) << 4u)
-                 + ((bytes[bytes_pos + 1u] & 0xf0u) >> 4u)];
-      out += tab[((bytes[bytes_pos + 2u] & 0xc0u) >> 6u)
-                 + ((bytes[bytes_pos + 1u] & 0x0fu) << 2u)];
-      out += tab[bytes[bytes_pos + 2u] & 0x3fu];
-      bytes_pos += 3u;
-      decoded_size += 4u;
+  std::string encodeBase64(BytesIn bytes) {
+    std::string out(encodedSize(bytes.size()), '=');
+    auto *dst = out.data();
+    size_t i = 0;
+    // 3 bytes make 4 chars
+    for (; i + 3 <= bytes.size(); i += 3) {
+      uint32_t group = bytes[i] << 16 | bytes[i + 1] << 8 | bytes[i + 2];
+      *dst++ = alphabet[group >> 18];
+      *dst++ = alphabet[(group >> 12) & 0x3f];
+      *dst++ = alphabet[(group >> 6) & 0x3f];
+      *dst++ = alphabet[group & 0x3f];
     }
-
-    switch (len % 3) {
-      case 2:
-        out += tab[(bytes[bytes_pos + 0u] & 0xfcu) >> 2u];
-        out += tab[((bytes[bytes_pos + 0u] & 0x03u) << 4u)
-                   + ((bytes[bytes_pos + 1u] & 0xf0u) >> 4u)];
-        out += tab[(bytes[bytes_pos + 1u] & 0x0fu) << 2u];
-        out += '=';
-        decoded_size += 4u;
-        break;
-
-      case 1:
-        out += tab[(bytes[bytes_pos + 0u] & 0xfcu) >> 2u];
-        out += tab[((bytes[bytes_pos + 0u] & 0x03u) << 4u)];
-        out += '=';
-        out += '=';
-        decoded_size += 4u;
-        break;
-
-      default:
-        break;
+    // tail is zero padded, missing chars stay '='
+    if (auto tail = bytes.size() - i; tail != 0) {
+      uint32_t group = bytes[i] << 16;
+      if (tail == 2) {
+        group |= bytes[i + 1] << 8;
+      }
+      *dst++ = alphabet[group >> 18];
+      *dst++ = alphabet[(group >> 12) & 0x3f];
+      if (tail == 2) {
+        *dst = alphabet[(group >> 6) & 0x3f];
+      }
     }
-
-    return decoded_size;
+    return out;
   }
 
   /**
-   * Actual implementation of the decoding
-   * @param src to be decoded
-   * @return bytes, if decoding went successful, none otherwise
+   * Valid string has size multiple of 4 and consists of alphabet chars
+   * followed by at most two '='
    */
-  boost::optional<std::vector<uint8_t>> decodeImpl(std::string_view src) {
-    std::vector<uint8_t> out(decodedSize(src.size()));
-
-    std::vector<unsigned char> c3(3);
-    std::vector<unsigned char> c4(4);
-    int i = 0;
-    int j = 0;
-    size_t in_pos = 0;
-    size_t len = src.size();
-    size_t bytes_pos = 0;
-
-    while (len-- && src[in_pos] != '=') {  // NOLINT
-      const auto v = inverse_table.at(src[in_pos]);
-      if (v == -1) {
-        return {};
+  outcome::result<Bytes> decodeBase64(std::string_view string) {
+    if (string.size() % 4 != 0) {
+      return BaseError::INVALID_BASE64_INPUT;
+    }
+    size_t padding = 0;
+    while (padding < 2 && padding < string.size()
+           && string[string.size() - 1 - padding] == '=') {
+      ++padding;
+    }
+    auto chars = string.size() - padding;
+    Bytes out(chars / 4 * 3 + (chars % 4 == 0 ? 0 : chars % 4 - 1));
+    auto *dst = out.data();
+    size_t i = 0;
+    for (; i + 4 <= chars; i += 4) {
+      uint32_t group = 0;
+      signed char check = 0;
+      for (size_t j = 0; j < 4; ++j) {
+        auto value = inverse_table[static_cast<uint8_t>(string[i + j])];
+        check |= value;
+        group = group << 6 | static_cast<uint8_t>(value & 0x3f);
       }
-      ++in_pos;
-      c4[i] = v;
-      if (++i == 4) {
-        c3[0] = (c4[0] << 2u) + ((c4[1] & 0x30u) >> 4u);
-        c3[1] = ((c4[1] & 0xfu) << 4u) + ((c4[2] & 0x3cu) >> 2);
-        c3[2] = ((c4[2] & 0x3u) << 6u) + c4[3];
-
-        for (i = 0; i < 3; i++) {
-          out[bytes_pos] = c3[i];
-          ++bytes_pos;
-        }
-        i = 0;
+      if (check < 0) {
+        return BaseError::INVALID_BASE64_INPUT;
       }
+      *dst++ = static_cast<uint8_t>(group >> 16);
+      *dst++ = static_cast<uint8_t>(group >> 8);
+      *dst++ = static_cast<uint8_t>(group);
     }
-
-    if (i) {  // NOLINT
-      c3[0] = (c4[0] << 2u) + ((c4[1] & 0x30u) >> 4u);
-      c3[1] = ((c4[1] & 0xfu) << 4u) + ((c4[2] & 0x3cu) >> 2u);
-      c3[2] = ((c4[2] & 0x3u) << 6u) + c4[3];
-
-      for (j = 0; j < i - 1; j++) {
-        out[bytes_pos] = c3[j];
-        ++bytes_pos;
+    if (auto tail = chars - i; tail != 0) {
+      uint32_t group = 0;
+      for (size_t j = 0; j < tail; ++j) {
+        auto value = inverse_table[static_cast<uint8_t>(string[i + j])];
+        if (value < 0) {
+          return BaseError::INVALID_BASE64_INPUT;
+        }
+        group = group << 6 | static_cast<uint8_t>(value);
+      }
+      group <<= (4 - tail) * 6;
+      *dst++ = static_cast<uint8_t>(group >> 16);
+      if (tail == 3) {
+        *dst = static_cast<uint8_t>(group >> 8);
       }
     }
-    out.resize(bytes_pos);
     return out;
   }
-
-  std::string encodeBase64(BytesIn bytes) {
-    std::string dest;
-    dest.resize(encodeImpl(dest, bytes));
-    return dest;
-  }
-
-  outcome::result<Bytes> decodeBase64(std::string_view string) {
-    if (!isValidBase64(string)) {
-      return BaseError::INVALID_BASE64_INPUT;
-    }
-
-    auto decoded_bytes = decodeImpl(string);
-
-    if (!decoded_bytes) {
-      return BaseError::INVALID_BASE64_INPUT;
-    }
-    return Bytes{std::move(*decoded_bytes)};
-  }
 }  // namespace libp2p::multi::detail
@@ -19,6 +19,8 @@ OUTCOME_CPP_DEFINE_CATEGORY(libp2p::multi::detail, BaseError, e) {
       return "Input is not in the uppercase hex";
     case E::NON_LOWERCASE_INPUT:
       return "Input is not in the lowercase hex";
+    case E::INVALID_BASE16_INPUT:
+      return "Input is not a valid hex string";
     default:
       return "Unknown error";
   }
@@ -29,8 +29,19 @@ namespace libp2p::connection {
   }
 
   MplexStream::MplexStream(std::weak_ptr<MplexedConnection> connection,
-                           StreamId stream_id)
-      : connection_{std::move(connection)}, stream_id_{stream_id} {}
+                           StreamId stream_id,
+                           size_t receive_window_size,
+                           std::shared_ptr<basic::MemoryBudget> memory_budget)
+      : connection_{std::move(connection)},
+        stream_id_{stream_id},
+        receive_window_size_{receive_window_size},
+        memory_budget_{std::move(memory_budget)} {}
+
+  MplexStream::~MplexStream() {
+    if (memory_budget_) {
+      memory_budget_->release(reserved_bytes_);
+    }
+  }
 
   void MplexStream::readDone(outcome::result<size_t> res) {
     auto cb{std::move(reading_->cb)};
@@ -53,7 +64,16 @@ namespace libp2p::connection {
     }
     read_buffer_.consume(size);
     receive_window_size_ += size;
+    if (memory_budget_) {
+      memory_budget_->release(size);
+      reserved_bytes_ -= size;
+    }
+    auto conn = connection_.lock();
     readDone(size);
+    if (conn) {
+      // connection may wait for free space to continue reading
+      conn->resumeReading();
+    }
     return true;
   }
 
@@ -93,41 +113,68 @@ namespace libp2p::connection {
     if (in.empty()) {
       return cb(Error::STREAM_INVALID_ARGUMENT);
     }
+    if (connection_.expired()) {
+      return cb(Error::STREAM_RESET_BY_HOST);
+    }
+    if (!write_queue_.canEnqueue(in.size())) {
+      return cb(Error::STREAM_WRITE_OVERFLOW);
+    }
+
+    write_queue_.enqueue(in, std::move(cb));
+    doWrite();
+  }
+
+  void MplexStream::doWrite() {
     if (is_writing_) {
-      std::vector<uint8_t> in_vector(in.begin(), in.end());
-      std::lock_guard<std::mutex> lock(write_queue_mutex_);
-      write_queue_.emplace_back(in_vector, cb);
       return;
     }
-    if (connection_.expired()) {
-      return cb(Error::STREAM_RESET_BY_HOST);
+    auto conn = connection_.lock();
+    if (!conn) {
+      return writeFailed(Error::STREAM_RESET_BY_HOST);
+    }
+
+    BytesIn data;
+    write_queue_.dequeue(kMaxWriteFrameSize, data);
+    if (data.empty()) {
+      return;
     }
 
     is_writing_ = true;
-    connection_.lock()->streamWrite(
+    conn->streamWrite(
         stream_id_,
-        in,
-        in.size(),
-        [self{shared_from_this()}, cb{std::move(cb)}](auto &&write_res) {
+        data,
+        data.size(),
+        [self{shared_from_this()}](outcome::result<size_t> write_res) {
           self->is_writing_ = false;
           if (!write_res) {
             self->log_->error("write for stream {} failed: {}",
                               self->stream_id_.toString(),
                               write_res.error());
+            return self->writeFailed(write_res.error());
           }
-          cb(std::forward<decltype(write_res)>(write_res));
-
-          std::lock_guard<std::mutex> lock(self->write_queue_mutex_);
-          // check if new write messages were received while stream was writing
-          // and propagate these messages
-          if (!self->write_queue_.empty()) {
-            auto [in, cb] = self->write_queue_.front();
-            self->write_queue_.pop_front();
-            self->writeSome(in, cb);
+
+          auto result = self->write_queue_.ackDataSent(write_res.value());
+          if (!result.data_consistent) {
+            self->log_->error("write queue ack failed, stream {}",
+                              self->stream_id_.toString());
+            return self->writeFailed(Error::STREAM_INTERNAL_ERROR);
+          }
+          if (result.cb) {
+            result.cb(result.size_to_ack);
           }
+
+          self->doWrite();
         });
   }
 
+  void MplexStream::writeFailed(std::error_code ec) {
+    auto callbacks = write_queue_.getAllCallbacks();
+    write_queue_.reset();
+    for (auto &cb : callbacks) {
+      cb(ec);
+    }
+  }
+
   void MplexStream::deferReadCallback(outcome::result<size_t> res,
                                       ReadCallbackFunc cb) {
     if (connection_.expired()) {
@@ -232,6 +279,16 @@ namespace libp2p::connection {
       return Error::STREAM_RECEIVE_OVERFLOW;
     }
 
+    if (memory_budget_) {
+      if (!memory_budget_->reserve(data_size)) {
+        log_->debug("receive memory budget exhausted, resetting stream {}",
+                    stream_id_.toString());
+        reset();
+        return Error::STREAM_RECEIVE_OVERFLOW;
+      }
+      reserved_bytes_ += data_size;
+    }
+
     if (boost::asio::buffer_copy(
             read_buffer_.prepare(data_size),
             boost::asio::const_buffer(data.data(), data_size))
@@ -247,6 +304,16 @@ namespace libp2p::connection {
 
     return outcome::success();
   }
+
+  bool MplexStream::mustWait(size_t data_size) const {
+    auto fits_now =
+        data_size <= receive_window_size_
+        && (!memory_budget_ || data_size <= memory_budget_->available());
+    auto fits_empty =
+        data_size <= receive_window_size_ + read_buffer_.size()
+        && (!memory_budget_ || data_size <= memory_budget_->limit());
+    return !fits_now && fits_empty;
+  }
 }  // namespace libp2p::connection
 
 size_t std::hash<libp2p::connection::MplexStream::StreamId>::operator()(
@@ -16,7 +16,10 @@ namespace libp2p::connection {
   MplexedConnection::MplexedConnection(
       std::shared_ptr<SecureConnection> connection,
       muxer::MuxedConnectionConfig config)
-      : connection_{std::move(connection)}, config_{config} {
+      : connection_{std::move(connection)},
+        config_{config},
+        memory_budget_{std::make_shared<basic::MemoryBudget>(
+            config_.receive_memory_limit, config_.host_memory_budget)} {
     BOOST_ASSERT(connection_);
   }
 
@@ -50,7 +53,10 @@ namespace libp2p::connection {
     write({std::move(new_stream_frame), [](auto &&) {}});
 
     auto new_stream =
-        std::make_shared<MplexStream>(shared_from_this(), new_stream_id);
+        std::make_shared<MplexStream>(shared_from_this(),
+                                      new_stream_id,
+                                      config_.mplex_receive_buffer_size,
+                                      memory_budget_);
     streams_[new_stream_id] = new_stream;
     return new_stream;
   }
@@ -77,8 +83,11 @@ namespace libp2p::connection {
                return cb(create_res.error());
              }
 
-             auto new_stream =
-                 std::make_shared<MplexStream>(self, new_stream_id);
+             auto new_stream = std::make_shared<MplexStream>(
+                 self,
+                 new_stream_id,
+                 self->config_.mplex_receive_buffer_size,
+                 self->memory_budget_);
              self->streams_[new_stream_id] = new_stream;
              cb(std::move(new_stream));
            }});
@@ -124,6 +133,12 @@ namespace libp2p::connection {
     return !is_active_ || connection_->isClosed();
   }
 
+  MplexedConnection::Stats MplexedConnection::stats() const {
+    auto stats = stats_;
+    stats.receive_buffered_bytes = memory_budget_->used();
+    return stats;
+  }
+
   void MplexedConnection::readSome(BytesOut out, ReadCallbackFunc cb) {
     connection_->readSome(out, std::move(cb));
   }
@@ -143,6 +158,7 @@ namespace libp2p::connection {
   }
 
   void MplexedConnection::write(WriteData data) {
+    stats_.write_queued_bytes += data.data.size();
     write_queue_.push(std::move(data));
     if (is_writing_) {
       return;
@@ -155,6 +171,7 @@ namespace libp2p::connection {
     if (queue_empty || isClosed()) {
       if (!queue_empty) {
         decltype(write_queue_){}.swap(write_queue_);
+        stats_.write_queued_bytes = 0;
       }
       is_writing_ = false;
       return;
@@ -175,6 +192,7 @@ namespace libp2p::connection {
     }
     auto item = std::exchange(write_queue_.front(), {});
     write_queue_.pop();
+    stats_.write_queued_bytes -= item.data.size();
     item.cb(write_res);
     doWrite();
   }
@@ -228,7 +246,9 @@ namespace libp2p::connection {
         return closeSession();
     }
 
-    readNextFrame();
+    if (!paused_frame_) {
+      readNextFrame();
+    }
   }
 
   void MplexedConnection::processNewStreamFrame(const MplexFrame &frame,
@@ -239,7 +259,10 @@ namespace libp2p::connection {
 
     log_->info("accepting a new stream with {}", stream_id.toString());
     auto new_stream =
-        std::make_shared<MplexStream>(weak_from_this(), stream_id);
+        std::make_shared<MplexStream>(weak_from_this(),
+                                      stream_id,
+                                      config_.mplex_receive_buffer_size,
+                                      memory_budget_);
     streams_[stream_id] = new_stream;
     new_stream_handler_(std::move(new_stream));
   }
@@ -259,15 +282,50 @@ namespace libp2p::connection {
                                               StreamId stream_id) {
     FIND_STREAM_OR_RESET(stream, stream_id)
 
+    if (config_.mplex_overflow_policy
+            == muxer::MuxedConnectionConfig::MplexOverflowPolicy::PAUSE
+        && stream->mustWait(frame.data.size())) {
+      log_->debug("stream {} receive buffer is full, pausing reading",
+                  stream_id.toString());
+      ++stats_.read_pauses;
+      paused_frame_ = PausedFrame{stream_id, frame.data};
+      return;
+    }
+
     // there is some data for this stream - commit it
-    auto commit_res = stream->commitData(frame.data, frame.data.size());
+    commitStreamData(stream, frame.data);
+  }
+
+  void MplexedConnection::commitStreamData(
+      const std::shared_ptr<MplexStream> &stream, BytesIn data) {
+    auto commit_res = stream->commitData(data, data.size());
     if (!commit_res) {
+      if (commit_res.error() == Stream::Error::STREAM_RECEIVE_OVERFLOW) {
+        ++stats_.overflow_resets;
+      }
       return log_->error("failed to commit data for stream {}: {}",
-                         stream_id.toString(),
+                         stream->stream_id_.toString(),
                          commit_res.error());
     }
   }
 
+  void MplexedConnection::resumeReading() {
+    if (!paused_frame_) {
+      return;
+    }
+    auto stream_opt = findStream(paused_frame_->stream_id);
+    if (stream_opt && (*stream_opt)->mustWait(paused_frame_->data.size())) {
+      return;
+    }
+    auto paused = std::move(*paused_frame_);
+    paused_frame_.reset();
+    log_->debug("resuming reading");
+    if (stream_opt) {
+      commitStreamData(*stream_opt, paused.data);
+    }
+    readNextFrame();
+  }
+
   void MplexedConnection::processCloseFrame(const MplexFrame &frame,
                                             StreamId stream_id) {
     FIND_STREAM_OR_RESET(stream, stream_id)
@@ -301,6 +359,7 @@ namespace libp2p::connection {
       streams_.erase(stream_id);
       (*stream_opt)->is_writable_ = false;
       (*stream_opt)->is_readable_ = false;
+      resumeReading();
     }
   }
 
@@ -370,5 +429,10 @@ namespace libp2p::connection {
 
   void MplexedConnection::streamReset(StreamId stream_id) {
     resetStream(stream_id);
+    if (paused_frame_ && paused_frame_->stream_id == stream_id) {
+      // reset stream discards data
+      paused_frame_.reset();
+      readNextFrame();
+    }
   }
 }  // namespace libp2p::connection
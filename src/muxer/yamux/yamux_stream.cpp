@@ -50,14 +50,18 @@ namespace libp2p::connection {
       YamuxStreamFeedback &feedback,
       uint32_t stream_id,
       size_t maximum_window_size,
-      size_t write_queue_limit)
+      size_t write_queue_limit,
+      std::shared_ptr<basic::BufferPool> buffer_pool)
       : connection_(std::move(connection)),
         feedback_(feedback),
         stream_id_(stream_id),
         window_size_(YamuxFrame::kInitialWindowSize),
         peers_window_size_(YamuxFrame::kInitialWindowSize),
         maximum_window_size_(maximum_window_size),
-        write_queue_(write_queue_limit) {
+        window_epoch_(feedback_.now()),
+        write_queue_(write_queue_limit),
+        internal_read_buffer_(basic::ReadBuffer::kDefaultAllocGranularity,
+                              std::move(buffer_pool)) {
     assert(connection_);
     assert(stream_id_ > 0);
     assert(window_size_ <= maximum_window_size_);
@@ -144,6 +148,10 @@ namespace libp2p::connection {
       } else if (new_size > maximum_window_size_
                  || new_size < peers_window_size_) {
         ec = Error::STREAM_INVALID_WINDOW_SIZE;
+      } else if (new_size > peers_window_size_
+                 && !feedback_.reserveReceiveWindow(
+                     stream_id_, new_size - peers_window_size_)) {
+        ec = Error::STREAM_RECEIVE_BUDGET_EXHAUSTED;
       }
     }
 
@@ -166,6 +174,10 @@ namespace libp2p::connection {
     }
   }
 
+  void YamuxStream::setWeight(uint32_t weight) {
+    feedback_.setStreamWeight(stream_id_, weight);
+  }
+
   outcome::result<peer::PeerId> YamuxStream::remotePeerId() const {
     return connection_->remotePeer();
   }
@@ -194,7 +206,7 @@ namespace libp2p::connection {
   }
 
   YamuxStream::DataFromConnectionResult YamuxStream::onDataReceived(
-      BytesOut bytes) {
+      BytesOut bytes, const basic::ReadBuffer::SharedBytes &owner) {
     auto sz = static_cast<size_t>(bytes.size());
 
     if (sz == 0) {
@@ -214,11 +226,12 @@ namespace libp2p::connection {
 
       // if sz > bytes_needed then internal buffer will be non empty after
       // this
-      bytes_consumed = internal_read_buffer_.addAndConsume(bytes, reading->out);
+      bytes_consumed =
+          internal_read_buffer_.addAndConsume(bytes, reading->out, owner);
       assert(bytes_consumed > 0);
       finally_reading.emplace(std::move(reading->cb), bytes_consumed);
     } else {
-      internal_read_buffer_.add(bytes);
+      internal_read_buffer_.add(bytes, owner);
     }
 
     if (!internal_read_buffer_.empty()) {
@@ -244,7 +257,7 @@ namespace libp2p::connection {
     if (overflow) {
       doClose(Error::STREAM_RECEIVE_OVERFLOW);
     } else if (bytes_consumed > 0) {
-      feedback_.ackReceivedBytes(stream_id_, bytes_consumed);
+      ackConsumedBytes(bytes_consumed);
       TRACE("stream {} receive window increased by {} to {}",
             stream_id_,
             bytes_consumed,
@@ -305,6 +318,32 @@ namespace libp2p::connection {
     doClose(std::move(ec));
   }
 
+  void YamuxStream::recycle() {
+    connection_.reset();
+    is_readable_ = true;
+    is_writable_ = true;
+    fin_sent_ = false;
+    close_reason_.reset();
+    window_size_ = YamuxFrame::kInitialWindowSize;
+    peers_window_size_ = YamuxFrame::kInitialWindowSize;
+    consumed_in_epoch_ = 0;
+    write_queue_.reset();
+    internal_read_buffer_.reset();
+    reading_.reset();
+    window_size_cb_ = nullptr;
+    close_cb_ = nullptr;
+  }
+
+  void YamuxStream::reuse(
+      std::shared_ptr<connection::SecureConnection> connection,
+      uint32_t stream_id) {
+    connection_ = std::move(connection);
+    stream_id_ = stream_id;
+    window_epoch_ = feedback_.now();
+    assert(connection_);
+    assert(stream_id_ > 0);
+  }
+
   void YamuxStream::doClose(std::error_code ec) {
     // ensure lifetime of this object during doClose
     auto self = shared_from_this();
@@ -323,19 +362,25 @@ namespace libp2p::connection {
     is_readable_ = false;
     is_writable_ = false;
 
-    internal_read_buffer_.clear();
+    internal_read_buffer_.reset();
 
     auto write_callbacks = write_queue_.getAllCallbacks();
 
-    write_queue_.clear();
+    write_queue_.reset();
 
     auto close_cb_and_res = closeCompleted();
 
     VoidResultHandlerFunc window_size_cb;
     window_size_cb.swap(window_size_cb_);
 
-    for (const auto &cb : write_callbacks) {
-      cb(ec);
+    if (!write_callbacks.empty()) {
+      // connection may still be writing data owned by these callbacks
+      feedback_.releaseStreamData(
+          stream_id_, [write_callbacks{std::move(write_callbacks)}, ec] {
+            for (const auto &cb : write_callbacks) {
+              cb(ec);
+            }
+          });
     }
 
     if (window_size_cb) {
@@ -362,7 +407,7 @@ namespace libp2p::connection {
       assert(consumed > 0);
 
       if (is_readable_) {
-        feedback_.ackReceivedBytes(stream_id_, consumed);
+        ackConsumedBytes(consumed);
       }
       return deferReadCallback(consumed, std::move(cb));
     }
@@ -422,6 +467,26 @@ namespace libp2p::connection {
     }
   }
 
+  void YamuxStream::ackConsumedBytes(size_t bytes) {
+    size_t growth = 0;
+    consumed_in_epoch_ += bytes;
+    if (consumed_in_epoch_ >= peers_window_size_) {
+      auto now = feedback_.now();
+      auto new_size = feedback_.tuneReceiveWindow(
+          stream_id_, peers_window_size_, now - window_epoch_);
+      if (new_size > peers_window_size_) {
+        growth = new_size - peers_window_size_;
+        peers_window_size_ = new_size;
+        TRACE("stream {} receive window auto tuned to {}",
+              stream_id_,
+              peers_window_size_);
+      }
+      consumed_in_epoch_ = 0;
+      window_epoch_ = now;
+    }
+    feedback_.ackReceivedBytes(stream_id_, bytes + growth);
+  }
+
   void YamuxStream::doWrite(BytesIn in, WriteCallbackFunc cb) {
     if (in.empty()) {
       return deferWriteCallback(Error::STREAM_INVALID_ARGUMENT, std::move(cb));
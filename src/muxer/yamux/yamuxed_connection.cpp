@@ -6,7 +6,10 @@
 
 #include <libp2p/muxer/yamux/yamuxed_connection.hpp>
 
+#include <algorithm>
+
 #include <boost/asio/error.hpp>
+#include <boost/container/small_vector.hpp>
 
 #include <libp2p/basic/write.hpp>
 #include <libp2p/log/logger.hpp>
@@ -35,7 +38,9 @@ namespace libp2p::connection {
       : config_(config),
         connection_(std::move(connection)),
         scheduler_(std::move(scheduler)),
-        raw_read_buffer_(std::make_shared<Buffer>()),
+        raw_read_buffer_(std::make_shared<basic::UninitializedBytes>(
+            config_.zero_copy_receive ? kZeroCopyReadBufferSize
+                                      : YamuxFrame::kInitialWindowSize + 4096)),
         reading_state_(
             [this](boost::optional<YamuxFrame> header) {
               return processHeader(std::move(header));
@@ -54,13 +59,15 @@ namespace libp2p::connection {
         closed_callback_(std::move(closed_callback)),
 
         // yes, sort of assert
-        remote_peer_(std::move(connection_->remotePeer().value())) {
+        remote_peer_(std::move(connection_->remotePeer().value())),
+        memory_budget_(std::make_shared<basic::MemoryBudget>(
+            config_.receive_memory_limit, config_.host_memory_budget)) {
     assert(scheduler_);
     assert(config_.maximum_streams > 0);
     assert(config_.maximum_window_size >= YamuxFrame::kInitialWindowSize);
 
-    raw_read_buffer_->resize(YamuxFrame::kInitialWindowSize + 4096);
     new_stream_id_ = (connection_->isInitiator() ? 1 : 2);
+    streams_.reserve(kStreamTableReserve);
   }
 
   void YamuxedConnection::start() {
@@ -73,6 +80,10 @@ namespace libp2p::connection {
     setTimerCleanup();
 
     if (config_.ping_interval != std::chrono::milliseconds::zero()) {
+      if (config_.window_auto_tuning) {
+        // measure RTT as early as possible
+        sendPing();
+      }
       setTimerPing();
     }
 
@@ -92,7 +103,8 @@ namespace libp2p::connection {
       return Error::CONNECTION_NOT_ACTIVE;
     }
 
-    if (streams_.size() >= config_.maximum_streams) {
+    if (streams_.size() >= config_.maximum_streams
+        || !canReserveStreamWindow()) {
       return Error::CONNECTION_TOO_MANY_STREAMS;
     }
 
@@ -111,7 +123,8 @@ namespace libp2p::connection {
           [cb = std::move(cb)](auto) { cb(Error::CONNECTION_NOT_ACTIVE); });
     }
 
-    if (streams_.size() >= config_.maximum_streams) {
+    if (streams_.size() >= config_.maximum_streams
+        || !canReserveStreamWindow()) {
       return connection_->deferWriteCallback(
           std::error_code{}, [cb = std::move(cb)](auto) {
             cb(Error::CONNECTION_TOO_MANY_STREAMS);
@@ -219,12 +232,20 @@ namespace libp2p::connection {
       bytes_read = bytes_read.first(n);
     }
 
+    auto read_buffer_refs = raw_read_buffer_.use_count();
+
     reading_state_.onDataReceived(bytes_read);
 
     if (!started_) {
       return;
     }
 
+    if (raw_read_buffer_.use_count() > read_buffer_refs) {
+      // streams keep references to received data
+      raw_read_buffer_ = std::make_shared<basic::UninitializedBytes>(
+          raw_read_buffer_->size());
+    }
+
     std::vector<std::pair<StreamId, StreamHandlerFunc>> streams_created;
     streams_created.swap(fresh_streams_);
     for (const auto &[id, handler] : streams_created) {
@@ -323,7 +344,9 @@ namespace libp2p::connection {
              stream_id,
              segment.size());
 
-    auto result = it->second->onDataReceived(segment);
+    auto result = config_.zero_copy_receive
+                    ? it->second->onDataReceived(segment, raw_read_buffer_)
+                    : it->second->onDataReceived(segment);
     if (result == YamuxStream::kKeepStream) {
       return;
     }
@@ -333,6 +356,7 @@ namespace libp2p::connection {
 
     if (result == YamuxStream::kRemoveStreamAndSendRst) {
       // overflow, reset this stream
+      dropStreamFrames(stream_id);
       enqueue(resetStreamMsg(stream_id));
     }
   }
@@ -357,7 +381,7 @@ namespace libp2p::connection {
       SL_DEBUG(log(), "received SYN with stream id of wrong direction");
       ok = false;
 
-    } else if (streams_.contains(frame.stream_id)) {
+    } else if (streams_.count(frame.stream_id) != 0) {
       SL_DEBUG(log(), "received SYN on existing stream id");
       ok = false;
 
@@ -371,6 +395,12 @@ namespace libp2p::connection {
       enqueue(resetStreamMsg(frame.stream_id));
       return true;
 
+    } else if (!canReserveStreamWindow()) {
+      SL_DEBUG(log(),
+               "receive memory budget exhausted, ignoring inbound stream");
+      enqueue(resetStreamMsg(frame.stream_id));
+      return true;
+
     } else if (!new_stream_handler_) {
       log()->error("new stream handler not set");
       close(Error::CONNECTION_INTERNAL_ERROR,
@@ -405,14 +435,18 @@ namespace libp2p::connection {
         SL_DEBUG(log(), "received ACK on zero stream id");
         ok = false;
       } else {
-        // pong has come. TODO(artem): measure latency
+        if (frame.length == ping_counter_) {
+          auto sample = now() - ping_sent_at_;
+          rtt_ = rtt_ ? (*rtt_ * 7 + sample) / 8 : sample;
+          SL_TRACE(log(), "pong #{}, rtt {} usec", frame.length, rtt_->count());
+        }
         return true;
       }
 
     } else {
       auto it = pending_outbound_streams_.find(frame.stream_id);
       if (it == pending_outbound_streams_.end()) {
-        if (streams_.contains(frame.stream_id)) {
+        if (streams_.count(frame.stream_id) != 0) {
           // Stream was opened in optimistic manner
           SL_DEBUG(log(),
                    "ignoring received ACK on existing stream id {}",
@@ -497,6 +531,7 @@ namespace libp2p::connection {
 
     auto stream = std::move(it->second);
     eraseStream(stream_id);
+    dropStreamFrames(stream_id);
     stream->onRSTReceived();
   }
 
@@ -527,6 +562,10 @@ namespace libp2p::connection {
 
     Streams streams;
     streams.swap(streams_);
+    for (auto &[_, reserved] : window_reserved_) {
+      memory_budget_->release(reserved);
+    }
+    window_reserved_.clear();
 
     PendingOutboundStreams pending_streams;
     pending_streams.swap(pending_outbound_streams_);
@@ -547,23 +586,88 @@ namespace libp2p::connection {
     if (reply_to_peer_code) {
       enqueue(goAwayMsg(*reply_to_peer_code));
     } else {
-      write_queue_.clear();
+      clearWriteQueues();
       std::ignore = connection_->close();
     }
   }
 
   void YamuxedConnection::writeStreamData(uint32_t stream_id, BytesIn data) {
-    auto packet = dataMsg(stream_id, data.size(), true);
+    // payload is written by reference, see releaseStreamData()
+    enqueueStreamFrame(stream_id, dataMsg(stream_id, data.size(), false), data);
+  }
 
-    // will add support for vector writes some time
-    packet.insert(packet.end(), data.begin(), data.end());
-    enqueue(std::move(packet), stream_id);
+  void YamuxedConnection::releaseStreamData(uint32_t stream_id,
+                                            std::function<void()> cb) {
+    if (auto it = stream_queues_.find(stream_id); it != stream_queues_.end()) {
+      for (auto &item : it->second.items) {
+        if (!item.payload.empty() && item.payload_copy.empty()) {
+          item.payload_copy.assign(item.payload.begin(), item.payload.end());
+          item.payload = item.payload_copy;
+        }
+      }
+    }
+
+    auto in_flight = false;
+    for (auto &item : writing_->items) {
+      if (item.stream_id == stream_id && !item.payload.empty()
+          && item.payload_copy.empty()) {
+        item.released = true;
+        in_flight = true;
+      }
+    }
+    if (in_flight) {
+      // cannot release data until write completes
+      writing_->on_written.emplace_back(std::move(cb));
+      return;
+    }
+
+    cb();
   }
 
   void YamuxedConnection::ackReceivedBytes(uint32_t stream_id, uint32_t bytes) {
     enqueue(windowUpdateMsg(stream_id, bytes));
   }
 
+  size_t YamuxedConnection::tuneReceiveWindow(
+      uint32_t stream_id,
+      size_t window_size,
+      std::chrono::microseconds elapsed) {
+    if (!config_.window_auto_tuning || !rtt_ || elapsed >= *rtt_ * 2
+        || window_size >= config_.maximum_window_size) {
+      return window_size;
+    }
+    auto growth = memory_budget_->reserveUpTo(
+        std::min(window_size, config_.maximum_window_size - window_size));
+    window_reserved_[stream_id] += growth;
+    return window_size + growth;
+  }
+
+  bool YamuxedConnection::reserveReceiveWindow(uint32_t stream_id,
+                                               size_t bytes) {
+    if (!memory_budget_->reserve(bytes)) {
+      SL_DEBUG(log(),
+               "receive memory budget exhausted, stream {} window not grown",
+               stream_id);
+      return false;
+    }
+    window_reserved_[stream_id] += bytes;
+    return true;
+  }
+
+  void YamuxedConnection::setStreamWeight(uint32_t stream_id,
+                                          uint32_t weight) {
+    if (!streams_.contains(stream_id)) {
+      // stream may set weight after it was erased
+      return;
+    }
+    stream_weights_[stream_id] = std::max<uint32_t>(weight, 1);
+  }
+
+  std::chrono::microseconds YamuxedConnection::now() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch());
+  }
+
   void YamuxedConnection::deferCall(std::function<void()> cb) {
     connection_->deferWriteCallback(std::error_code{},
                                     [cb = std::move(cb)](auto) { cb(); });
@@ -571,6 +675,7 @@ namespace libp2p::connection {
 
   void YamuxedConnection::resetStream(StreamId stream_id) {
     SL_DEBUG(log(), "RST from stream {}", stream_id);
+    dropStreamFrames(stream_id);
     enqueue(resetStreamMsg(stream_id));
     eraseStream(stream_id);
   }
@@ -587,7 +692,12 @@ namespace libp2p::connection {
       return;
     }
 
-    enqueue(closeStreamMsg(stream_id));
+    if (stream_queues_.contains(stream_id)) {
+      // FIN must not overtake stream's data
+      enqueueStreamFrame(stream_id, closeStreamMsg(stream_id));
+    } else {
+      enqueue(closeStreamMsg(stream_id));
+    }
 
     auto &stream = it->second;
     assert(stream->isClosedForWrite());
@@ -597,86 +707,246 @@ namespace libp2p::connection {
     }
   }
 
-  void YamuxedConnection::enqueue(Buffer packet, StreamId stream_id) {
-    if (is_writing_) {
-      write_queue_.push_back(WriteQueueItem{std::move(packet), stream_id});
+  void YamuxedConnection::enqueue(Buffer packet) {
+    control_queue_.push_back({.header = std::move(packet)});
+    writeNext();
+  }
+
+  void YamuxedConnection::enqueueStreamFrame(StreamId stream_id,
+                                             Buffer header,
+                                             BytesIn payload) {
+    auto &queue = stream_queues_[stream_id];
+    if (queue.items.empty()) {
+      active_streams_.push_back(stream_id);
+    }
+    queue.items.push_back({
+        .header = std::move(header),
+        .payload = payload,
+        .stream_id = stream_id,
+    });
+    writeNext();
+  }
+
+  std::optional<YamuxedConnection::WriteQueueItem>
+  YamuxedConnection::dequeue() {
+    if (!control_queue_.empty()) {
+      auto item = std::move(control_queue_.front());
+      control_queue_.pop_front();
+      return item;
+    }
+    while (!active_streams_.empty()) {
+      auto stream_id = active_streams_.front();
+      auto it = stream_queues_.find(stream_id);
+      if (it == stream_queues_.end()) {
+        // frames were dropped
+        active_streams_.pop_front();
+        round_started_ = false;
+        continue;
+      }
+      auto &queue = it->second;
+      if (!round_started_) {
+        auto weight_it = stream_weights_.find(stream_id);
+        queue.deficit += kQuantumPerWeight
+                       * (weight_it != stream_weights_.end()
+                              ? weight_it->second
+                              : Stream::kDefaultWeight);
+        round_started_ = true;
+      }
+      auto &front = queue.items.front();
+      auto frame_size = YamuxFrame::kHeaderLength
+                      + std::min(front.payload.size(), kMaxDataFrameSize);
+      if (frame_size > queue.deficit) {
+        // next stream's turn
+        active_streams_.pop_front();
+        active_streams_.push_back(stream_id);
+        round_started_ = false;
+        continue;
+      }
+      queue.deficit -= frame_size;
+
+      WriteQueueItem item;
+      if (front.payload.size() > kMaxDataFrameSize) {
+        // split data frame, the rest stays in the queue
+        item.stream_id = stream_id;
+        item.header = dataMsg(stream_id, kMaxDataFrameSize, false);
+        item.payload = front.payload.first(kMaxDataFrameSize);
+        if (!front.payload_copy.empty()) {
+          // released data is owned by queued item which may be dropped
+          item.payload_copy.assign(item.payload.begin(), item.payload.end());
+          item.payload = item.payload_copy;
+        }
+        front.payload = front.payload.subspan(kMaxDataFrameSize);
+        front.header = dataMsg(stream_id, front.payload.size(), false);
+        return item;
+      }
+
+      item = std::move(front);
+      queue.items.pop_front();
+      if (queue.items.empty()) {
+        stream_queues_.erase(it);
+        active_streams_.pop_front();
+        round_started_ = false;
+      }
+      return item;
+    }
+    return std::nullopt;
+  }
+
+  void YamuxedConnection::writeNext() {
+    if (is_writing_ || write_scheduled_) {
+      return;
+    }
+    if (!config_.write_coalescing) {
+      writeBatch();
+      return;
+    }
+    write_scheduled_ = true;
+    auto cb = [weak_self{weak_from_this()}] {
+      if (auto self = weak_self.lock()) {
+        self->write_scheduled_ = false;
+        if (!self->is_writing_) {
+          self->writeBatch();
+        }
+      }
+    };
+    if (config_.write_coalescing_delay == std::chrono::milliseconds::zero()) {
+      deferCall(std::move(cb));
     } else {
-      doWrite(WriteQueueItem{std::move(packet), stream_id});
+      write_handle_ = scheduler_->scheduleWithHandle(
+          std::move(cb), config_.write_coalescing_delay);
     }
   }
 
-  void YamuxedConnection::doWrite(WriteQueueItem packet) {
+  bool YamuxedConnection::writeBatch() {
     assert(!is_writing_);
 
-    writing_buf_->assign(packet.packet.begin(), packet.packet.end());
+    auto &batch = *writing_;
+    size_t batch_size = 0;
+    while (auto item = dequeue()) {
+      batch_size += item->header.size() + item->payload.size();
+      batch.items.emplace_back(std::move(*item));
+      if (!config_.write_coalescing
+          || batch_size >= config_.write_coalescing_max_size) {
+        break;
+      }
+    }
+    if (batch.items.empty()) {
+      return false;
+    }
+    for (auto &item : batch.items) {
+      batch.buffers.emplace_back(item.header);
+      if (!item.payload.empty()) {
+        batch.buffers.emplace_back(item.payload);
+      }
+    }
+
     auto cb = [wptr{weak_from_this()},
-               buf{writing_buf_},
-               packet = std::move(packet)](outcome::result<void> res) mutable {
+               writing{writing_}](outcome::result<void> res) mutable {
       if (auto self = wptr.lock()) {
-        self->onDataWritten(res, std::move(packet));
+        return self->onDataWritten(res);
+      }
+      for (auto &on_written : writing->on_written) {
+        on_written();
       }
     };
 
     is_writing_ = true;
-    write(connection_, *writing_buf_, cb);
+    writeV(connection_, batch.buffers, std::move(cb));
+    return true;
+  }
+
+  void YamuxedConnection::clearWriteQueues() {
+    control_queue_.clear();
+    stream_queues_.clear();
+    active_streams_.clear();
+    round_started_ = false;
+  }
+
+  void YamuxedConnection::dropStreamFrames(StreamId stream_id) {
+    // stream id left in active_streams_ is skipped by dequeue()
+    stream_queues_.erase(stream_id);
   }
 
-  void YamuxedConnection::onDataWritten(outcome::result<void> res,
-                                        WriteQueueItem &&packet) {
+  void YamuxedConnection::onDataWritten(outcome::result<void> res) {
+    // streams which released their data no longer expect acks
+    boost::container::small_vector<std::pair<StreamId, size_t>, 4> acks;
+    for (auto &item : writing_->items) {
+      if (item.stream_id != 0 && !item.payload.empty() && !item.released
+          && item.payload_copy.empty()) {
+        acks.emplace_back(item.stream_id, item.payload.size());
+      }
+    }
+    auto on_written = std::move(writing_->on_written);
+    writing_->on_written.clear();
+    writing_->items.clear();
+    writing_->buffers.clear();
+
+    // this instance may be killed inside further callbacks
+    auto self = shared_from_this();
+
+    for (auto &cb : on_written) {
+      cb();
+    }
+
     if (!res) {
-      write_queue_.clear();
+      clearWriteQueues();
       std::ignore = connection_->close();
       // write error
       close(res.error(), boost::none);
       return;
     }
 
-    // this instance may be killed inside further callback
-    auto self = shared_from_this();
-
-    if (packet.stream_id != 0) {
-      // pass write ack to stream about data size written except header size
-
-      auto sz = packet.packet.size();
-      if (sz < YamuxFrame::kHeaderLength) {
-        log()->error("onDataWritten : too small size arrived: {}", sz);
-        sz = 0;
+    for (auto &[stream_id, payload_size] : acks) {
+      // pass write ack to stream about payload size written
+      auto it = streams_.find(stream_id);
+      if (it == streams_.end()) {
+        SL_DEBUG(
+            log(), "onDataWritten : stream {} no longer exists", stream_id);
       } else {
-        sz -= YamuxFrame::kHeaderLength;
-      }
-
-      if (sz > 0) {
-        auto it = streams_.find(packet.stream_id);
-        if (it == streams_.end()) {
-          SL_DEBUG(log(),
-                   "onDataWritten : stream {} no longer exists",
-                   packet.stream_id);
-        } else {
-          // stream can now call write callbacks
-          it->second->onDataWritten(sz);
-        }
+        // stream can now call write callbacks
+        it->second->onDataWritten(payload_size);
       }
     }
 
     is_writing_ = false;
 
-    if (!write_queue_.empty()) {
-      auto next_packet = std::move(write_queue_.front());
-      write_queue_.pop_front();
-      doWrite(std::move(next_packet));
-    } else if (close_after_write_) {
+    if (!writeBatch() && close_after_write_) {
       std::ignore = connection_->close();
     }
   }
 
   std::shared_ptr<Stream> YamuxedConnection::createStream(StreamId stream_id) {
-    auto stream =
-        std::make_shared<YamuxStream>(shared_from_this(),
-                                      *this,
-                                      stream_id,
-                                      config_.maximum_window_size,
-                                      basic::WriteQueue::kDefaultSizeLimit);
+    std::unique_ptr<YamuxStream> object;
+    if (!stream_pool_->empty()) {
+      object = std::move(stream_pool_->back());
+      stream_pool_->pop_back();
+      object->reuse(shared_from_this(), stream_id);
+    } else {
+      object = std::make_unique<YamuxStream>(
+          shared_from_this(),
+          *this,
+          stream_id,
+          config_.maximum_window_size,
+          basic::WriteQueue::kDefaultSizeLimit,
+          config_.buffer_pool);
+    }
+    // released object returns to the pool, unless connection is destroyed
+    std::shared_ptr<YamuxStream> stream(
+        object.release(),
+        [weak_pool{std::weak_ptr<StreamPool>(stream_pool_)}](
+            YamuxStream *released) {
+          std::unique_ptr<YamuxStream> object{released};
+          auto pool = weak_pool.lock();
+          if (pool && pool->size() < kMaxPooledStreams) {
+            object->recycle();
+            pool->emplace_back(std::move(object));
+          }
+        });
     streams_[stream_id] = stream;
+    // initial window is granted by protocol, may be reserved partially if
+    // budget was exhausted while outbound stream was pending
+    window_reserved_[stream_id] =
+        memory_budget_->reserveUpTo(YamuxFrame::kInitialWindowSize);
     inactivity_handle_.reset();
     return stream;
   }
@@ -684,9 +954,19 @@ namespace libp2p::connection {
   void YamuxedConnection::eraseStream(StreamId stream_id) {
     SL_DEBUG(log(), "erasing stream {}", stream_id);
     streams_.erase(stream_id);
+    stream_weights_.erase(stream_id);
+    if (auto it = window_reserved_.find(stream_id);
+        it != window_reserved_.end()) {
+      memory_budget_->release(it->second);
+      window_reserved_.erase(it);
+    }
     adjustExpireTimer();
   }
 
+  bool YamuxedConnection::canReserveStreamWindow() const {
+    return memory_budget_->available() >= YamuxFrame::kInitialWindowSize;
+  }
+
   void YamuxedConnection::erasePendingOutboundStream(
       PendingOutboundStreams::iterator it) {
     SL_TRACE(log(), "erasing pending outbound stream {}", it->first);
@@ -739,7 +1019,10 @@ namespace libp2p::connection {
           if (!abandoned.empty()) {
             log()->info("cleaning up {} abandoned streams", abandoned.size());
             for (const auto id : abandoned) {
-              self->streams_.erase(id);
+              auto stream = self->streams_.at(id);
+              self->eraseStream(id);
+              self->dropStreamFrames(id);
+              stream->closedByConnection(Stream::Error::STREAM_RESET_BY_HOST);
             }
           }
           self->setTimerCleanup();
@@ -757,13 +1040,19 @@ namespace libp2p::connection {
           if (!self->started_) {
             return;
           }
-          // dont send pings if something is being written
-          if (!self->is_writing_) {
-            self->enqueue(pingOutMsg(++self->ping_counter_));
-            SL_TRACE(log(), "written ping message #{}", self->ping_counter_);
+          // dont send pings if something is being written, unless they
+          // measure RTT: bulk senders need it most
+          if (!self->is_writing_ || self->config_.window_auto_tuning) {
+            self->sendPing();
           }
           self->setTimerPing();
         },
         config_.ping_interval);
   }
+
+  void YamuxedConnection::sendPing() {
+    ping_sent_at_ = now();
+    enqueue(pingOutMsg(++ping_counter_));
+    SL_TRACE(log(), "written ping message #{}", ping_counter_);
+  }
 }  // namespace libp2p::connection
@@ -89,6 +89,26 @@ namespace libp2p::protocol::gossip {
     return ret;
   }
 
+  StreamProtocols protocolVersions(const Config &config) {
+    if (!config.protocol_version.empty()) {
+      return {config.protocol_version};
+    }
+    if (!config.protocol_versions.empty()) {
+      return config.protocol_versions;
+    }
+    // v1.1 and v1.2 imply peer scoring, so they are advertised only if it is
+    // enabled
+    StreamProtocols protocols;
+    if (config.score.enabled) {
+      if (config.idontwant_message_size_threshold != 0) {
+        protocols.emplace_back(kProtocolVersionIDontWant);
+      }
+      protocols.emplace_back(kProtocolVersionScore);
+    }
+    protocols.emplace_back(kProtocolVersionBase);
+    return protocols;
+  }
+
   MessageId createMessageId(const Bytes &from,
                             const Bytes &seq,
                             const Bytes &data) {
@@ -8,7 +8,9 @@
 
 #include <cstdint>
 #include <memory>
+#include <string_view>
 
+#include <libp2p/peer/stream_protocols.hpp>
 #include <libp2p/protocol/gossip/gossip.hpp>
 
 namespace libp2p::protocol::gossip {
@@ -27,12 +29,24 @@ namespace libp2p::protocol::gossip {
     VALIDATION_FAILED
   };
 
+  /// Gossipsub version which supports IDONTWANT
+  constexpr std::string_view kProtocolVersionIDontWant = "/meshsub/1.2.0";
+
+  /// Gossipsub version which supports peer scoring
+  constexpr std::string_view kProtocolVersionScore = "/meshsub/1.1.0";
+
+  /// Gossipsub version supported unconditionally
+  constexpr std::string_view kProtocolVersionBase = "/meshsub/1.0.0";
+
   /// Success indicator to be passed in outcome::result
   struct Success {};
 
   /// Shared buffer used to broadcast messages
   using SharedBuffer = std::shared_ptr<const Bytes>;
 
+  /// Buffers written to stream one after another, e.g. parts of one RPC
+  using SharedBuffers = std::vector<SharedBuffer>;
+
   /// Time is scheduler's clock and counter
   using Time = std::chrono::milliseconds;
 
@@ -68,6 +82,10 @@ namespace libp2p::protocol::gossip {
     boost::optional<Bytes> signature;
     boost::optional<Bytes> key;
 
+    /// RPC "publish" field with this message, encoded on first send and
+    /// shared by all peers the message is sent to
+    mutable SharedBuffer encoded;
+
     /// Creates a new message from wire or storage
     TopicMessage(Bytes _from, Bytes _seq, Bytes _data);
 
@@ -96,6 +114,9 @@ namespace libp2p::protocol::gossip {
   /// Helper for text messages creation and protobuf
   Bytes fromString(const std::string &s);
 
+  /// Protocol versions to advertise, see Config::protocol_versions
+  StreamProtocols protocolVersions(const Config &config);
+
   /// Creates message id, default function
   MessageId createMessageId(const Bytes &from,
                             const Bytes &seq,
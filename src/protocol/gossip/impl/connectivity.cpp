@@ -24,6 +24,22 @@ namespace libp2p::protocol::gossip {
               != container.end());
     }
 
+    /// Returns IP address of remote side of stream or empty string
+    std::string remoteIp(const connection::Stream &stream) {
+      auto address = stream.remoteMultiaddr();
+      if (!address) {
+        return {};
+      }
+      for (auto proto : {multi::Protocol::Code::IP4,
+                         multi::Protocol::Code::IP6}) {
+        auto ip = address.value().getFirstValueForProtocol(proto);
+        if (ip) {
+          return ip.value();
+        }
+      }
+      return {};
+    }
+
   }  // namespace
 
   Connectivity::Connectivity(Config config,
@@ -32,6 +48,7 @@ namespace libp2p::protocol::gossip {
                              std::shared_ptr<MessageReceiver> msg_receiver,
                              ConnectionStatusFeedback on_connected)
       : config_(std::move(config)),
+        protocols_(protocolVersions(config_)),
         scheduler_(std::move(scheduler)),
         host_(std::move(host)),
         msg_receiver_(std::move(msg_receiver)),
@@ -58,7 +75,7 @@ namespace libp2p::protocol::gossip {
         };
 
     host_->setProtocolHandler(
-        {config_.protocol_version},
+        protocols_,
         [self_wptr=weak_from_this()]
             (StreamAndProtocol stream) {
           auto h = self_wptr.lock();
@@ -135,11 +152,12 @@ namespace libp2p::protocol::gossip {
   }
 
   peer::ProtocolName Connectivity::getProtocolId() const {
-    return config_.protocol_version;
+    return protocols_.front();
   }
 
   void Connectivity::handle(StreamAndProtocol stream_and_protocol) {
     auto &stream = stream_and_protocol.stream;
+    auto &protocol = stream_and_protocol.protocol;
 
     if (!started_) {
       stream->reset();
@@ -185,6 +203,15 @@ namespace libp2p::protocol::gossip {
     stream_id = ctx->inbound_streams.size() + 1;
     is_new_connection = (stream_id == 1 && !ctx->outbound_stream);
 
+    if (is_new_connection) {
+      ctx->ip = remoteIp(*stream);
+    }
+
+    if (!ctx->outbound_stream) {
+      // until the outbound stream negotiates its own
+      ctx->protocol = std::move(protocol);
+    }
+
     auto gossip_stream = std::make_shared<Stream>(stream_id,
                                                   config_,
                                                   *scheduler_,
@@ -232,7 +259,7 @@ namespace libp2p::protocol::gossip {
     // clang-format off
     host_->newStream(
         pi,
-        {config_.protocol_version},
+        protocols_,
         [wptr = weak_from_this(), this, ctx=ctx] (auto &&rstream) mutable {
             auto self = wptr.lock();
           if (self) {
@@ -253,7 +280,7 @@ namespace libp2p::protocol::gossip {
     // clang-format off
     host_->newStream(
         ctx->peer_id,
-        {config_.protocol_version},
+        protocols_,
         [wptr = weak_from_this(), this, ctx=ctx] (auto &&rstream) mutable {
           auto self = wptr.lock();
           if (self) {
@@ -279,6 +306,7 @@ namespace libp2p::protocol::gossip {
     }
 
     auto &stream = rstream.value().stream;
+    auto &protocol = rstream.value().protocol;
 
     if (!started_) {
       stream->reset();
@@ -302,6 +330,14 @@ namespace libp2p::protocol::gossip {
     size_t stream_id = 0;
     bool is_new_connection = ctx->inbound_streams.empty();
 
+    if (is_new_connection) {
+      ctx->ip = remoteIp(*stream);
+    }
+
+    // messages are written to this stream, so its protocol is what peer
+    // understands
+    ctx->protocol = std::move(protocol);
+
     auto gossip_stream = std::make_shared<Stream>(stream_id,
                                                   config_,
                                                   *scheduler_,
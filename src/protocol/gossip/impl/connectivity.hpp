@@ -100,6 +100,10 @@ namespace libp2p::protocol::gossip {
     void flush(const PeerContextPtr &ctx) const;
 
     const Config config_;
+
+    /// Protocol versions advertised and dialed, in order of preference
+    const StreamProtocols protocols_;
+
     std::shared_ptr<basic::Scheduler> scheduler_;
     std::shared_ptr<Host> host_;
     std::shared_ptr<MessageReceiver> msg_receiver_;
@@ -9,6 +9,7 @@
 #include <cassert>
 
 #include <libp2p/crypto/crypto_provider.hpp>
+#include <libp2p/crypto/error.hpp>
 #include <libp2p/crypto/key_marshaller.hpp>
 #include <libp2p/peer/identity_manager.hpp>
 #include <qtils/hex.hpp>
@@ -17,6 +18,7 @@
 #include "local_subscriptions.hpp"
 #include "message_builder.hpp"
 #include "remote_subscriptions.hpp"
+#include "score.hpp"
 
 namespace libp2p::protocol::gossip {
 
@@ -108,8 +110,10 @@ namespace libp2p::protocol::gossip {
       connectivity_->addBootstrapPeer(p.first, p.second);
     }
 
+    score_ = std::make_shared<Score>(config_.score);
+
     remote_subscriptions_ = std::make_shared<RemoteSubscriptions>(
-        config_, *connectivity_, *scheduler_, log_);
+        config_, *connectivity_, *score_, *scheduler_, log_);
 
     started_ = true;
 
@@ -134,7 +138,12 @@ namespace libp2p::protocol::gossip {
     // it closes all senders and receivers
     connectivity_->stop();
 
+    // late validation results are dropped
+    validating_.clear();
+    validating_per_topic_.clear();
+
     remote_subscriptions_.reset();
+    score_.reset();
     connectivity_.reset();
 
     local_subscriptions_->forwardEndOfSubscription();
@@ -143,7 +152,14 @@ namespace libp2p::protocol::gossip {
   void GossipCore::setValidator(const TopicId &topic, Validator validator) {
     assert(validator);
     auto sub = subscribe({topic}, [](const SubscriptionData &) {});
-    validators_[topic] = {std::move(validator), std::move(sub)};
+    validators_[topic] = {std::move(validator), nullptr, std::move(sub)};
+  }
+
+  void GossipCore::setAsyncValidator(const TopicId &topic,
+                                     AsyncValidator validator) {
+    assert(validator);
+    auto sub = subscribe({topic}, [](const SubscriptionData &) {});
+    validators_[topic] = {nullptr, std::move(validator), std::move(sub)};
   }
 
   void GossipCore::setMessageIdFn(MessageIdFn fn) {
@@ -202,6 +218,28 @@ namespace libp2p::protocol::gossip {
     return outcome::success();
   }
 
+  outcome::result<crypto::PublicKey> GossipCore::messageKey(
+      const TopicMessage &msg) const {
+    OUTCOME_TRY(peer_id, peer::PeerId::fromBytes(msg.from));
+    if (msg.key) {
+      // the key must be the author's one, not just any valid key
+      crypto::ProtobufKey key{msg.key.value()};
+      OUTCOME_TRY(key_peer_id, peer::PeerId::fromPublicKey(key));
+      if (key_peer_id != peer_id) {
+        return crypto::CryptoProviderError::SIGNATURE_VERIFICATION_FAILED;
+      }
+      return key_marshaller_->unmarshalPublicKey(key);
+    }
+    // short keys are inlined into identity peer ids
+    const auto &multihash = peer_id.toMultihash();
+    if (multihash.getType() != multi::HashType::identity) {
+      return crypto::CryptoProviderError::SIGNATURE_VERIFICATION_FAILED;
+    }
+    auto hash = multihash.getHash();
+    return key_marshaller_->unmarshalPublicKey(
+        crypto::ProtobufKey{Bytes{hash.begin(), hash.end()}});
+  }
+
   void GossipCore::onSubscription(const PeerContextPtr &peer,
                                   bool subscribe,
                                   const TopicId &topic) {
@@ -223,6 +261,10 @@ namespace libp2p::protocol::gossip {
                            const MessageId &msg_id) {
     assert(started_);
 
+    if (belowGossipThreshold(from)) {
+      return;
+    }
+
     log_.debug("peer {} has msg for topic {}", from->str, topic);
 
     if (remote_subscriptions_->hasTopic(topic)
@@ -236,6 +278,10 @@ namespace libp2p::protocol::gossip {
 
   void GossipCore::onIWant(const PeerContextPtr &from,
                            const MessageId &msg_id) {
+    if (belowGossipThreshold(from)) {
+      return;
+    }
+
     log_.debug("peer {} wants message {:x}", from->str, msg_id);
 
     auto msg_found = msg_cache_.getMessage(msg_id);
@@ -247,9 +293,24 @@ namespace libp2p::protocol::gossip {
     }
   }
 
+  void GossipCore::onIDontWant(const PeerContextPtr &from,
+                               const MessageId &msg_id) {
+    if (from->dont_want.size() >= config_.idontwant_max_messages) {
+      return;
+    }
+    if (from->dont_want.insert(msg_id).second) {
+      from->dont_want_expiration.emplace_back(
+          scheduler_->now() + config_.idontwant_lifetime_msec, msg_id);
+    }
+  }
+
   void GossipCore::onGraft(const PeerContextPtr &from, const TopicId &topic) {
     assert(started_);
 
+    if (graylisted(from)) {
+      return;
+    }
+
     log_.debug("graft from peer {} for topic {}", from->str, topic);
 
     remote_subscriptions_->onGraft(from, topic);
@@ -269,6 +330,10 @@ namespace libp2p::protocol::gossip {
                                   TopicMessage::Ptr msg) {
     assert(started_);
 
+    if (graylisted(from)) {
+      return;
+    }
+
     // do we need this message?
     auto subscribed = remote_subscriptions_->hasTopic(msg->topic);
     if (!subscribed) {
@@ -282,36 +347,225 @@ namespace libp2p::protocol::gossip {
     if (msg_cache_.contains(msg_id)) {
       // already there, ignore
       log_.debug("ignoring message, already in cache");
+      score_->duplicateMessage(
+          from->peer_id, msg->topic, msg_id, scheduler_->now());
+      return;
+    }
+
+    if (validating_.count(msg_id) != 0) {
+      log_.debug("ignoring message, already being validated");
+      return;
+    }
+
+    // mesh peers are told not to send the message before it is validated,
+    // while they may still not have sent it
+    if (config_.idontwant_message_size_threshold != 0
+        && msg->data.size() >= config_.idontwant_message_size_threshold) {
+      remote_subscriptions_->sendIDontWant(from, msg->topic, msg_id);
+    }
+
+    if (config_.verify_signatures) {
+      if (!msg->signature) {
+        log_.debug("ignoring unsigned message");
+        return;
+      }
+      if (pending_verification_.empty()) {
+        scheduler_->schedule([wptr{weak_from_this()}] {
+          if (auto self = wptr.lock()) {
+            self->verifyPendingMessages();
+          }
+        });
+      }
+      pending_verification_.push_back({from, std::move(msg), msg_id});
+      return;
+    }
+
+    validateMessage(from, std::move(msg), msg_id);
+  }
+
+  void GossipCore::validateMessage(const PeerContextPtr &from,
+                                   TopicMessage::Ptr msg,
+                                   const MessageId &msg_id) {
+    // If no validator is set then we suppose that the message is valid
+    // (we might not know topic details)
+    auto it = validators_.find(msg->topic);
+    if (it == validators_.end()) {
+      acceptMessage(from, msg, msg_id);
+      return;
+    }
+    const auto &validator = it->second;
+
+    if (validator.validator && !config_.validation_executor) {
+      if (!validator.validator(msg->from, msg->data)) {
+        log_.debug("message validation failed");
+        score_->rejectMessage(from->peer_id, msg->topic);
+        return;
+      }
+      acceptMessage(from, msg, msg_id);
       return;
     }
 
-    // validate message. If no validator is set then we
-    // suppose that the message is valid (we might not know topic details)
-    bool valid = true;
+    auto &pending = validating_per_topic_[msg->topic];
+    if (pending >= config_.max_pending_validations) {
+      log_.debug("validation queue of topic {} is full, dropping message",
+                 msg->topic);
+      return;
+    }
+    ++pending;
+    validating_.insert(msg_id);
 
-    if (!validators_.empty()) {
-      auto it = validators_.find(msg->topic);
-      if (it != validators_.end()) {
-        valid = it->second.validator(msg->from, msg->data);
+    auto done = [wptr{weak_from_this()}, from, msg, msg_id](
+                    ValidationResult result) {
+      if (auto self = wptr.lock()) {
+        self->onValidated(from, msg, msg_id, result);
       }
+    };
+
+    if (validator.async_validator) {
+      validator.async_validator(msg->from, msg->data, std::move(done));
+      return;
     }
 
-    if (!valid) {
-      log_.debug("message validation failed");
+    security::runCrypto(
+        config_.validation_executor,
+        [validator{validator.validator}, msg] {
+          return validator(msg->from, msg->data) ? ValidationResult::ACCEPT
+                                                 : ValidationResult::REJECT;
+        },
+        std::move(done));
+  }
+
+  void GossipCore::onValidated(const PeerContextPtr &from,
+                               const TopicMessage::Ptr &msg,
+                               const MessageId &msg_id,
+                               ValidationResult result) {
+    if (!started_ || validating_.erase(msg_id) == 0) {
       return;
     }
+    auto it = validating_per_topic_.find(msg->topic);
+    if (it != validating_per_topic_.end() && --it->second == 0) {
+      validating_per_topic_.erase(it);
+    }
 
+    switch (result) {
+      case ValidationResult::ACCEPT:
+        acceptMessage(from, msg, msg_id);
+        connectivity_->flush();
+        break;
+      case ValidationResult::REJECT:
+        log_.debug("message validation failed");
+        score_->rejectMessage(from->peer_id, msg->topic);
+        break;
+      case ValidationResult::IGNORE:
+        log_.debug("message ignored by validator");
+        break;
+    }
+  }
+
+  void GossipCore::acceptMessage(const PeerContextPtr &from,
+                                 const TopicMessage::Ptr &msg,
+                                 const MessageId &msg_id) {
     if (!msg_cache_.insert(msg, msg_id)) {
       log_.error("message cache error");
       return;
     }
 
+    score_->deliverMessage(
+        from->peer_id, msg->topic, msg_id, scheduler_->now());
+
     log_.debug("forwarding message");
 
     local_subscriptions_->forwardMessage(msg);
     remote_subscriptions_->onNewMessage(from, msg, msg_id);
   }
 
+  void GossipCore::verifyPendingMessages() {
+    if (!started_) {
+      pending_verification_.clear();
+      return;
+    }
+    auto pending = std::move(pending_verification_);
+    pending_verification_.clear();
+
+    // signable messages must outlive the batch, which refers to them
+    std::vector<Bytes> signables;
+    std::vector<crypto::SignatureBatchItem> batch;
+    std::vector<size_t> indices;
+    signables.reserve(pending.size());
+    batch.reserve(pending.size());
+    for (size_t i = 0; i < pending.size(); ++i) {
+      const auto &msg = *pending[i].msg;
+      auto key = messageKey(msg);
+      if (!key) {
+        log_.debug("invalid key, message from peer {}", pending[i].from->str);
+        score_->rejectMessage(pending[i].from->peer_id, msg.topic);
+        continue;
+      }
+      auto signable = MessageBuilder::signableMessage(msg);
+      if (!signable) {
+        log_.debug("cannot verify message from peer {}", pending[i].from->str);
+        continue;
+      }
+      signables.emplace_back(std::move(signable.value()));
+      batch.push_back({signables.back(), msg.signature.value(), key.value()});
+      indices.push_back(i);
+    }
+    if (batch.empty()) {
+      return;
+    }
+
+    auto verified = crypto_provider_->verifyBatch(batch);
+    if (!verified) {
+      // failure of the batch as a whole says nothing about its messages
+      log_.warn("signature batch verification error: {}", verified.error());
+      verified = verifyEach(batch);
+    }
+    for (size_t i = 0; i < indices.size(); ++i) {
+      auto &pending_msg = pending[indices[i]];
+      if (!verified.value()[i]) {
+        log_.debug("invalid signature, message from peer {}",
+                   pending_msg.from->str);
+        score_->rejectMessage(pending_msg.from->peer_id,
+                              pending_msg.msg->topic);
+        continue;
+      }
+      if (validating_.count(pending_msg.msg_id) != 0) {
+        continue;
+      }
+      if (msg_cache_.contains(pending_msg.msg_id)) {
+        // the same message may come from several peers within a batch
+        score_->duplicateMessage(pending_msg.from->peer_id,
+                                 pending_msg.msg->topic,
+                                 pending_msg.msg_id,
+                                 scheduler_->now());
+        continue;
+      }
+      validateMessage(
+          pending_msg.from, std::move(pending_msg.msg), pending_msg.msg_id);
+    }
+    connectivity_->flush();
+  }
+
+  std::vector<bool> GossipCore::verifyEach(
+      std::span<const crypto::SignatureBatchItem> batch) const {
+    std::vector<bool> verified;
+    verified.reserve(batch.size());
+    for (const auto &item : batch) {
+      auto result = crypto_provider_->verify(
+          item.message, item.signature, item.public_key);
+      verified.push_back(result && result.value());
+    }
+    return verified;
+  }
+
+  bool GossipCore::graylisted(const PeerContextPtr &peer) const {
+    return score_->score(peer->peer_id) < config_.score.graylist_threshold;
+  }
+
+  bool GossipCore::belowGossipThreshold(const PeerContextPtr &peer) const {
+    return score_->score(peer->peer_id) < config_.score.gossip_threshold;
+  }
+
   void GossipCore::onMessageEnd(const PeerContextPtr &from) {
     assert(started_);
 
@@ -327,6 +581,11 @@ namespace libp2p::protocol::gossip {
     // shift cache
     msg_cache_.shift();
 
+    // decay scores before they are used in mesh maintenance
+    score_->onHeartbeat(scheduler_->now());
+
+    expireDontWant(scheduler_->now());
+
     // heartbeat changes per topic
     remote_subscriptions_->onHeartbeat();
 
@@ -337,11 +596,23 @@ namespace libp2p::protocol::gossip {
     setTimerHeartbeat();
   }
 
+  void GossipCore::expireDontWant(Time now) {
+    connectivity_->getConnectedPeers().selectAll(
+        [now](const PeerContextPtr &ctx) {
+          auto &expiration = ctx->dont_want_expiration;
+          while (!expiration.empty() && expiration.front().first < now) {
+            ctx->dont_want.erase(expiration.front().second);
+            expiration.pop_front();
+          }
+        });
+  }
+
   void GossipCore::onPeerConnection(bool connected, const PeerContextPtr &ctx) {
     assert(started_);
 
     if (connected) {
       log_.debug("peer {} connected", ctx->str);
+      score_->connect(ctx->peer_id, ctx->ip);
       // notify the new peer about all topics we subscribed to
       if (!local_subscriptions_->subscribedTo().empty()) {
         for (const auto &local_sub : local_subscriptions_->subscribedTo()) {
@@ -353,6 +624,9 @@ namespace libp2p::protocol::gossip {
     } else {
       log_.debug("peer {} disconnected", ctx->str);
       remote_subscriptions_->onPeerDisconnected(ctx);
+      score_->disconnect(ctx->peer_id, scheduler_->now());
+      ctx->dont_want.clear();
+      ctx->dont_want_expiration.clear();
     }
   }
 
@@ -9,8 +9,10 @@
 #include <libp2p/protocol/gossip/gossip.hpp>
 
 #include <map>
+#include <unordered_set>
 
 #include <libp2p/basic/scheduler.hpp>
+#include <libp2p/crypto/crypto_provider.hpp>
 #include <libp2p/host/host.hpp>
 #include <libp2p/log/sublogger.hpp>
 
@@ -23,6 +25,7 @@ namespace libp2p::protocol::gossip {
   class LocalSubscriptions;
   class RemoteSubscriptions;
   class Connectivity;
+  class Score;
 
   /// Central component in gossip protocol impl, manages pub-sub logic itself
   class GossipCore : public Gossip,
@@ -53,6 +56,8 @@ namespace libp2p::protocol::gossip {
     void start() override;
     void stop() override;
     void setValidator(const TopicId &topic, Validator validator) override;
+    void setAsyncValidator(const TopicId &topic,
+                           AsyncValidator validator) override;
     void setMessageIdFn(MessageIdFn fn) override;
     Subscription subscribe(TopicSet topics,
                            SubscriptionCallback callback) override;
@@ -60,6 +65,11 @@ namespace libp2p::protocol::gossip {
 
     outcome::result<void> signMessage(TopicMessage &msg) const;
 
+    /// Extracts the author public key of received message, fails if the key
+    /// does not belong to the message author
+    outcome::result<crypto::PublicKey> messageKey(
+        const TopicMessage &msg) const;
+
     // MessageReceiver overrides
     void onSubscription(const PeerContextPtr &from,
                         bool subscribe,
@@ -68,6 +78,8 @@ namespace libp2p::protocol::gossip {
                  const TopicId &topic,
                  const MessageId &msg_id) override;
     void onIWant(const PeerContextPtr &from, const MessageId &msg_id) override;
+    void onIDontWant(const PeerContextPtr &from,
+                     const MessageId &msg_id) override;
     void onGraft(const PeerContextPtr &from, const TopicId &topic) override;
     void onPrune(const PeerContextPtr &from,
                  const TopicId &topic,
@@ -76,9 +88,42 @@ namespace libp2p::protocol::gossip {
                         TopicMessage::Ptr msg) override;
     void onMessageEnd(const PeerContextPtr &from) override;
 
+    /// Validates new message, sync validators run inline if there is no
+    /// validation executor
+    void validateMessage(const PeerContextPtr &from,
+                         TopicMessage::Ptr msg,
+                         const MessageId &msg_id);
+
+    /// Asynchronous validation of message finished
+    void onValidated(const PeerContextPtr &from,
+                     const TopicMessage::Ptr &msg,
+                     const MessageId &msg_id,
+                     ValidationResult result);
+
+    /// Caches and forwards a new valid message
+    void acceptMessage(const PeerContextPtr &from,
+                       const TopicMessage::Ptr &msg,
+                       const MessageId &msg_id);
+
+    /// Verifies signatures of pending messages in one batch
+    void verifyPendingMessages();
+
+    /// Verifies signatures one by one if batch verification fails
+    std::vector<bool> verifyEach(
+        std::span<const crypto::SignatureBatchItem> batch) const;
+
+    /// Returns true if peer score is below graylist threshold
+    bool graylisted(const PeerContextPtr &peer) const;
+
+    /// Returns true if peer score is below gossip threshold
+    bool belowGossipThreshold(const PeerContextPtr &peer) const;
+
     /// Periodic heartbeat timer fn
     void onHeartbeat();
 
+    /// Forgets expired IDONTWANT message ids of connected peers
+    void expireDontWant(Time now);
+
     /// Local host subscribed or unsubscribed from topic
     void onLocalSubscriptionChanged(bool subscribe, const TopicId &topic);
 
@@ -118,20 +163,41 @@ namespace libp2p::protocol::gossip {
     /// Local subscriptions manager (this host subscribed to topics)
     std::shared_ptr<LocalSubscriptions> local_subscriptions_;
 
+    /// Peer scores (gossipsub v1.1)
+    std::shared_ptr<Score> score_;
+
     /// Remote subscriptions manager (other peers subscribed to topics)
     std::shared_ptr<RemoteSubscriptions> remote_subscriptions_;
 
+    /// Either of validators is set
     struct ValidatorAndLocalSub {
       Validator validator;
+      AsyncValidator async_validator;
       Subscription sub;
     };
 
     /// Remote messages validators by topic
     std::unordered_map<TopicId, ValidatorAndLocalSub> validators_;
 
+    /// Messages being validated asynchronously, their duplicates are dropped
+    std::unordered_set<MessageId> validating_;
+
+    /// Number of messages being validated asynchronously by topic
+    std::unordered_map<TopicId, size_t> validating_per_topic_;
+
     /// Network part of gossip component
     std::shared_ptr<Connectivity> connectivity_;
 
+    /// Received message waiting for signature verification
+    struct PendingMessage {
+      PeerContextPtr from;
+      TopicMessage::Ptr msg;
+      MessageId msg_id;
+    };
+
+    /// Messages to be verified in the next batch
+    std::vector<PendingMessage> pending_verification_;
+
     /// Local {un}subscribe changes to be broadcasted to peers
     std::map<TopicId, bool> broadcast_on_heartbeat_;
 
@@ -20,7 +20,8 @@ namespace libp2p::protocol::gossip {
     }
   }  // namespace
 
-  MessageBuilder::MessageBuilder() : empty_(true), control_not_empty_(false) {}
+  MessageBuilder::MessageBuilder()
+      : empty_(true), control_not_empty_(false), encode_error_(false) {}
 
   MessageBuilder::~MessageBuilder() = default;
 
@@ -29,8 +30,12 @@ namespace libp2p::protocol::gossip {
     control_pb_msg_->Clear();
     empty_ = true;
     control_not_empty_ = false;
+    encode_error_ = false;
     ihaves_.clear();
     iwant_.clear();
+    idontwant_.clear();
+    messages_.clear();
+    messages_size_ = 0;
     messages_added_.clear();
   }
 
@@ -39,8 +44,12 @@ namespace libp2p::protocol::gossip {
     control_pb_msg_.reset();
     empty_ = true;
     control_not_empty_ = false;
+    encode_error_ = false;
     decltype(ihaves_){}.swap(ihaves_);
     decltype(iwant_){}.swap(iwant_);
+    decltype(idontwant_){}.swap(idontwant_);
+    decltype(messages_){}.swap(messages_);
+    messages_size_ = 0;
     decltype(messages_added_){}.swap(messages_added_);
   }
 
@@ -55,7 +64,7 @@ namespace libp2p::protocol::gossip {
     return empty_;
   }
 
-  outcome::result<SharedBuffer> MessageBuilder::serialize() {
+  outcome::result<SharedBuffers> MessageBuilder::serialize() {
     create_protobuf_structures();
 
     for (auto &[topic, message_ids] : ihaves_) {
@@ -73,13 +82,22 @@ namespace libp2p::protocol::gossip {
       }
     }
 
+    if (!idontwant_.empty()) {
+      auto *idw = control_pb_msg_->add_idontwant();
+      for (auto &mid : idontwant_) {
+        idw->add_messageids(toString(mid), mid.size());
+      }
+    }
+
     if (control_not_empty_) {
       pb_msg_->set_allocated_control(control_pb_msg_.get());
     }
 
     size_t msg_sz = pb_msg_->ByteSizeLong();
 
-    auto varint_len = multi::UVarint{msg_sz};
+    // encoded messages are repeated RPC fields, so they are appended to the
+    // rest of RPC as is
+    auto varint_len = multi::UVarint{msg_sz + messages_size_};
     auto varint_vec = varint_len.toVector();
     size_t prefix_sz = varint_vec.size();
 
@@ -95,6 +113,24 @@ namespace libp2p::protocol::gossip {
       std::ignore = pb_msg_->release_control();
     }
 
+    SharedBuffers buffers;
+    for (auto &message : messages_) {
+      if (message->size() < kSharedMessageSize) {
+        buffer->insert(buffer->end(), message->begin(), message->end());
+        continue;
+      }
+      if (!buffer->empty()) {
+        buffers.emplace_back(std::move(buffer));
+        buffer = std::make_shared<Bytes>();
+      }
+      buffers.emplace_back(message);
+    }
+    if (!buffer->empty()) {
+      buffers.emplace_back(std::move(buffer));
+    }
+
+    success = success && !encode_error_;
+
     static constexpr size_t kSizeThreshold = 8192;
     if (msg_sz > kSizeThreshold) {
       reset();
@@ -103,7 +139,7 @@ namespace libp2p::protocol::gossip {
     }
 
     if (success) {
-      return buffer;
+      return buffers;
     }
     return Error::MESSAGE_SERIALIZE_ERROR;
   }
@@ -129,6 +165,12 @@ namespace libp2p::protocol::gossip {
     empty_ = false;
   }
 
+  void MessageBuilder::addIDontWant(const MessageId &msg_id) {
+    idontwant_.push_back(msg_id);
+    control_not_empty_ = true;
+    empty_ = false;
+  }
+
   void MessageBuilder::addGraft(const TopicId &topic) {
     create_protobuf_structures();
 
@@ -147,15 +189,31 @@ namespace libp2p::protocol::gossip {
 
   void MessageBuilder::addMessage(const TopicMessage &msg,
                                   const MessageId &msg_id) {
-    create_protobuf_structures();
-
     if (messages_added_.count(msg_id) != 0) {
       // prevent duplicates
       return;
     }
     messages_added_.insert(msg_id);
 
-    auto *dst = pb_msg_->add_publish();
+    auto encoded = encodedMessage(msg);
+    if (encoded) {
+      messages_size_ += encoded.value()->size();
+      messages_.emplace_back(std::move(encoded.value()));
+    } else {
+      // reported on serialize
+      encode_error_ = true;
+    }
+    empty_ = false;
+  }
+
+  outcome::result<SharedBuffer> MessageBuilder::encodedMessage(
+      const TopicMessage &msg) {
+    if (msg.encoded) {
+      return msg.encoded;
+    }
+
+    pubsub::pb::RPC pb_msg;
+    auto *dst = pb_msg.add_publish();
     dst->set_from(msg.from.data(), msg.from.size());
     dst->set_data(msg.data.data(), msg.data.size());
     dst->set_seqno(msg.seq_no.data(), msg.seq_no.size());
@@ -167,7 +225,15 @@ namespace libp2p::protocol::gossip {
     if (msg.key) {
       dst->set_key(msg.key.value().data(), msg.key.value().size());
     }
-    empty_ = false;
+
+    // RPC with the only "publish" entry is encoded exactly as that field
+    auto size = pb_msg.ByteSizeLong();
+    auto buffer = std::make_shared<Bytes>(size);
+    if (!pb_msg.SerializeToArray(buffer->data(), static_cast<int>(size))) {
+      return Error::MESSAGE_SERIALIZE_ERROR;
+    }
+    msg.encoded = buffer;
+    return buffer;
   }
 
   outcome::result<Bytes> MessageBuilder::signableMessage(
@@ -38,8 +38,10 @@ namespace libp2p::protocol::gossip {
     /// Returns true if nothing added
     bool empty() const;
 
-    /// Serializes into byte buffer and clears internal state
-    outcome::result<SharedBuffer> serialize();
+    /// Serializes into byte buffers and clears internal state.
+    /// Encoded messages of kSharedMessageSize or more are returned as separate
+    /// buffers shared with other peers, smaller parts are joined
+    outcome::result<SharedBuffers> serialize();
 
     /// Adds subscription notification
     void addSubscription(bool subscribe, const TopicId &topic);
@@ -50,6 +52,9 @@ namespace libp2p::protocol::gossip {
     /// Adds "I want" request
     void addIWant(const MessageId &msg_id);
 
+    /// Adds "I don't want" notification
+    void addIDontWant(const MessageId &msg_id);
+
     /// Adds graft request
     void addGraft(const TopicId &topic);
 
@@ -61,6 +66,13 @@ namespace libp2p::protocol::gossip {
 
     static outcome::result<Bytes> signableMessage(const TopicMessage &msg);
 
+    /// Returns RPC "publish" field with the message, encodes it only once
+    static outcome::result<SharedBuffer> encodedMessage(
+        const TopicMessage &msg);
+
+    /// Encoded messages of this size and more are not copied on serialize
+    static constexpr size_t kSharedMessageSize = 4096;
+
    private:
     /// Creates protobuf structures if needed
     void create_protobuf_structures();
@@ -73,6 +85,7 @@ namespace libp2p::protocol::gossip {
     std::unique_ptr<pubsub::pb::ControlMessage> control_pb_msg_;
     bool empty_;
     bool control_not_empty_;
+    bool encode_error_;
 
     /// Intermediate struct for building IHave messages
     std::map<TopicId, std::vector<MessageId>> ihaves_;
@@ -80,6 +93,13 @@ namespace libp2p::protocol::gossip {
     /// Intermediate struct for building IWant request
     std::vector<MessageId> iwant_;
 
+    /// Intermediate struct for building IDontWant notification
+    std::vector<MessageId> idontwant_;
+
+    /// Encoded messages to be forwarded, shared between peers
+    std::vector<SharedBuffer> messages_;
+    size_t messages_size_ = 0;
+
     /// Used to prevent duplicate forwarding
     std::unordered_set<MessageId> messages_added_;
   };
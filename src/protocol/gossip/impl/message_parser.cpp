@@ -66,6 +66,7 @@ namespace libp2p::protocol::gossip {
       size_t curr_iwant_messages = 0;
       size_t curr_graft_messages = 0;
       size_t curr_prune_messages = 0;
+      size_t curr_idontwant_messages = 0;
 
       for (const auto &h : c.ihave()) {
         if (curr_ihave_messages == limits_->max_ihave_messages) {
@@ -155,6 +156,26 @@ namespace libp2p::protocol::gossip {
 
         curr_prune_messages++;
       }
+
+      for (const auto &d : c.idontwant()) {
+        if (curr_idontwant_messages == limits_->max_idontwant_messages) {
+          break;
+        }
+        size_t curr_idontwant_message_ids = 0;
+        for (const auto &msg_id : d.messageids()) {
+          if (curr_idontwant_message_ids
+              == limits_->max_idontwant_message_ids) {
+            break;
+          }
+          if (msg_id.empty()) {
+            continue;
+          }
+          receiver.onIDontWant(from, fromString(msg_id));
+
+          curr_idontwant_message_ids++;
+        }
+        curr_idontwant_messages++;
+      }
     }
 
     for (const auto &m : pb_msg_->publish()) {
@@ -6,7 +6,11 @@
 
 #pragma once
 
+#include <deque>
+#include <unordered_set>
+
 #include <libp2p/common/metrics/instance_count.hpp>
+#include <libp2p/peer/protocol.hpp>
 
 #include "common.hpp"
 
@@ -42,6 +46,16 @@ namespace libp2p::protocol::gossip {
     /// If true, then outbound connection is in progress
     bool is_connecting = false;
 
+    /// Remote IP address of connection, if known, used in peer scoring
+    std::string ip;
+
+    /// Protocol version negotiated with the peer
+    peer::ProtocolName protocol;
+
+    /// Messages the peer asked not to send (IDONTWANT), with expiration
+    std::unordered_set<MessageId> dont_want;
+    std::deque<std::pair<Time, MessageId>> dont_want_expiration;
+
     ~PeerContext() = default;
     PeerContext(PeerContext &&) = delete;
     PeerContext(const PeerContext &) = delete;
@@ -15,10 +15,12 @@ namespace libp2p::protocol::gossip {
 
   RemoteSubscriptions::RemoteSubscriptions(const Config &config,
                                            Connectivity &connectivity,
+                                           Score &score,
                                            basic::Scheduler &scheduler,
                                            log::SubLogger &log)
       : config_(config),
         connectivity_(connectivity),
+        score_(score),
         scheduler_(scheduler),
         log_(log) {}
 
@@ -105,7 +107,7 @@ namespace libp2p::protocol::gossip {
       connectivity_.peerIsWritable(peer, true);
       return;
     }
-    res.value().onGraft(peer);
+    res.value().onGraft(peer, scheduler_.now());
   }
 
   void RemoteSubscriptions::onPrune(const PeerContextPtr &peer,
@@ -133,6 +135,16 @@ namespace libp2p::protocol::gossip {
     res.value().onNewMessage(from, msg, msg_id, now);
   }
 
+  void RemoteSubscriptions::sendIDontWant(const PeerContextPtr &from,
+                                          const TopicId &topic,
+                                          const MessageId &msg_id) {
+    auto res = getItem(topic, false);
+    if (!res) {
+      return;
+    }
+    res.value().sendIDontWant(from, msg_id);
+  }
+
   void RemoteSubscriptions::onHeartbeat() {
     auto now = scheduler_.now();
     for (auto it = table_.begin(); it != table_.end();) {
@@ -155,7 +167,8 @@ namespace libp2p::protocol::gossip {
     }
     if (create_if_not_exist) {
       auto [it, _] = table_.emplace(
-          topic, TopicSubscriptions(topic, config_, connectivity_, log_));
+          topic,
+          TopicSubscriptions(topic, config_, connectivity_, score_, log_));
       TopicSubscriptions &item = it->second;
       connectivity_.getConnectedPeers().selectIf(
           [&item](const PeerContextPtr &ctx) { item.onPeerSubscribed(ctx); },
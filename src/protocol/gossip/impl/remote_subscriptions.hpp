@@ -20,6 +20,7 @@ namespace libp2p::protocol::gossip {
     /// GossipCore and lives only within its scope
     RemoteSubscriptions(const Config &config,
                         Connectivity &connectivity,
+                        Score &score,
                         basic::Scheduler &scheduler,
                         log::SubLogger &log);
 
@@ -54,6 +55,11 @@ namespace libp2p::protocol::gossip {
                       const TopicMessage::Ptr &msg,
                       const MessageId &msg_id);
 
+    /// Tells mesh members of topic except `from` not to send the message
+    void sendIDontWant(const PeerContextPtr &from,
+                       const TopicId &topic,
+                       const MessageId &msg_id);
+
     /// Periodic job needed to update meshes and shift "I have" caches
     void onHeartbeat();
 
@@ -64,6 +70,7 @@ namespace libp2p::protocol::gossip {
 
     const Config &config_;
     Connectivity &connectivity_;
+    Score &score_;
     basic::Scheduler &scheduler_;
 
     // TODO(artem): bound table size (which may grow!)
@@ -0,0 +1,272 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "score.hpp"
+
+#include <algorithm>
+
+namespace libp2p::protocol::gossip {
+
+  namespace {
+
+    void decayCounter(double &counter, double decay, double decay_to_zero) {
+      counter *= decay;
+      if (counter < decay_to_zero) {
+        counter = 0;
+      }
+    }
+
+  }  // namespace
+
+  Score::Score(const ScoreConfig &config) : config_(config) {}
+
+  bool Score::enabled() const {
+    return config_.enabled;
+  }
+
+  double Score::score(const peer::PeerId &peer) const {
+    if (!config_.enabled) {
+      return 0;
+    }
+    auto it = peers_.find(peer);
+    if (it == peers_.end()) {
+      return 0;
+    }
+    const auto &stats = it->second;
+
+    double score = 0;
+    for (const auto &[topic, t] : stats.topics) {
+      const auto &p = params(topic);
+      double topic_score = 0;
+
+      if (t.in_mesh) {
+        auto quantums = static_cast<double>(t.mesh_time.count())
+                      / static_cast<double>(p.time_in_mesh_quantum.count());
+        topic_score +=
+            std::min(quantums, p.time_in_mesh_cap) * p.time_in_mesh_weight;
+      }
+
+      topic_score +=
+          t.first_message_deliveries * p.first_message_deliveries_weight;
+
+      if (t.mesh_message_deliveries_active
+          && t.mesh_message_deliveries < p.mesh_message_deliveries_threshold) {
+        auto deficit =
+            p.mesh_message_deliveries_threshold - t.mesh_message_deliveries;
+        topic_score += deficit * deficit * p.mesh_message_deliveries_weight;
+      }
+
+      topic_score += t.mesh_failure_penalty * p.mesh_failure_penalty_weight;
+
+      topic_score += t.invalid_message_deliveries * t.invalid_message_deliveries
+                   * p.invalid_message_deliveries_weight;
+
+      score += topic_score * p.topic_weight;
+    }
+
+    if (config_.topic_score_cap > 0) {
+      score = std::min(score, config_.topic_score_cap);
+    }
+
+    if (!stats.ip.empty()) {
+      auto ip_it = peers_per_ip_.find(stats.ip);
+      if (ip_it != peers_per_ip_.end()
+          && ip_it->second > config_.ip_colocation_factor_threshold) {
+        auto surplus = static_cast<double>(
+            ip_it->second - config_.ip_colocation_factor_threshold);
+        score += surplus * surplus * config_.ip_colocation_factor_weight;
+      }
+    }
+
+    if (stats.behaviour_penalty > config_.behaviour_penalty_threshold) {
+      auto excess =
+          stats.behaviour_penalty - config_.behaviour_penalty_threshold;
+      score += excess * excess * config_.behaviour_penalty_weight;
+    }
+
+    return score;
+  }
+
+  void Score::connect(const peer::PeerId &peer, const std::string &ip) {
+    auto &stats = peers_[peer];
+    if (stats.connected) {
+      return;
+    }
+    stats.connected = true;
+    stats.expires = Time::zero();
+    stats.ip = ip;
+    if (!ip.empty()) {
+      ++peers_per_ip_[ip];
+    }
+  }
+
+  void Score::disconnect(const peer::PeerId &peer, Time now) {
+    auto it = peers_.find(peer);
+    if (it == peers_.end() || !it->second.connected) {
+      return;
+    }
+    auto &stats = it->second;
+    stats.connected = false;
+    stats.expires = now + config_.retain_score;
+    if (!stats.ip.empty()) {
+      auto ip_it = peers_per_ip_.find(stats.ip);
+      if (ip_it != peers_per_ip_.end() && --ip_it->second == 0) {
+        peers_per_ip_.erase(ip_it);
+      }
+    }
+    for (auto &[topic, t] : stats.topics) {
+      if (t.in_mesh) {
+        prune(peer, topic);
+      }
+    }
+  }
+
+  void Score::graft(const peer::PeerId &peer, const TopicId &topic, Time now) {
+    auto &t = peers_[peer].topics[topic];
+    t.in_mesh = true;
+    t.graft_time = now;
+    t.mesh_time = Time::zero();
+    t.mesh_message_deliveries_active = false;
+  }
+
+  void Score::prune(const peer::PeerId &peer, const TopicId &topic) {
+    auto it = peers_.find(peer);
+    if (it == peers_.end()) {
+      return;
+    }
+    auto topic_it = it->second.topics.find(topic);
+    if (topic_it == it->second.topics.end()) {
+      return;
+    }
+    auto &t = topic_it->second;
+    const auto &p = params(topic);
+    if (t.mesh_message_deliveries_active
+        && t.mesh_message_deliveries < p.mesh_message_deliveries_threshold) {
+      auto deficit =
+          p.mesh_message_deliveries_threshold - t.mesh_message_deliveries;
+      t.mesh_failure_penalty += deficit * deficit;
+    }
+    t.in_mesh = false;
+    t.mesh_message_deliveries_active = false;
+  }
+
+  void Score::deliverMessage(const peer::PeerId &from,
+                             const TopicId &topic,
+                             const MessageId &msg_id,
+                             Time now) {
+    const auto &p = params(topic);
+    auto &t = peers_[from].topics[topic];
+    t.first_message_deliveries = std::min(t.first_message_deliveries + 1,
+                                          p.first_message_deliveries_cap);
+    meshDelivery(from, topic);
+
+    if (deliveries_.emplace(msg_id, Delivery{now, {from}}).second) {
+      deliveries_expiration_.emplace_back(
+          now + p.mesh_message_deliveries_window, msg_id);
+    }
+  }
+
+  void Score::duplicateMessage(const peer::PeerId &from,
+                               const TopicId &topic,
+                               const MessageId &msg_id,
+                               Time now) {
+    auto it = deliveries_.find(msg_id);
+    if (it == deliveries_.end()) {
+      return;
+    }
+    auto &delivery = it->second;
+    auto window = params(topic).mesh_message_deliveries_window;
+    if (now > delivery.first_seen + window
+        || std::find(delivery.peers.begin(), delivery.peers.end(), from)
+               != delivery.peers.end()) {
+      return;
+    }
+    delivery.peers.push_back(from);
+    meshDelivery(from, topic);
+  }
+
+  void Score::rejectMessage(const peer::PeerId &from, const TopicId &topic) {
+    ++peers_[from].topics[topic].invalid_message_deliveries;
+  }
+
+  void Score::addPenalty(const peer::PeerId &peer, double count) {
+    peers_[peer].behaviour_penalty += count;
+  }
+
+  void Score::onHeartbeat(Time now) {
+    while (!deliveries_expiration_.empty()
+           && deliveries_expiration_.front().first < now) {
+      deliveries_.erase(deliveries_expiration_.front().second);
+      deliveries_expiration_.pop_front();
+    }
+
+    for (auto it = peers_.begin(); it != peers_.end();) {
+      if (!it->second.connected && it->second.expires < now) {
+        it = peers_.erase(it);
+        continue;
+      }
+      for (auto &[topic, t] : it->second.topics) {
+        if (!t.in_mesh) {
+          continue;
+        }
+        t.mesh_time = now - t.graft_time;
+        if (t.mesh_time >= params(topic).mesh_message_deliveries_activation) {
+          t.mesh_message_deliveries_active = true;
+        }
+      }
+      ++it;
+    }
+
+    if (next_decay_ == Time::zero()) {
+      next_decay_ = now + config_.decay_interval;
+    }
+    while (next_decay_ <= now) {
+      decay();
+      next_decay_ += config_.decay_interval;
+    }
+  }
+
+  const TopicScoreParams &Score::params(const TopicId &topic) const {
+    auto it = config_.topic_params.find(topic);
+    if (it != config_.topic_params.end()) {
+      return it->second;
+    }
+    return config_.default_topic_params;
+  }
+
+  void Score::meshDelivery(const peer::PeerId &peer, const TopicId &topic) {
+    auto &t = peers_[peer].topics[topic];
+    if (!t.in_mesh) {
+      return;
+    }
+    const auto &p = params(topic);
+    t.mesh_message_deliveries = std::min(t.mesh_message_deliveries + 1,
+                                         p.mesh_message_deliveries_cap);
+  }
+
+  void Score::decay() {
+    auto to_zero = config_.decay_to_zero;
+    for (auto &[_, stats] : peers_) {
+      for (auto &[topic, t] : stats.topics) {
+        const auto &p = params(topic);
+        decayCounter(t.first_message_deliveries,
+                     p.first_message_deliveries_decay,
+                     to_zero);
+        decayCounter(t.mesh_message_deliveries,
+                     p.mesh_message_deliveries_decay,
+                     to_zero);
+        decayCounter(
+            t.mesh_failure_penalty, p.mesh_failure_penalty_decay, to_zero);
+        decayCounter(t.invalid_message_deliveries,
+                     p.invalid_message_deliveries_decay,
+                     to_zero);
+      }
+      decayCounter(
+          stats.behaviour_penalty, config_.behaviour_penalty_decay, to_zero);
+    }
+  }
+
+}  // namespace libp2p::protocol::gossip
@@ -0,0 +1,108 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <deque>
+#include <unordered_map>
+
+#include "common.hpp"
+
+namespace libp2p::protocol::gossip {
+
+  /// Gossipsub v1.1 peer score. Counters are updated on protocol events and
+  /// decayed on heartbeat, score is computed from them on demand
+  class Score {
+   public:
+    explicit Score(const ScoreConfig &config);
+
+    /// Returns true if scoring is enabled in config
+    bool enabled() const;
+
+    /// Returns score of peer, 0 for unknown peers
+    double score(const peer::PeerId &peer) const;
+
+    /// Peer connected, `ip` may be empty if unknown
+    void connect(const peer::PeerId &peer, const std::string &ip);
+
+    /// Peer disconnected, its score is retained for a while
+    void disconnect(const peer::PeerId &peer, Time now);
+
+    /// Peer added to mesh of topic
+    void graft(const peer::PeerId &peer, const TopicId &topic, Time now);
+
+    /// Peer removed from mesh of topic
+    void prune(const peer::PeerId &peer, const TopicId &topic);
+
+    /// First delivery of valid message
+    void deliverMessage(const peer::PeerId &from,
+                        const TopicId &topic,
+                        const MessageId &msg_id,
+                        Time now);
+
+    /// Duplicate of already delivered message
+    void duplicateMessage(const peer::PeerId &from,
+                          const TopicId &topic,
+                          const MessageId &msg_id,
+                          Time now);
+
+    /// Invalid message delivered
+    void rejectMessage(const peer::PeerId &from, const TopicId &topic);
+
+    /// Protocol misbehaviour
+    void addPenalty(const peer::PeerId &peer, double count = 1.0);
+
+    /// Decays counters and forgets expired peers and deliveries
+    void onHeartbeat(Time now);
+
+   private:
+    struct TopicStats {
+      bool in_mesh = false;
+      Time graft_time{0};
+      Time mesh_time{0};
+      double first_message_deliveries = 0;
+      double mesh_message_deliveries = 0;
+      bool mesh_message_deliveries_active = false;
+      double mesh_failure_penalty = 0;
+      double invalid_message_deliveries = 0;
+    };
+
+    struct PeerStats {
+      bool connected = false;
+      /// Disconnected peer is forgotten after this time
+      Time expires{0};
+      std::string ip;
+      std::unordered_map<TopicId, TopicStats> topics;
+      double behaviour_penalty = 0;
+    };
+
+    /// Peers which delivered message within delivery window
+    struct Delivery {
+      Time first_seen;
+      std::vector<peer::PeerId> peers;
+    };
+
+    const TopicScoreParams &params(const TopicId &topic) const;
+
+    /// Counts delivery of message by mesh peer
+    void meshDelivery(const peer::PeerId &peer, const TopicId &topic);
+
+    /// Applies decays to counters
+    void decay();
+
+    const ScoreConfig &config_;
+    std::unordered_map<peer::PeerId, PeerStats> peers_;
+
+    /// Number of connected peers per IP address
+    std::unordered_map<std::string, size_t> peers_per_ip_;
+
+    std::unordered_map<MessageId, Delivery> deliveries_;
+    std::deque<std::pair<Time, MessageId>> deliveries_expiration_;
+
+    Time next_decay_{0};
+  };
+
+}  // namespace libp2p::protocol::gossip
@@ -0,0 +1,100 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+#include <variant>
+
+#include "common.hpp"
+
+namespace libp2p::protocol::gossip {
+
+  /// Number of time buckets entries of SeenTable are expired by
+  constexpr size_t kSeenTableBuckets = 64;
+
+  /// Hash table of message ids which expire by time buckets. Insert, lookup
+  /// and expiration (amortized) are O(1). Entries live for `lifetime` at least
+  /// and for `lifetime` plus bucket duration at most
+  template <typename Value>
+  class SeenTable {
+   public:
+    explicit SeenTable(Time lifetime, size_t buckets = kSeenTableBuckets)
+        : lifetime_{lifetime},
+          bucket_duration_{std::max(
+              Time{1}, lifetime / static_cast<Time::rep>(buckets))} {}
+
+    bool contains(const MessageId &id) const {
+      return table_.count(id) != 0;
+    }
+
+    /// Returns value of entry or nullptr if not found
+    const Value *find(const MessageId &id) const {
+      auto it = table_.find(id);
+      if (it == table_.end()) {
+        return nullptr;
+      }
+      return &it->second;
+    }
+
+    /// Inserts entry seen at `now`, returns false if it already exists
+    bool insert(const MessageId &id, Value value, Time now) {
+      if (!table_.emplace(id, std::move(value)).second) {
+        return false;
+      }
+      if (buckets_.empty() || buckets_.back().ends <= now) {
+        buckets_.push_back({now + bucket_duration_, {}});
+      }
+      buckets_.back().ids.push_back(id);
+      return true;
+    }
+
+    /// Removes entries expired by `now`
+    void expire(Time now) {
+      while (!buckets_.empty() && buckets_.front().ends + lifetime_ <= now) {
+        for (auto &id : buckets_.front().ids) {
+          table_.erase(id);
+        }
+        buckets_.pop_front();
+      }
+    }
+
+    /// Calls `f(id)` for ids from newest to oldest while it returns true
+    template <typename F>
+    void forEachNewest(const F &f) const {
+      for (auto bucket = buckets_.rbegin(); bucket != buckets_.rend();
+           ++bucket) {
+        for (auto id = bucket->ids.rbegin(); id != bucket->ids.rend(); ++id) {
+          if (!f(*id)) {
+            return;
+          }
+        }
+      }
+    }
+
+    size_t size() const {
+      return table_.size();
+    }
+
+   private:
+    struct Bucket {
+      /// Entries are inserted into bucket until this time
+      Time ends;
+      std::vector<MessageId> ids;
+    };
+
+    const Time lifetime_;
+    const Time bucket_duration_;
+    std::unordered_map<MessageId, Value> table_;
+    std::deque<Bucket> buckets_;
+  };
+
+  /// Set of seen message ids
+  using SeenSet = SeenTable<std::monostate>;
+
+}  // namespace libp2p::protocol::gossip
@@ -122,7 +122,7 @@ namespace libp2p::protocol::gossip {
     read();
   }
 
-  void Stream::write(outcome::result<SharedBuffer> serialization_res) {
+  void Stream::write(outcome::result<SharedBuffers> serialization_res) {
     if (closed_) {
       return;
     }
@@ -137,16 +137,18 @@ namespace libp2p::protocol::gossip {
       return;
     }
 
-    auto &buffer = serialization_res.value();
-    if (buffer->empty()) {
-      return;
-    }
+    // buffers are written in order, so they reach wire as one message
+    for (auto &buffer : serialization_res.value()) {
+      if (buffer->empty()) {
+        continue;
+      }
 
-    if (writing_bytes_ > 0) {
-      pending_bytes_ += buffer->size();
-      pending_buffers_.emplace_back(std::move(buffer));
-    } else {
-      beginWrite(std::move(buffer));
+      if (writing_bytes_ > 0) {
+        pending_bytes_ += buffer->size();
+        pending_buffers_.emplace_back(std::move(buffer));
+      } else {
+        beginWrite(std::move(buffer));
+      }
     }
   }
 
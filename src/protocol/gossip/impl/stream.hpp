@@ -43,7 +43,7 @@ namespace libp2p::protocol::gossip {
 
     /// Writes an outgoing message to stream, if there is serialization error
     /// it will be posted in asynchronous manner
-    void write(outcome::result<SharedBuffer> serialization_res);
+    void write(outcome::result<SharedBuffers> serialization_res);
 
     /// Closes the reader so that it will ignore further bytes from wire
     void close();
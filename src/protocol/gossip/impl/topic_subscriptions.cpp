@@ -32,12 +32,15 @@ namespace libp2p::protocol::gossip {
   TopicSubscriptions::TopicSubscriptions(TopicId topic,
                                          const Config &config,
                                          Connectivity &connectivity,
+                                         Score &score,
                                          log::SubLogger &log)
       : topic_(std::move(topic)),
         config_(config),
         connectivity_(connectivity),
+        score_(score),
         self_subscribed_(false),
         fanout_period_ends_(0),
+        seen_cache_(config.seen_cache_lifetime_msec),
         log_(log) {}
 
   bool TopicSubscriptions::empty() const {
@@ -51,6 +54,11 @@ namespace libp2p::protocol::gossip {
       const TopicMessage::Ptr &msg,
       const MessageId &msg_id,
       Time now) {
+    if (!seen_cache_.insert(msg_id, {}, now)) {
+      log_.debug("message already forwarded, topic={}", topic_);
+      return;
+    }
+
     bool is_published_locally = !from.has_value();
 
     if (is_published_locally) {
@@ -67,7 +75,15 @@ namespace libp2p::protocol::gossip {
         [this, &msg, &msg_id, &from, &origin](const PeerContextPtr &ctx) {
           assert(ctx->message_builder);
 
-          if (needToForward(ctx, from, origin)) {
+          // local messages are not published to badly scored peers
+          if (!from
+              && score_.score(ctx->peer_id)
+                     < config_.score.publish_threshold) {
+            return;
+          }
+
+          if (needToForward(ctx, from, origin)
+              && ctx->dont_want.count(msg_id) == 0) {
             ctx->message_builder->addMessage(*msg, msg_id);
 
             // forward immediately to those in mesh
@@ -79,7 +95,8 @@ namespace libp2p::protocol::gossip {
     for (const auto &ctx : peers) {
       assert(ctx->message_builder);
 
-      if (needToForward(ctx, from, origin)) {
+      if (needToForward(ctx, from, origin) && acceptsGossip(ctx)
+          && ctx->dont_want.count(msg_id) == 0) {
         ctx->message_builder->addIHave(topic_, msg_id);
 
         // local messages announce themselves immediately
@@ -87,40 +104,29 @@ namespace libp2p::protocol::gossip {
       }
     }
 
-    seen_cache_.emplace_back(now + config_.seen_cache_lifetime_msec, msg_id);
-
     log_.debug("message forwarded, topic={}, m={}, s={}",
                topic_,
                mesh_peers_.size(),
                subscribed_peers_.size());
   }
 
-  void TopicSubscriptions::onHeartbeat(Time now) {
-    if (self_subscribed_ && !subscribed_peers_.empty()) {
-      // add/remove mesh members according to desired network density D
-      size_t sz = mesh_peers_.size();
-
-      if (sz < config_.D_min) {
-        auto peers = subscribed_peers_.selectRandomPeers(config_.D_min - sz);
-        for (auto &p : peers) {
-          auto it = dont_bother_until_.find(p);
-          if (it != dont_bother_until_.end()) {
-            if (it->second < now) {
-              dont_bother_until_.erase(it);
-            } else {
-              continue;
-            }
-          }
+  void TopicSubscriptions::sendIDontWant(const PeerContextPtr &from,
+                                         const MessageId &msg_id) {
+    mesh_peers_.selectAll([this, &from, &msg_id](const PeerContextPtr &ctx) {
+      if (ctx == from || ctx->protocol != kProtocolVersionIDontWant) {
+        return;
+      }
+      ctx->message_builder->addIDontWant(msg_id);
+      connectivity_.peerIsWritable(ctx, true);
+    });
+  }
 
-          addToMesh(p);
-          subscribed_peers_.erase(p->peer_id);
-        }
-      } else if (sz > config_.D_max) {
-        auto peers = mesh_peers_.selectRandomPeers(sz - config_.D_max);
-        for (auto &p : peers) {
-          removeFromMesh(p);
-          mesh_peers_.erase(p->peer_id);
-        }
+  void TopicSubscriptions::onHeartbeat(Time now) {
+    if (self_subscribed_) {
+      if (score_.enabled()) {
+        maintainScoredMesh(now);
+      } else if (!subscribed_peers_.empty()) {
+        maintainMesh(now);
       }
     }
 
@@ -133,24 +139,8 @@ namespace libp2p::protocol::gossip {
 
     // shift msg ids cache
     auto seen_cache_size = seen_cache_.size();
-    bool changed = false;
-
-    if (seen_cache_size > config_.seen_cache_limit) {
-      auto b = seen_cache_.begin();
-      auto e = b + ssize_t(seen_cache_size - config_.seen_cache_limit);
-      seen_cache_.erase(b, e);
-      changed = true;
-    } else if (seen_cache_size != 0) {
-      auto it = std::find_if(seen_cache_.begin(),
-                             seen_cache_.end(),
-                             [now](const auto &p) { return p.first >= now; });
-      if (it != seen_cache_.begin()) {
-        seen_cache_.erase(seen_cache_.begin(), it);
-        changed = true;
-      }
-    }
-
-    if (changed) {
+    seen_cache_.expire(now);
+    if (seen_cache_.size() != seen_cache_size) {
       log_.debug("seen cache size changed {}->{} for {}",
                  seen_cache_size,
                  seen_cache_.size(),
@@ -158,6 +148,81 @@ namespace libp2p::protocol::gossip {
     }
   }
 
+  void TopicSubscriptions::maintainMesh(Time now) {
+    // add/remove mesh members according to desired network density D
+    size_t sz = mesh_peers_.size();
+
+    if (sz < config_.D_min) {
+      auto peers = subscribed_peers_.selectRandomPeers(config_.D_min - sz);
+      for (auto &p : peers) {
+        if (inBackoff(p, now)) {
+          continue;
+        }
+        addToMesh(p, now);
+        subscribed_peers_.erase(p->peer_id);
+      }
+    } else if (sz > config_.D_max) {
+      auto peers = mesh_peers_.selectRandomPeers(sz - config_.D_max);
+      for (auto &p : peers) {
+        removeFromMesh(p);
+        mesh_peers_.erase(p->peer_id);
+      }
+    }
+  }
+
+  void TopicSubscriptions::maintainScoredMesh(Time now) {
+    // peers with negative score are removed from mesh
+    std::vector<PeerContextPtr> negative;
+    mesh_peers_.selectIf(
+        [&negative](const PeerContextPtr &p) { negative.push_back(p); },
+        [this](const PeerContextPtr &p) {
+          return score_.score(p->peer_id) < 0;
+        });
+    for (auto &p : negative) {
+      removeFromMesh(p);
+      mesh_peers_.erase(p->peer_id);
+    }
+
+    size_t sz = mesh_peers_.size();
+
+    if (sz < config_.D_min) {
+      // candidates are tried in random order
+      auto peers =
+          subscribed_peers_.selectRandomPeers(subscribed_peers_.size());
+      for (auto &p : peers) {
+        if (mesh_peers_.size() >= config_.D_min) {
+          break;
+        }
+        if (inBackoff(p, now) || score_.score(p->peer_id) < 0) {
+          continue;
+        }
+        addToMesh(p, now);
+        subscribed_peers_.erase(p->peer_id);
+      }
+    } else if (sz > config_.D_max) {
+      // the worst scored peers are removed
+      auto peers = mesh_peers_.selectRandomPeers(sz);
+      std::vector<std::pair<double, PeerContextPtr>> scored;
+      scored.reserve(peers.size());
+      for (auto &p : peers) {
+        scored.emplace_back(score_.score(p->peer_id), std::move(p));
+      }
+      std::stable_sort(
+          scored.begin(), scored.end(), [](const auto &a, const auto &b) {
+            return a.first < b.first;
+          });
+      for (size_t i = 0; i < sz - config_.D_max; ++i) {
+        removeFromMesh(scored[i].second);
+        mesh_peers_.erase(scored[i].second->peer_id);
+      }
+    }
+
+    auto ticks = config_.score.opportunistic_graft_ticks;
+    if (ticks != 0 && ++heartbeats_ % ticks == 0) {
+      opportunisticGraft(now);
+    }
+  }
+
   void TopicSubscriptions::onSelfSubscribed(bool self_subscribed) {
     self_subscribed_ = self_subscribed;
     if (!self_subscribed_) {
@@ -175,8 +240,16 @@ namespace libp2p::protocol::gossip {
     subscribed_peers_.insert(p);
 
     // announce the peer about messages available for the topic
-    for (const auto &[_, msg_id] : seen_cache_) {
-      p->message_builder->addIHave(topic_, msg_id);
+    if (acceptsGossip(p)) {
+      size_t announced = 0;
+      seen_cache_.forEachNewest([&](const MessageId &msg_id) {
+        if (announced == config_.seen_cache_limit) {
+          return false;
+        }
+        p->message_builder->addIHave(topic_, msg_id);
+        ++announced;
+        return true;
+      });
     }
     // will be sent on next heartbeat
     connectivity_.peerIsWritable(p, false);
@@ -186,11 +259,14 @@ namespace libp2p::protocol::gossip {
     auto res = subscribed_peers_.erase(p->peer_id);
     if (!res) {
       res = mesh_peers_.erase(p->peer_id);
+      if (res) {
+        score_.prune(p->peer_id, topic_);
+      }
     }
     dont_bother_until_.erase(p);
   }
 
-  void TopicSubscriptions::onGraft(const PeerContextPtr &p) {
+  void TopicSubscriptions::onGraft(const PeerContextPtr &p, Time now) {
     auto res = mesh_peers_.find(p->peer_id);
     if (res) {
       // already there
@@ -205,9 +281,21 @@ namespace libp2p::protocol::gossip {
 
     bool mesh_is_full = (mesh_peers_.size() >= config_.D_max);
 
-    if (self_subscribed_ && !mesh_is_full) {
+    bool rejected = false;
+    if (score_.enabled()) {
+      if (inBackoff(p, now)) {
+        // peer pruned this host and grafts again too early
+        score_.addPenalty(p->peer_id);
+        rejected = true;
+      } else {
+        rejected = score_.score(p->peer_id) < 0;
+      }
+    }
+
+    if (self_subscribed_ && !mesh_is_full && !rejected) {
       mesh_peers_.insert(p);
       subscribed_peers_.erase(p->peer_id);
+      score_.graft(p->peer_id, topic_, now);
     } else {
       // we don't have mesh for the topic
       p->message_builder->addPrune(topic_);
@@ -217,19 +305,22 @@ namespace libp2p::protocol::gossip {
 
   void TopicSubscriptions::onPrune(const PeerContextPtr &p,
                                    Time dont_bother_until) {
-    mesh_peers_.erase(p->peer_id);
+    if (mesh_peers_.erase(p->peer_id)) {
+      score_.prune(p->peer_id, topic_);
+    }
     if (p->subscribed_to.count(topic_) != 0) {
       subscribed_peers_.insert(p);
       dont_bother_until_.insert({p, dont_bother_until});
     }
   }
 
-  void TopicSubscriptions::addToMesh(const PeerContextPtr &p) {
+  void TopicSubscriptions::addToMesh(const PeerContextPtr &p, Time now) {
     assert(p->message_builder);
 
     p->message_builder->addGraft(topic_);
     connectivity_.peerIsWritable(p, false);
     mesh_peers_.insert(p);
+    score_.graft(p->peer_id, topic_, now);
     log_.debug("peer {} added to mesh (size={}) for topic {}",
                p->str,
                mesh_peers_.size(),
@@ -242,10 +333,63 @@ namespace libp2p::protocol::gossip {
     p->message_builder->addPrune(topic_);
     connectivity_.peerIsWritable(p, false);
     subscribed_peers_.insert(p);
+    score_.prune(p->peer_id, topic_);
     log_.debug("peer {} removed from mesh (size={}) for topic {}",
                p->str,
                mesh_peers_.size(),
                topic_);
   }
 
+  bool TopicSubscriptions::inBackoff(const PeerContextPtr &p, Time now) {
+    auto it = dont_bother_until_.find(p);
+    if (it == dont_bother_until_.end()) {
+      return false;
+    }
+    if (it->second < now) {
+      dont_bother_until_.erase(it);
+      return false;
+    }
+    return true;
+  }
+
+  bool TopicSubscriptions::acceptsGossip(const PeerContextPtr &p) const {
+    return score_.score(p->peer_id) >= config_.score.gossip_threshold;
+  }
+
+  void TopicSubscriptions::opportunisticGraft(Time now) {
+    std::vector<double> scores;
+    mesh_peers_.selectAll([this, &scores](const PeerContextPtr &p) {
+      scores.push_back(score_.score(p->peer_id));
+    });
+    if (scores.empty()) {
+      return;
+    }
+    auto middle = scores.begin() + ssize_t(scores.size() / 2);
+    std::nth_element(scores.begin(), middle, scores.end());
+    auto median = *middle;
+    if (median >= config_.score.opportunistic_graft_threshold) {
+      return;
+    }
+
+    size_t grafted = 0;
+    auto peers = subscribed_peers_.selectRandomPeers(subscribed_peers_.size());
+    for (auto &p : peers) {
+      if (grafted >= config_.score.opportunistic_graft_peers) {
+        break;
+      }
+      if (inBackoff(p, now) || score_.score(p->peer_id) <= median) {
+        continue;
+      }
+      addToMesh(p, now);
+      subscribed_peers_.erase(p->peer_id);
+      ++grafted;
+    }
+    if (grafted != 0) {
+      log_.debug("opportunistically grafted {} peers, median score {} for {}",
+                 grafted,
+                 median,
+                 topic_);
+    }
+  }
+
 }  // namespace libp2p::protocol::gossip
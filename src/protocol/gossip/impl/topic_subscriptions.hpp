@@ -6,11 +6,11 @@
 
 #pragma once
 
-#include <deque>
-
 #include <libp2p/log/sublogger.hpp>
 
 #include "peer_set.hpp"
+#include "score.hpp"
+#include "seen_table.hpp"
 
 namespace libp2p::protocol::gossip {
 
@@ -24,6 +24,7 @@ namespace libp2p::protocol::gossip {
     TopicSubscriptions(TopicId topic,
                        const Config &config,
                        Connectivity &connectivity,
+                       Score &score,
                        log::SubLogger &log);
 
     /// Returns true if no peers subscribed and not self-subscribed and
@@ -36,6 +37,10 @@ namespace libp2p::protocol::gossip {
                       const MessageId &msg_id,
                       Time now);
 
+    /// Tells mesh members except `from` not to send the message, if their
+    /// protocol version supports it
+    void sendIDontWant(const PeerContextPtr &from, const MessageId &msg_id);
+
     /// Periodic job needed to update meshes and shift "I have" caches
     void onHeartbeat(Time now);
 
@@ -49,21 +54,37 @@ namespace libp2p::protocol::gossip {
     void onPeerUnsubscribed(const PeerContextPtr &p);
 
     /// Remote peer includes this host into its mesh
-    void onGraft(const PeerContextPtr &p);
+    void onGraft(const PeerContextPtr &p, Time now);
 
     /// Remote peer kicks this host out of its mesh
     void onPrune(const PeerContextPtr &p, Time dont_bother_until);
 
    private:
     /// Adds a peer to mesh
-    void addToMesh(const PeerContextPtr &p);
+    void addToMesh(const PeerContextPtr &p, Time now);
 
     /// Removes a peer from mesh
     void removeFromMesh(const PeerContextPtr &p);
 
+    /// Keeps mesh size between D_min and D_max with random peers
+    void maintainMesh(Time now);
+
+    /// Prunes negatively scored mesh peers, grafts and prunes by score
+    void maintainScoredMesh(Time now);
+
+    /// Returns true if peer asked not to graft it until some time after `now`
+    bool inBackoff(const PeerContextPtr &p, Time now);
+
+    /// Returns true if gossip may be exchanged with peer
+    bool acceptsGossip(const PeerContextPtr &p) const;
+
+    /// Grafts peers scored above mesh median if the median is low
+    void opportunisticGraft(Time now);
+
     const TopicId topic_;
     const Config &config_;
     Connectivity &connectivity_;
+    Score &score_;
 
     /// This host subscribed to this topic or not, this affects mesh behavior
     bool self_subscribed_;
@@ -77,12 +98,16 @@ namespace libp2p::protocol::gossip {
     /// Mesh members to whom messages are forwarded in push manner
     PeerSet mesh_peers_;
 
-    /// "I have" notifications for new subscribers aka seen messages cache
-    std::deque<std::pair<Time, MessageId>> seen_cache_;
+    /// Messages seen in topic, used for dedup and "I have" notifications
+    /// for new subscribers
+    SeenSet seen_cache_;
 
     /// Prune backoff times per peer
     std::unordered_map<PeerContextPtr, Time> dont_bother_until_;
 
+    /// Heartbeats counter for opportunistic grafting
+    size_t heartbeats_ = 0;
+
     log::SubLogger &log_;
   };
 
@@ -0,0 +1,48 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/crypto_thread_pool.hpp>
+
+#include <boost/asio/post.hpp>
+
+namespace libp2p::security {
+
+  CryptoThreadPool::CryptoThreadPool(
+      std::shared_ptr<boost::asio::io_context> io_context, Config config)
+      : io_context_{std::move(io_context)} {
+    if (config.threads != 0) {
+      pool_.emplace(config.threads);
+    }
+  }
+
+  CryptoThreadPool::~CryptoThreadPool() {
+    if (pool_) {
+      pool_->stop();
+      pool_->join();
+    }
+  }
+
+  void CryptoThreadPool::post(std::function<void()> work,
+                              std::function<void()> done) {
+    if (!pool_) {
+      work();
+      done();
+      return;
+    }
+    boost::asio::post(*pool_,
+                      [io_context{io_context_},
+                       work{std::move(work)},
+                       done{std::move(done)}]() mutable {
+                        work();
+                        boost::asio::post(*io_context, std::move(done));
+                      });
+  }
+
+  bool CryptoThreadPool::concurrent() const {
+    return pool_.has_value();
+  }
+
+}  // namespace libp2p::security
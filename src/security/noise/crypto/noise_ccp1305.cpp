@@ -15,11 +15,11 @@ namespace libp2p::security::noise {
                                                    uint64_t nonce,
                                                    BytesIn plaintext,
                                                    BytesIn aad) {
-    auto n = ccp_->uint64toNonce(nonce);
-    OUTCOME_TRY(enc, ccp_->encrypt(n, plaintext, aad));
-    auto res = spanToVec(precompiled_out);
-    res.reserve(res.size() + enc.size());
-    res.insert(res.end(), enc.begin(), enc.end());
+    auto prefix = precompiled_out.size();
+    Bytes res(prefix + plaintext.size() + crypto::chachapoly::kTagSize);
+    std::copy(precompiled_out.begin(), precompiled_out.end(), res.begin());
+    OUTCOME_TRY(n, seal(nonce, plaintext, aad, BytesOut{res}.subspan(prefix)));
+    res.resize(prefix + n);
     return res;
   }
 
@@ -27,14 +27,28 @@ namespace libp2p::security::noise {
                                                    uint64_t nonce,
                                                    BytesIn ciphertext,
                                                    BytesIn aad) {
-    auto n = ccp_->uint64toNonce(nonce);
-    OUTCOME_TRY(dec, ccp_->decrypt(n, ciphertext, aad));
-    auto res = spanToVec(precompiled_out);
-    res.reserve(res.size() + dec.size());
-    res.insert(res.end(), dec.begin(), dec.end());
+    auto prefix = precompiled_out.size();
+    Bytes res(prefix + ciphertext.size());
+    std::copy(precompiled_out.begin(), precompiled_out.end(), res.begin());
+    OUTCOME_TRY(n, open(nonce, ciphertext, aad, BytesOut{res}.subspan(prefix)));
+    res.resize(prefix + n);
     return res;
   }
 
+  outcome::result<size_t> NoiseCCP1305Impl::seal(uint64_t nonce,
+                                                 BytesIn plaintext,
+                                                 BytesIn aad,
+                                                 BytesOut out) {
+    return ccp_->seal(ccp_->uint64toNonce(nonce), plaintext, aad, out);
+  }
+
+  outcome::result<size_t> NoiseCCP1305Impl::open(uint64_t nonce,
+                                                 BytesIn ciphertext,
+                                                 BytesIn aad,
+                                                 BytesOut out) {
+    return ccp_->open(ccp_->uint64toNonce(nonce), ciphertext, aad, out);
+  }
+
   std::shared_ptr<AEADCipher> NamedCCPImpl::cipher(Key32 key) {
     return std::make_shared<NoiseCCP1305Impl>(key);
   }
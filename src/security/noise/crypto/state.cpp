@@ -76,6 +76,46 @@ namespace libp2p::security::noise {
     return dec_res;
   }
 
+  outcome::result<size_t> CipherState::seal(BytesIn plaintext,
+                                            BytesIn aad,
+                                            BytesOut out) {
+    auto res = cipher_->seal(nonce_, plaintext, aad, out);
+    ++nonce_;
+    return res;
+  }
+
+  outcome::result<size_t> CipherState::open(BytesIn ciphertext,
+                                            BytesIn aad,
+                                            BytesOut out) {
+    auto res = cipher_->open(nonce_, ciphertext, aad, out);
+    ++nonce_;
+    return res;
+  }
+
+  outcome::result<size_t> CipherState::sealFrames(BytesIn plaintext,
+                                                 BytesOut out) {
+    if (out.size() < framedSize(plaintext.size())) {
+      return Error::MESSAGE_TOO_LONG;
+    }
+    size_t written = 0;
+    do {
+      auto chunk = plaintext.first(std::min(plaintext.size(), kMaxPlainText));
+      plaintext = plaintext.subspan(chunk.size());
+      OUTCOME_TRY(n,
+                  seal(chunk, {}, out.subspan(written + kLengthPrefixSize)));
+      out[written] = static_cast<uint8_t>(n >> 8);
+      out[written + 1] = static_cast<uint8_t>(n);
+      written += kLengthPrefixSize + n;
+    } while (!plaintext.empty());
+    return written;
+  }
+
+  size_t CipherState::framedSize(size_t plaintext_size) {
+    auto frames = std::max<size_t>(
+        1, (plaintext_size + kMaxPlainText - 1) / kMaxPlainText);
+    return plaintext_size + frames * (kLengthPrefixSize + kTagSize);
+  }
+
   outcome::result<void> CipherState::rekey() {
     Key32 zeroed;
     memset(zeroed.data(), 0u, zeroed.size());
@@ -403,8 +443,11 @@ namespace libp2p::security::noise {
   }
 
   outcome::result<void> HandshakeState::writeMessageE(Bytes &out) {
-    OUTCOME_TRY(ephemeral_kp, symmetric_state_->cipherSuite()->generate());
-    local_ephemeral_kp_ = std::move(ephemeral_kp);
+    // keypair set via HandshakeStateConfig is used as is
+    if (local_ephemeral_kp_.pub.empty()) {
+      OUTCOME_TRY(ephemeral_kp, symmetric_state_->cipherSuite()->generate());
+      local_ephemeral_kp_ = std::move(ephemeral_kp);
+    }
     out.insert(out.end(),
                local_ephemeral_kp_.pub.begin(),
                local_ephemeral_kp_.pub.end());
@@ -64,7 +64,9 @@ namespace libp2p::security::noise {
       bool is_initiator,
       boost::optional<peer::PeerId> remote_peer_id,
       SecurityAdaptor::SecConnCallbackFunc cb,
-      std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller)
+      std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+      std::shared_ptr<HandshakeKeys> handshake_keys,
+      std::shared_ptr<CryptoExecutor> crypto_executor)
       : crypto_provider_{std::move(crypto_provider)},
         noise_marshaller_{std::move(noise_marshaller)},
         local_key_{std::move(local_key)},
@@ -72,6 +74,8 @@ namespace libp2p::security::noise {
         initiator_{is_initiator},
         connection_cb_{std::move(cb)},
         key_marshaller_{std::move(key_marshaller)},
+        handshake_keys_{std::move(handshake_keys)},
+        crypto_executor_{std::move(crypto_executor)},
         read_buffer_{std::make_shared<Bytes>(kMaxMsgLen)},
         rw_{std::make_shared<InsecureReadWriter>(conn_, read_buffer_)},
         handshake_state_{std::make_unique<HandshakeState>()},
@@ -80,10 +84,15 @@ namespace libp2p::security::noise {
   }
 
   void Handshake::connect() {
-    auto result = runHandshake();
-    if (result.has_error()) {
-      connection_cb_(result.error());
-    }
+    runCrypto(
+        crypto_executor_,
+        [self{shared_from_this()}] { return self->prepareHandshake(); },
+        [self{shared_from_this()}](outcome::result<Bytes> payload) {
+          if (payload.has_error()) {
+            return self->connection_cb_(payload.error());
+          }
+          self->runHandshake(std::move(payload.value()));
+        });
   }
 
   void Handshake::setCipherStates(std::shared_ptr<CipherState> cs1,
@@ -116,35 +125,61 @@ namespace libp2p::security::noise {
   }
 
   void Handshake::sendHandshakeMessage(BytesIn payload, CbOutcomeVoid cb) {
-    IO_OUTCOME_TRY(
-        write_result, handshake_state_->writeMessage({}, payload), cb);
-    auto write_cb = [self{shared_from_this()},
-                     cb{std::move(cb)},
-                     wr{write_result}](outcome::result<void> result) {
-      IF_ERROR_CB_RETURN(result);
-      if (wr.cs1 and wr.cs2) {
-        self->setCipherStates(wr.cs1, wr.cs2);
-      }
-      cb(outcome::success());
-    };
-    rw_->write(write_result.data, write_cb);
+    runCrypto(
+        crypto_executor_,
+        [self{shared_from_this()},
+         payload{Bytes{payload.begin(), payload.end()}}] {
+          return self->handshake_state_->writeMessage({}, payload);
+        },
+        [self{shared_from_this()}, cb{std::move(cb)}](
+            outcome::result<HandshakeState::MessagingResult> result) {
+          IO_OUTCOME_TRY(write_result, result, cb);
+          auto write_cb = [self,
+                           cb{std::move(cb)},
+                           wr{write_result}](outcome::result<void> result) {
+            IF_ERROR_CB_RETURN(result);
+            if (wr.cs1 and wr.cs2) {
+              self->setCipherStates(wr.cs1, wr.cs2);
+            }
+            cb(outcome::success());
+          };
+          self->rw_->write(write_result.data, write_cb);
+        });
   }
 
   void Handshake::readHandshakeMessage(
       basic::MessageReadWriter::ReadCallbackFunc cb) {
     auto read_cb = [self{shared_from_this()}, cb{std::move(cb)}](auto result) {
       IO_OUTCOME_TRY(buffer, result, cb);
-      IO_OUTCOME_TRY(rr, self->handshake_state_->readMessage({}, *buffer), cb);
-      if (rr.cs1 and rr.cs2) {
-        self->setCipherStates(rr.cs1, rr.cs2);
-      }
-      auto shared_data = std::make_shared<Bytes>();
-      shared_data->swap(rr.data);
-      cb(std::move(shared_data));
+      runCrypto(
+          self->crypto_executor_,
+          [self, buffer{buffer}] {
+            return self->handshake_state_->readMessage({}, *buffer);
+          },
+          [self, cb{std::move(cb)}](
+              outcome::result<HandshakeState::MessagingResult> result) {
+            IO_OUTCOME_TRY(rr, result, cb);
+            if (rr.cs1 and rr.cs2) {
+              self->setCipherStates(rr.cs1, rr.cs2);
+            }
+            auto shared_data = std::make_shared<Bytes>();
+            shared_data->swap(rr.data);
+            cb(std::move(shared_data));
+          });
     };
     rw_->read(read_cb);
   }
 
+  void Handshake::verifyRemoteHandshakePayload(std::shared_ptr<Bytes> payload,
+                                               CbOutcomeVoid cb) {
+    runCrypto(
+        crypto_executor_,
+        [self{shared_from_this()}, payload{std::move(payload)}] {
+          return self->handleRemoteHandshakePayload(*payload);
+        },
+        std::move(cb));
+  }
+
   outcome::result<void> Handshake::handleRemoteHandshakePayload(
       BytesIn payload) {
     OUTCOME_TRY(remote_payload, noise_marshaller_->unmarshal(payload));
@@ -180,19 +215,21 @@ namespace libp2p::security::noise {
     return outcome::success();
   }
 
-  outcome::result<void> Handshake::runHandshake() {
-    auto cipher_suite = defaultCipherSuite();
-    OUTCOME_TRY(keypair, cipher_suite->generate());
+  outcome::result<Bytes> Handshake::prepareHandshake() {
+    OUTCOME_TRY(static_key,
+                handshake_keys_->staticKey(
+                    local_key_.publicKey, [this](const DHKey &keypair) {
+                      return generateHandshakePayload(keypair);
+                    }));
+    OUTCOME_TRY(ephemeral_key, handshake_keys_->ephemeralKey());
     HandshakeStateConfig config(
-        defaultCipherSuite(), handshakeXX, initiator_, keypair);
+        defaultCipherSuite(), handshakeXX, initiator_, static_key.keypair);
+    config.setLocalEphemeralKeypair(std::move(ephemeral_key));
     OUTCOME_TRY(handshake_state_->init(std::move(config)));
-    OUTCOME_TRY(payload, generateHandshakePayload(keypair));
-    const size_t dh25519_len = 32;
-    const size_t poly1305_tag_size = 16;
-    const size_t length_prefix_size = 2;
-    size_t max_msg_size =
-        2 * dh25519_len + payload.size() + 2 * poly1305_tag_size;
-    std::vector<uint8_t> buffer(max_msg_size + length_prefix_size);
+    return std::move(static_key.payload);
+  }
+
+  void Handshake::runHandshake(Bytes payload) {
     if (initiator_) {
       //
       // Outgoing connection. Stage 0
@@ -209,21 +246,22 @@ namespace libp2p::security::noise {
             SL_TRACE(self->log_, "outgoing connection. stage 1");
             self->readHandshakeMessage([self, payload](auto result) {
               IO_OUTCOME_TRY(bytes_read, result, self->hscb);
-              auto handle_result =
-                  self->handleRemoteHandshakePayload(*bytes_read);
-              if (handle_result.has_error()) {
-                return self->hscb(handle_result.error());
-              }
-              //
-              // Outgoing connection. Stage 2
-              //
-              SL_TRACE(self->log_, "outgoing connection. stage 2");
-              self->sendHandshakeMessage(payload,
-                                         [self, to_write(payload.size())](
-                                             outcome::result<void> result) {
-                                           IF_ERROR_HSCB_RETURN(result);
-                                           self->hscb(true);
-                                         });
+              self->verifyRemoteHandshakePayload(
+                  bytes_read,
+                  [self, payload](outcome::result<void> handle_result) {
+                    if (handle_result.has_error()) {
+                      return self->hscb(handle_result.error());
+                    }
+                    //
+                    // Outgoing connection. Stage 2
+                    //
+                    SL_TRACE(self->log_, "outgoing connection. stage 2");
+                    self->sendHandshakeMessage(
+                        payload, [self](outcome::result<void> result) {
+                          IF_ERROR_HSCB_RETURN(result);
+                          self->hscb(true);
+                        });
+                  });
             });
           });
     } else {
@@ -254,17 +292,18 @@ namespace libp2p::security::noise {
                   self->readHandshakeMessage([self](auto result) {
                     IO_OUTCOME_TRY(plaintext, result, self->hscb);
                     // may be need to check that plaintext is non empty
-                    auto handle_result =
-                        self->handleRemoteHandshakePayload(*plaintext);
-                    if (handle_result.has_error()) {
-                      self->hscb(handle_result.error());
-                    }
-                    self->hscb(true);
+                    self->verifyRemoteHandshakePayload(
+                        plaintext,
+                        [self](outcome::result<void> handle_result) {
+                          if (handle_result.has_error()) {
+                            return self->hscb(handle_result.error());
+                          }
+                          self->hscb(true);
+                        });
                   });
                 });
           });
     }
-    return outcome::success();
   }
 
   void Handshake::hscb(outcome::result<bool> secured) {
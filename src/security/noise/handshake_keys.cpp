@@ -0,0 +1,86 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/noise/handshake_keys.hpp>
+
+#include <libp2p/security/noise/crypto/noise_dh.hpp>
+
+namespace libp2p::security::noise {
+
+  HandshakeKeys::HandshakeKeys(std::shared_ptr<CryptoExecutor> crypto_executor,
+                               size_t pool_size)
+      : crypto_executor_{std::move(crypto_executor)}, pool_size_{pool_size} {}
+
+  outcome::result<HandshakeKeys::StaticKey> HandshakeKeys::staticKey(
+      const crypto::PublicKey &identity, const MakePayload &make_payload) {
+    {
+      std::lock_guard lock{mutex_};
+      if (static_key_ && identity_ == identity) {
+        return *static_key_;
+      }
+    }
+    OUTCOME_TRY(keypair, NoiseDiffieHellmanImpl{}.generate());
+    OUTCOME_TRY(payload, make_payload(keypair));
+    StaticKey static_key{.keypair = std::move(keypair),
+                         .payload = std::move(payload)};
+    std::lock_guard lock{mutex_};
+    identity_ = identity;
+    static_key_ = static_key;
+    return static_key;
+  }
+
+  outcome::result<DHKey> HandshakeKeys::ephemeralKey() {
+    std::optional<DHKey> key;
+    {
+      std::lock_guard lock{mutex_};
+      if (!ephemeral_keys_.empty()) {
+        key = std::move(ephemeral_keys_.front());
+        ephemeral_keys_.pop_front();
+      }
+    }
+    refill();
+    if (key) {
+      return std::move(*key);
+    }
+    return NoiseDiffieHellmanImpl{}.generate();
+  }
+
+  size_t HandshakeKeys::pooled() const {
+    std::lock_guard lock{mutex_};
+    return ephemeral_keys_.size();
+  }
+
+  void HandshakeKeys::refill() {
+    // pregenerating keys inline would only add work to the io thread
+    if (crypto_executor_ == nullptr || !crypto_executor_->concurrent()) {
+      return;
+    }
+    size_t missing = 0;
+    {
+      std::lock_guard lock{mutex_};
+      missing = pool_size_ - std::min(pool_size_,
+                                      ephemeral_keys_.size() + generating_);
+      generating_ += missing;
+    }
+    for (size_t i = 0; i < missing; ++i) {
+      crypto_executor_->post(
+          [weak{weak_from_this()}] {
+            auto self = weak.lock();
+            if (!self) {
+              return;
+            }
+            auto key = NoiseDiffieHellmanImpl{}.generate();
+            std::lock_guard lock{self->mutex_};
+            --self->generating_;
+            if (key) {
+              self->ephemeral_keys_.emplace_back(std::move(key.value()));
+            }
+          },
+          [] {});
+    }
+  }
+
+}  // namespace libp2p::security::noise
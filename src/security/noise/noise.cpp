@@ -5,6 +5,7 @@
  */
 
 #include <libp2p/security/noise/handshake.hpp>
+#include <libp2p/security/noise/handshake_keys.hpp>
 #include <libp2p/security/noise/handshake_message_marshaller_impl.hpp>
 #include <libp2p/security/noise/noise.hpp>
 
@@ -16,10 +17,14 @@ namespace libp2p::security {
   Noise::Noise(
       crypto::KeyPair local_key,
       std::shared_ptr<crypto::CryptoProvider> crypto_provider,
-      std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller)
+      std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+      std::shared_ptr<CryptoExecutor> crypto_executor)
       : local_key_{std::move(local_key)},
         crypto_provider_{std::move(crypto_provider)},
-        key_marshaller_{std::move(key_marshaller)} {}
+        key_marshaller_{std::move(key_marshaller)},
+        crypto_executor_{std::move(crypto_executor)},
+        handshake_keys_{
+            std::make_shared<noise::HandshakeKeys>(crypto_executor_)} {}
 
   void Noise::secureInbound(
       std::shared_ptr<connection::LayerConnection> inbound,
@@ -36,7 +41,9 @@ namespace libp2p::security {
                                            false,
                                            boost::none,
                                            std::move(cb),
-                                           key_marshaller_);
+                                           key_marshaller_,
+                                           handshake_keys_,
+                                           crypto_executor_);
     handshake->connect();
   }
 
@@ -56,7 +63,9 @@ namespace libp2p::security {
                                            true,
                                            p,
                                            std::move(cb),
-                                           key_marshaller_);
+                                           key_marshaller_,
+                                           handshake_keys_,
+                                           crypto_executor_);
     handshake->connect();
   }
 }  // namespace libp2p::security
@@ -6,6 +6,8 @@
 
 #include <libp2p/security/noise/noise_connection.hpp>
 
+#include <libp2p/basic/read.hpp>
+#include <libp2p/basic/write.hpp>
 #include <libp2p/common/outcome_macro.hpp>
 #include <libp2p/crypto/x25519_provider/x25519_provider_impl.hpp>
 #include <libp2p/security/noise/crypto/interfaces.hpp>
@@ -24,16 +26,13 @@ namespace libp2p::connection {
         key_marshaller_{std::move(key_marshaller)},
         encoder_cs_{std::move(encoder)},
         decoder_cs_{std::move(decoder)},
-        frame_buffer_{std::make_shared<Bytes>(security::noise::kMaxMsgLen)},
-        framer_{std::make_shared<security::noise::InsecureReadWriter>(
-            connection_, frame_buffer_)} {
+        read_buffer_(security::noise::kMaxMsgLen),
+        write_buffer_(security::noise::kLengthPrefixSize
+                      + security::noise::kMaxMsgLen) {
     BOOST_ASSERT(connection_);
     BOOST_ASSERT(key_marshaller_);
     BOOST_ASSERT(encoder_cs_);
     BOOST_ASSERT(decoder_cs_);
-    BOOST_ASSERT(frame_buffer_);
-    BOOST_ASSERT(framer_);
-    frame_buffer_->resize(0);
   }
 
   bool NoiseConnection::isClosed() const {
@@ -46,41 +45,110 @@ namespace libp2p::connection {
 
   void NoiseConnection::readSome(BytesOut out,
                                  libp2p::basic::Reader::ReadCallbackFunc cb) {
-    if (!frame_buffer_->empty()) {
-      auto n{std::min(out.size(), frame_buffer_->size())};
-      auto begin{frame_buffer_->begin()};
-      auto end{begin + static_cast<int64_t>(n)};
-      std::copy(begin, end, out.begin());
-      frame_buffer_->erase(begin, end);
+    if (read_offset_ != read_end_) {
+      auto n{std::min(out.size(), read_end_ - read_offset_)};
+      std::copy_n(read_buffer_.begin() + static_cast<int64_t>(read_offset_),
+                  n,
+                  out.begin());
+      read_offset_ += n;
       return cb(n);
     }
-    framer_->read(
+    libp2p::read(
+        connection_,
+        read_prefix_,
         [self{shared_from_this()}, out, cb{std::move(cb)}](
-            outcome::result<std::shared_ptr<Bytes>> data_result) mutable {
-          auto data = IF_ERROR_CB_RETURN(data_result);
-          auto decrypted =
-              IF_ERROR_CB_RETURN(self->decoder_cs_->decrypt({}, *data, {}));
-          self->frame_buffer_->assign(decrypted.begin(), decrypted.end());
-          self->readSome(out, std::move(cb));
+            outcome::result<void> result) mutable {
+          IF_ERROR_CB_RETURN(result);
+          size_t frame_len = (size_t{self->read_prefix_[0]} << 8)
+                           | self->read_prefix_[1];
+          if (frame_len < security::noise::kTagSize) {
+            return cb(security::noise::Error::MESSAGE_TOO_SHORT);
+          }
+          BytesOut frame{self->read_buffer_.data(), frame_len};
+          libp2p::read(self->connection_,
+                       frame,
+                       [self, frame, out, cb{std::move(cb)}](
+                           outcome::result<void> result) mutable {
+                         IF_ERROR_CB_RETURN(result);
+                         self->onFrame(frame, out, std::move(cb));
+                       });
         });
   }
 
+  void NoiseConnection::onFrame(BytesOut frame,
+                                BytesOut out,
+                                ReadCallbackFunc cb) {
+    if (out.size() >= frame.size() - security::noise::kTagSize) {
+      // whole plaintext fits, skip the intermediate copy
+      auto n = IF_ERROR_CB_RETURN(decoder_cs_->open(frame, {}, out));
+      if (n == 0) {
+        return readSome(out, std::move(cb));
+      }
+      return cb(n);
+    }
+    auto n = IF_ERROR_CB_RETURN(decoder_cs_->open(frame, {}, frame));
+    read_offset_ = 0;
+    read_end_ = n;
+    readSome(out, std::move(cb));
+  }
+
   void NoiseConnection::writeSome(BytesIn in,
                                   basic::Writer::WriteCallbackFunc cb) {
     if (in.empty()) {
       cb(in.size());
       return;
     }
-    if (in.size() > security::noise::kMaxPlainText) {
-      in = in.first(security::noise::kMaxPlainText);
+    // large buffers are sealed as a batch of frames and sent at once
+    in = in.first(std::min(
+        in.size(), kMaxFramesPerWrite * security::noise::kMaxPlainText));
+    writeFrames(in, std::move(cb));
+  }
+
+  void NoiseConnection::writeSomeV(std::span<const BytesIn> in,
+                                   basic::Writer::WriteCallbackFunc cb) {
+    // Each noise frame is encrypted from contiguous plaintext, so buffers are
+    // gathered into the frame buffer and encrypted in place, unless there is
+    // nothing to gather
+    size_t non_empty = 0;
+    BytesIn single;
+    for (auto &buffer : in) {
+      if (!buffer.empty()) {
+        ++non_empty;
+        single = buffer;
+      }
+    }
+    if (non_empty < 2) {
+      return writeSome(single, std::move(cb));
+    }
+    auto plaintext = BytesOut{write_buffer_}.subspan(
+        security::noise::kLengthPrefixSize, security::noise::kMaxPlainText);
+    size_t size = 0;
+    for (auto &buffer : in) {
+      auto n = std::min(buffer.size(), plaintext.size() - size);
+      std::copy_n(buffer.begin(), n, plaintext.begin() + size);
+      size += n;
+      if (size == plaintext.size()) {
+        break;
+      }
+    }
+    writeFrames(plaintext.first(size), std::move(cb));
+  }
+
+  void NoiseConnection::writeFrames(BytesIn plaintext, WriteCallbackFunc cb) {
+    // one frame always fits, so gathered plaintext is never reallocated
+    auto size = security::noise::CipherState::framedSize(plaintext.size());
+    if (write_buffer_.size() < size) {
+      write_buffer_.resize(size);
     }
-    auto encrypted = IF_ERROR_CB_RETURN(encoder_cs_->encrypt({}, in, {}));
-    // `InsecureReadWriter::write` doesn't leak `BytesIn` reference
-    framer_->write(
-        encrypted,
-        [in, cb{std::move(cb)}](outcome::result<void> result) mutable {
+    auto n =
+        IF_ERROR_CB_RETURN(encoder_cs_->sealFrames(plaintext, write_buffer_));
+    libp2p::write(
+        connection_,
+        BytesIn{write_buffer_}.first(n),
+        [self{shared_from_this()}, size{plaintext.size()}, cb{std::move(cb)}](
+            outcome::result<void> result) {
           IF_ERROR_CB_RETURN(result);
-          cb(in.size());
+          cb(size);
         });
   }
 
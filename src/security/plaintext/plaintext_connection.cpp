@@ -65,6 +65,11 @@ namespace libp2p::connection {
     return original_connection_->writeSome(in, std::move(f));
   }
 
+  void PlaintextConnection::writeSomeV(std::span<const BytesIn> in,
+                                       Writer::WriteCallbackFunc f) {
+    return original_connection_->writeSomeV(in, std::move(f));
+  }
+
   void PlaintextConnection::deferReadCallback(outcome::result<size_t> res,
                                               ReadCallbackFunc cb) {
     original_connection_->deferReadCallback(res, std::move(cb));
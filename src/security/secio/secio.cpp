@@ -58,7 +58,8 @@ namespace libp2p::security {
       std::shared_ptr<secio::ExchangeMessageMarshaller> exchange_marshaller,
       std::shared_ptr<peer::IdentityManager> idmgr,
       std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
-      std::shared_ptr<crypto::hmac::HmacProvider> hmac_provider)
+      std::shared_ptr<crypto::hmac::HmacProvider> hmac_provider,
+      std::shared_ptr<CryptoExecutor> crypto_executor)
       : csprng_(std::move(csprng)),
         crypto_provider_(std::move(crypto_provider)),
         propose_marshaller_(std::move(propose_marshaller)),
@@ -66,6 +67,7 @@ namespace libp2p::security {
         idmgr_(std::move(idmgr)),
         key_marshaller_(std::move(key_marshaller)),
         hmac_provider_(std::move(hmac_provider)),
+        crypto_executor_(std::move(crypto_executor)),
         propose_message_{.rand = csprng_->randomBytes(16),
                          .pubkey = {},  // marshalled public key will be stored
                                         // here, initialized in constructor body
@@ -156,35 +158,63 @@ namespace libp2p::security {
       const std::shared_ptr<connection::LayerConnection> &conn,
       const std::shared_ptr<secio::Dialer> &dialer,
       SecurityAdaptor::SecConnCallbackFunc cb) const {
-    const auto &&self{this};
-    SECIO_OUTCOME_TRY(curve, dialer->chosenCurve(), conn, cb)
-    SECIO_OUTCOME_TRY(ephemeral_key,
-                      crypto_provider_->generateEphemeralKeyPair(curve),
-                      conn,
-                      cb)
-    dialer->storeEphemeralKeypair(ephemeral_key);
-    SECIO_OUTCOME_TRY(
-        local_corpus,
-        dialer->getCorpus(true, ephemeral_key.ephemeral_public_key),
-        conn,
-        cb)
-    SECIO_OUTCOME_TRY(
+    runCrypto(
+        crypto_executor_,
+        [self{shared_from_this()}, dialer] {
+          return self->makeExchangeMessage(*dialer);
+        },
+        [self{shared_from_this()}, conn, dialer, cb{std::move(cb)}](
+            outcome::result<secio::ExchangeMessage> res) {
+          SECIO_OUTCOME_TRY(local_exchange, res, conn, cb)
+          auto proto_exchange{
+              self->exchange_marshaller_->handyToProto(local_exchange)};
+          dialer->rw->write<secio::protobuf::Exchange>(
+              proto_exchange, [self, conn, dialer, cb](auto &&res) {
+                SECIO_OUTCOME_VOID_TRY(res, conn, cb)
+                SL_TRACE(self->log_, "exchange message sent");
+                self->receiveExchangeMessage(conn, dialer, cb);
+              });
+        });
+  }
+
+  outcome::result<secio::ExchangeMessage> Secio::makeExchangeMessage(
+      secio::Dialer &dialer) const {
+    OUTCOME_TRY(curve, dialer.chosenCurve());
+    OUTCOME_TRY(ephemeral_key,
+                crypto_provider_->generateEphemeralKeyPair(curve));
+    dialer.storeEphemeralKeypair(ephemeral_key);
+    OUTCOME_TRY(local_corpus,
+                dialer.getCorpus(true, ephemeral_key.ephemeral_public_key));
+    OUTCOME_TRY(
         local_corpus_signature,
-        crypto_provider_->sign(local_corpus, idmgr_->getKeyPair().privateKey),
-        conn,
-        cb)
-    secio::ExchangeMessage local_exchange{
+        crypto_provider_->sign(local_corpus, idmgr_->getKeyPair().privateKey));
+    return secio::ExchangeMessage{
         .epubkey = ephemeral_key.ephemeral_public_key,
         .signature = std::move(local_corpus_signature)};
-    auto proto_exchange{exchange_marshaller_->handyToProto(local_exchange)};
-    dialer->rw->write<secio::protobuf::Exchange>(
-        proto_exchange,
-        [self{shared_from_this()}, conn, dialer, cb{std::move(cb)}](
-            auto &&res) {
-          SECIO_OUTCOME_VOID_TRY(res, conn, cb)
-          SL_TRACE(self->log_, "exchange message sent");
-          self->receiveExchangeMessage(conn, dialer, cb);
-        });
+  }
+
+  outcome::result<void> Secio::deriveKeys(
+      secio::Dialer &dialer,
+      const secio::ExchangeMessage &remote_exchange) const {
+    OUTCOME_TRY(remote_corpus,
+                dialer.getCorpus(false, remote_exchange.epubkey));
+    OUTCOME_TRY(remote_key,
+                dialer.remotePublicKey(key_marshaller_, propose_marshaller_));
+    OUTCOME_TRY(verify_res,
+                crypto_provider_->verify(
+                    remote_corpus, remote_exchange.signature, remote_key));
+    if (!verify_res) {
+      return Error::REMOTE_PEER_SIGNATURE_IS_INVALID;
+    }
+    OUTCOME_TRY(shared_secret,
+                dialer.generateSharedSecret(remote_exchange.epubkey));
+    OUTCOME_TRY(chosen_cipher, dialer.chosenCipher());
+    OUTCOME_TRY(chosen_hash, dialer.chosenHash());
+    OUTCOME_TRY(stretched_keys,
+                crypto_provider_->stretchKey(
+                    chosen_cipher, chosen_hash, shared_secret));
+    dialer.storeStretchedKeys(std::move(stretched_keys));
+    return outcome::success();
   }
 
   void Secio::receiveExchangeMessage(
@@ -198,83 +228,64 @@ namespace libp2p::security {
           auto remote_exchange{
               self->exchange_marshaller_->protoToHandy(remote_proto_exchange)};
           SL_TRACE(self->log_, "remote exchange message received");
-          SECIO_OUTCOME_TRY(remote_corpus,
-                            dialer->getCorpus(false, remote_exchange.epubkey),
-                            conn,
-                            cb)
-
-          SECIO_OUTCOME_TRY(remote_key,
-                            dialer->remotePublicKey(self->key_marshaller_,
-                                                    self->propose_marshaller_),
-                            conn,
-                            cb)
-          SECIO_OUTCOME_TRY(
-              verify_res,
-              self->crypto_provider_->verify(
-                  remote_corpus, remote_exchange.signature, remote_key),
-              conn,
-              cb)
-          if (!verify_res) {
-            const auto error{Error::REMOTE_PEER_SIGNATURE_IS_INVALID};
-            self->closeConnection(conn, error);
-            cb(error);
-            return;
-          }
-
-          SECIO_OUTCOME_TRY(
-              shared_secret,
-              dialer->generateSharedSecret(remote_exchange.epubkey),
-              conn,
-              cb)
-          SECIO_OUTCOME_TRY(chosen_cipher, dialer->chosenCipher(), conn, cb)
-          SECIO_OUTCOME_TRY(chosen_hash, dialer->chosenHash(), conn, cb)
-          SECIO_OUTCOME_TRY(stretched_keys,
-                            self->crypto_provider_->stretchKey(
-                                chosen_cipher, chosen_hash, shared_secret),
-                            conn,
-                            cb)
-          dialer->storeStretchedKeys(std::move(stretched_keys));
+          runCrypto(
+              self->crypto_executor_,
+              [self, dialer, remote_exchange{std::move(remote_exchange)}] {
+                return self->deriveKeys(*dialer, remote_exchange);
+              },
+              [self, conn, dialer, cb](outcome::result<void> res) {
+                SECIO_OUTCOME_VOID_TRY(res, conn, cb)
+                self->establishConnection(conn, dialer, cb);
+              });
+        });
+  }
 
-          SECIO_OUTCOME_TRY(remote_pubkey,
-                            dialer->remotePublicKey(self->key_marshaller_,
-                                                    self->propose_marshaller_),
-                            conn,
-                            cb)
-          SECIO_OUTCOME_TRY(
-              local_stretched_key, dialer->localStretchedKey(), conn, cb)
-          SECIO_OUTCOME_TRY(
-              remote_stretched_key, dialer->remoteStretchedKey(), conn, cb)
+  void Secio::establishConnection(
+      const std::shared_ptr<connection::LayerConnection> &conn,
+      const std::shared_ptr<secio::Dialer> &dialer,
+      SecurityAdaptor::SecConnCallbackFunc cb) const {
+    auto self{shared_from_this()};
+    SECIO_OUTCOME_TRY(chosen_cipher, dialer->chosenCipher(), conn, cb)
+    SECIO_OUTCOME_TRY(chosen_hash, dialer->chosenHash(), conn, cb)
+    SECIO_OUTCOME_TRY(
+        remote_pubkey,
+        dialer->remotePublicKey(key_marshaller_, propose_marshaller_),
+        conn,
+        cb)
+    SECIO_OUTCOME_TRY(
+        local_stretched_key, dialer->localStretchedKey(), conn, cb)
+    SECIO_OUTCOME_TRY(
+        remote_stretched_key, dialer->remoteStretchedKey(), conn, cb)
 
-          auto secio_conn = std::make_shared<connection::SecioConnection>(
-              conn,
-              self->hmac_provider_,
-              self->key_marshaller_,
-              self->idmgr_->getKeyPair().publicKey,
-              remote_pubkey,
-              chosen_hash,
-              chosen_cipher,
-              local_stretched_key,
-              remote_stretched_key);
-          SECIO_OUTCOME_VOID_TRY(secio_conn->init(), conn, cb)
-          write(secio_conn,
-                self->remote_peer_rand_,
-                [self, conn, cb, secio_conn](outcome::result<void> write_res) {
-                  SECIO_OUTCOME_VOID_TRY(write_res, conn, cb);
-                  const auto kToRead{self->propose_message_.rand.size()};
-                  auto buffer = std::make_shared<Bytes>(kToRead);
-                  read(secio_conn,
-                       *buffer,
-                       [self, cb, conn, secio_conn, buffer](
-                           outcome::result<void> read_res) {
-                         SECIO_OUTCOME_VOID_TRY(read_res, conn, cb)
-                         if (*buffer != self->propose_message_.rand) {
-                           return cb(Error::INITIAL_PACKET_VERIFICATION_FAILED);
-                         }
-                         SL_TRACE(self->log_, "connection initialized");
-                         cb(secio_conn);
-                       });
-                });
-        });
+    auto secio_conn = std::make_shared<connection::SecioConnection>(
+        conn,
+        hmac_provider_,
+        key_marshaller_,
+        idmgr_->getKeyPair().publicKey,
+        remote_pubkey,
+        chosen_hash,
+        chosen_cipher,
+        local_stretched_key,
+        remote_stretched_key);
+    SECIO_OUTCOME_VOID_TRY(secio_conn->init(), conn, cb)
+    write(secio_conn,
+          remote_peer_rand_,
+          [self, conn, cb, secio_conn](outcome::result<void> write_res) {
+            SECIO_OUTCOME_VOID_TRY(write_res, conn, cb);
+            const auto kToRead{self->propose_message_.rand.size()};
+            auto buffer = std::make_shared<Bytes>(kToRead);
+            read(secio_conn,
+                 *buffer,
+                 [self, cb, conn, secio_conn, buffer](
+                     outcome::result<void> read_res) {
+                   SECIO_OUTCOME_VOID_TRY(read_res, conn, cb)
+                   if (*buffer != self->propose_message_.rand) {
+                     return cb(Error::INITIAL_PACKET_VERIFICATION_FAILED);
+                   }
+                   SL_TRACE(self->log_, "connection initialized");
+                   cb(secio_conn);
+                 });
+          });
   }
 
   void Secio::closeConnection(
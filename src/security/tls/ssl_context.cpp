@@ -8,7 +8,9 @@
 #include <libp2p/common/asio_buffer.hpp>
 #include <libp2p/peer/identity_manager.hpp>
 #include <libp2p/security/tls/ssl_context.hpp>
+#include <libp2p/security/tls/tls_connection.hpp>
 #include <libp2p/security/tls/tls_details.hpp>
+#include <libp2p/security/tls/tls_session_cache.hpp>
 #include <qtils/bytes.hpp>
 
 namespace libp2p::security {
@@ -65,6 +67,15 @@ namespace libp2p::security {
     };
     tls = make();
     quic = make();
+    // servers issue stateless tickets, clients keep them in tls_sessions
+    SSL_CTX_set_session_id_context(
+        tls->native_handle(), kAlpn.data() + 1, kAlpn.size() - 1);
+    SSL_CTX_set_session_cache_mode(
+        tls->native_handle(),
+        SSL_SESS_CACHE_BOTH | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(tls->native_handle(),
+                            &connection::TlsConnection::onNewSession);
+    tls_sessions = std::make_shared<TlsSessionCache>();
     SSL_CTX_set_alpn_protos(quic->native_handle(), kAlpn.data(), kAlpn.size());
     SSL_CTX_set_alpn_select_cb(quic->native_handle(), alpnSelect, nullptr);
   }
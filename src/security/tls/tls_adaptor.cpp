@@ -21,11 +21,16 @@ namespace libp2p::security {
       std::shared_ptr<peer::IdentityManager> idmgr,
       std::shared_ptr<boost::asio::io_context> io_context,
       const SslContext &ssl_context,
-      std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller)
+      std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+      std::shared_ptr<CryptoExecutor> crypto_executor)
       : idmgr_(std::move(idmgr)),
         io_context_(std::move(io_context)),
         key_marshaller_{std::move(key_marshaller)},
-        ssl_context_{ssl_context.tls} {
+        ssl_context_{ssl_context.tls},
+        session_cache_{ssl_context.tls_sessions},
+        certificate_cache_{std::make_shared<tls_details::CertificateCache>(
+            tls_details::kCertificateCacheSize)},
+        crypto_executor_{std::move(crypto_executor)} {
     assert(idmgr_);
     assert(io_context_);
     assert(key_marshaller_);
@@ -65,8 +70,11 @@ namespace libp2p::security {
                                                     ssl_context_,
                                                     *idmgr_,
                                                     io_context_,
-                                                    std::move(remote_peer));
-    tls_conn->asyncHandshake(std::move(cb), key_marshaller_);
+                                                    std::move(remote_peer),
+                                                    session_cache_,
+                                                    certificate_cache_);
+    tls_conn->asyncHandshake(
+        std::move(cb), key_marshaller_, crypto_executor_);
   }
 
 }  // namespace libp2p::security
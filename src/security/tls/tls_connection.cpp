@@ -13,84 +13,155 @@ namespace libp2p::connection {
   using TlsError = security::TlsError;
   using security::tls_details::log;
 
+  namespace {
+    /// SSL ex data slot with TlsConnection pointer
+    int connectionIndex() {
+      static const int index =
+          SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+      return index;
+    }
+  }  // namespace
+
   TlsConnection::TlsConnection(
       std::shared_ptr<LayerConnection> original_connection,
       std::shared_ptr<boost::asio::ssl::context> ssl_context,
       const peer::IdentityManager &idmgr,
       std::shared_ptr<boost::asio::io_context> io_context,
-      boost::optional<peer::PeerId> remote_peer)
+      boost::optional<peer::PeerId> remote_peer,
+      std::shared_ptr<security::TlsSessionCache> session_cache,
+      std::shared_ptr<security::tls_details::CertificateCache>
+          certificate_cache)
       : local_peer_(idmgr.getId()),
         original_connection_(std::move(original_connection)),
         ssl_context_(std::move(ssl_context)),
         socket_{AsAsioReadWrite{std::move(io_context), original_connection_},
                 *ssl_context_},
-        remote_peer_(std::move(remote_peer)) {}
+        remote_peer_(std::move(remote_peer)),
+        session_cache_(std::move(session_cache)),
+        certificate_cache_(std::move(certificate_cache)) {}
+
+  int TlsConnection::onNewSession(ssl_st *ssl, ssl_session_st *session) {
+    auto *conn =
+        static_cast<TlsConnection *>(SSL_get_ex_data(ssl, connectionIndex()));
+    if (conn == nullptr || !conn->remote_peer_ || !conn->remote_pubkey_) {
+      return 0;
+    }
+    conn->session_cache_->put(
+        conn->session_key_,
+        {.session = {session, SSL_SESSION_free},
+         .identity = {.public_key = conn->remote_pubkey_.value(),
+                      .peer_id = conn->remote_peer_.value()}});
+    return 1;
+  }
+
+  void TlsConnection::resumeSession() {
+    auto address = original_connection_->remoteMultiaddr();
+    if (!address) {
+      return;
+    }
+    auto *ssl = socket_.native_handle();
+    session_key_ =
+        security::TlsSessionCache::key(remote_peer_.value(), address.value());
+    SSL_set_ex_data(ssl, connectionIndex(), this);
+    auto entry = session_cache_->take(session_key_, remote_peer_.value());
+    if (!entry || SSL_SESSION_is_resumable(entry->session.get()) != 1) {
+      return;
+    }
+    if (SSL_set_session(ssl, entry->session.get()) == 1) {
+      resumed_identity_ = std::move(entry->identity);
+    }
+  }
 
   void TlsConnection::asyncHandshake(
       HandshakeCallback cb,
-      std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller) {
+      std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+      std::shared_ptr<security::CryptoExecutor> crypto_executor) {
     bool is_client = original_connection_->isInitiator();
+    if (is_client && session_cache_ != nullptr && remote_peer_) {
+      resumeSession();
+    }
 
     socket_.async_handshake(is_client ? boost::asio::ssl::stream_base::client
                                       : boost::asio::ssl::stream_base::server,
                             [self = shared_from_this(),
                              cb = std::move(cb),
-                             key_marshaller = std::move(key_marshaller)](
+                             key_marshaller = std::move(key_marshaller),
+                             crypto_executor = std::move(crypto_executor)](
                                 const boost::system::error_code &error) {
                               self->onHandshakeResult(
-                                  error, cb, *key_marshaller);
+                                  error, cb, key_marshaller, crypto_executor);
                             });
   }
 
   void TlsConnection::onHandshakeResult(
       const boost::system::error_code &error,
-      const HandshakeCallback &cb,
-      const crypto::marshaller::KeyMarshaller &key_marshaller) {
-    std::optional<std::error_code> ec;
+      HandshakeCallback cb,
+      std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+      std::shared_ptr<security::CryptoExecutor> crypto_executor) {
     if (error) {
-      ec = error;
+      return onHandshakeError(error, cb);
     }
-    while (!ec) {
-      X509 *cert = SSL_get_peer_certificate(socket_.native_handle());
-      if (cert == nullptr) {
-        ec = TlsError::TLS_NO_CERTIFICATE;
-        break;
-      }
-      auto id_res = security::tls_details::verifyPeerAndExtractIdentity(
-          cert, key_marshaller);
-      if (!id_res) {
-        ec = id_res.error();
-        break;
-      }
-      auto &id = id_res.value();
-      if (remote_peer_.has_value()) {
-        if (remote_peer_.value() != id.peer_id) {
-          SL_DEBUG(log(),
-                   "peer ids mismatch: expected={}, got={}",
-                   remote_peer_.value().toBase58(),
-                   id.peer_id.toBase58());
-          ec = TlsError::TLS_UNEXPECTED_PEER_ID;
-          break;
-        }
-      } else {
-        remote_peer_ = std::move(id.peer_id);
-      }
-      remote_pubkey_ = std::move(id.public_key);
+    if (resumed_identity_ && SSL_session_reused(socket_.native_handle())) {
+      // remote peer proved knowledge of session verified before
+      SL_DEBUG(log(), "session resumed");
+      auto identity = std::move(resumed_identity_.value());
+      resumed_identity_.reset();
+      return onRemoteIdentity(std::move(identity), cb);
+    }
+    resumed_identity_.reset();
+    std::shared_ptr<X509> cert{
+        SSL_get_peer_certificate(socket_.native_handle()), X509_free};
+    if (cert == nullptr) {
+      return onHandshakeError(TlsError::TLS_NO_CERTIFICATE, cb);
+    }
+    security::runCrypto(
+        crypto_executor,
+        [cert,
+         key_marshaller{std::move(key_marshaller)},
+         certificate_cache{certificate_cache_}] {
+          return security::tls_details::verifyPeerAndExtractIdentity(
+              cert.get(), *key_marshaller, certificate_cache.get());
+        },
+        [self{shared_from_this()}, cb{std::move(cb)}](
+            outcome::result<security::tls_details::PubkeyAndPeerId> id_res) {
+          self->onRemoteIdentity(std::move(id_res), cb);
+        });
+  }
 
-      SL_DEBUG(log(),
-               "handshake success for {}bound connection to {}",
-               (original_connection_->isInitiator() ? "out" : "in"),
-               remote_peer_->toBase58());
-      return cb(shared_from_this());
+  void TlsConnection::onRemoteIdentity(
+      outcome::result<security::tls_details::PubkeyAndPeerId> id_res,
+      const HandshakeCallback &cb) {
+    if (!id_res) {
+      return onHandshakeError(id_res.error(), cb);
+    }
+    auto &id = id_res.value();
+    if (remote_peer_.has_value()) {
+      if (remote_peer_.value() != id.peer_id) {
+        SL_DEBUG(log(),
+                 "peer ids mismatch: expected={}, got={}",
+                 remote_peer_.value().toBase58(),
+                 id.peer_id.toBase58());
+        return onHandshakeError(TlsError::TLS_UNEXPECTED_PEER_ID, cb);
+      }
+    } else {
+      remote_peer_ = std::move(id.peer_id);
     }
+    remote_pubkey_ = std::move(id.public_key);
 
-    assert(ec);
+    SL_DEBUG(log(),
+             "handshake success for {}bound connection to {}",
+             (original_connection_->isInitiator() ? "out" : "in"),
+             remote_peer_->toBase58());
+    cb(shared_from_this());
+  }
 
-    log()->info("handshake error: {}", *ec);
+  void TlsConnection::onHandshakeError(std::error_code ec,
+                                       const HandshakeCallback &cb) {
+    log()->info("handshake error: {}", ec);
     if (auto close_res = close(); !close_res) {
       log()->info("cannot close raw connection: {}", close_res.error());
     }
-    return cb(*ec);
+    cb(ec);
   }
 
   outcome::result<peer::PeerId> TlsConnection::localPeer() const {
@@ -154,6 +225,28 @@ namespace libp2p::connection {
                              closeOnError(*this, std::move(cb)));
   }
 
+  void TlsConnection::writeSomeV(std::span<const BytesIn> in,
+                                 Writer::WriteCallbackFunc cb) {
+    // max TLS record plaintext size
+    constexpr size_t kMaxRecordSize = 16384;
+    auto it = std::find_if(
+        in.begin(), in.end(), [](BytesIn buffer) { return !buffer.empty(); });
+    if (it == in.end() || it->size() >= kMaxRecordSize) {
+      return writeSome(it == in.end() ? BytesIn{} : *it, std::move(cb));
+    }
+    write_gather_buffer_.clear();
+    for (; it != in.end(); ++it) {
+      auto n = std::min<size_t>(
+          it->size(), kMaxRecordSize - write_gather_buffer_.size());
+      write_gather_buffer_.insert(
+          write_gather_buffer_.end(), it->begin(), it->begin() + n);
+      if (write_gather_buffer_.size() == kMaxRecordSize) {
+        break;
+      }
+    }
+    writeSome(write_gather_buffer_, std::move(cb));
+  }
+
   void TlsConnection::deferWriteCallback(std::error_code ec,
                                          Writer::WriteCallbackFunc cb) {
     original_connection_->deferWriteCallback(ec, std::move(cb));
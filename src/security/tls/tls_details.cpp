@@ -5,6 +5,8 @@
  */
 
 #include <openssl/asn1.h>
+#include <openssl/evp.h>
+#include <openssl/sha.h>
 #include <openssl/x509_vfy.h>
 #include <boost/asio/ssl/verify_context.hpp>
 #include <boost/optional.hpp>
@@ -427,42 +429,62 @@ namespace libp2p::security::tls_details {
       return outcome::success();
     }
 
-  }  // namespace
+    /// Extracts and verifies identity, uncached
+    outcome::result<PubkeyAndPeerId> verifyCertificate(
+        X509 *peer_certificate,
+        const crypto::marshaller::KeyMarshaller &key_marshaller) {
+      // 1. Extract fields from cert extension
+      OUTCOME_TRY(bin_fields, extractExtensionFields(peer_certificate));
 
-  outcome::result<PubkeyAndPeerId> verifyPeerAndExtractIdentity(
-      X509 *peer_certificate,
-      const crypto::marshaller::KeyMarshaller &key_marshaller) {
-    // 1. Extract fields from cert extension
-    OUTCOME_TRY(bin_fields, extractExtensionFields(peer_certificate));
+      // 2. Try to extract peer id and pubkey from protobuf format
+      crypto::ProtobufKey pub_key_bytes(std::move(bin_fields.pkey));
 
-    // 2. Try to extract peer id and pubkey from protobuf format
-    crypto::ProtobufKey pub_key_bytes(std::move(bin_fields.pkey));
+      auto peer_id_res = peer::PeerId::fromPublicKey(pub_key_bytes);
+      if (!peer_id_res) {
+        log()->info("cannot unmarshal remote peer id");
+        return TlsError::TLS_INCOMPATIBLE_CERTIFICATE_EXTENSION;
+      }
 
-    auto peer_id_res = peer::PeerId::fromPublicKey(pub_key_bytes);
-    if (!peer_id_res) {
-      log()->info("cannot unmarshal remote peer id");
-      return TlsError::TLS_INCOMPATIBLE_CERTIFICATE_EXTENSION;
-    }
+      auto peer_pubkey_res = key_marshaller.unmarshalPublicKey(pub_key_bytes);
+      if (!peer_pubkey_res) {
+        log()->info("cannot unmarshal remote public key");
+        return TlsError::TLS_INCOMPATIBLE_CERTIFICATE_EXTENSION;
+      }
 
-    auto peer_pubkey_res = key_marshaller.unmarshalPublicKey(pub_key_bytes);
-    if (!peer_pubkey_res) {
-      log()->info("cannot unmarshal remote public key");
-      return TlsError::TLS_INCOMPATIBLE_CERTIFICATE_EXTENSION;
-    }
+      if (peer_pubkey_res.value().type != crypto::Key::Type::Ed25519) {
+        log()->info("remote peer's public key wrong type");
+        return TlsError::TLS_INCOMPATIBLE_CERTIFICATE_EXTENSION;
+      }
+
+      // 3. Verify
+      OUTCOME_TRY(verifyExtensionSignature(peer_certificate,
+                                           peer_pubkey_res.value(),
+                                           bin_fields.signature,
+                                           peer_id_res.value()));
 
-    if (peer_pubkey_res.value().type != crypto::Key::Type::Ed25519) {
-      log()->info("remote peer's public key wrong type");
-      return TlsError::TLS_INCOMPATIBLE_CERTIFICATE_EXTENSION;
+      return PubkeyAndPeerId{std::move(peer_pubkey_res.value()),
+                             std::move(peer_id_res.value())};
     }
 
-    // 3. Verify
-    OUTCOME_TRY(verifyExtensionSignature(peer_certificate,
-                                         peer_pubkey_res.value(),
-                                         bin_fields.signature,
-                                         peer_id_res.value()));
+  }  // namespace
 
-    return PubkeyAndPeerId{std::move(peer_pubkey_res.value()),
-                           std::move(peer_id_res.value())};
+  outcome::result<PubkeyAndPeerId> verifyPeerAndExtractIdentity(
+      X509 *peer_certificate,
+      const crypto::marshaller::KeyMarshaller &key_marshaller,
+      CertificateCache *certificate_cache) {
+    static_assert(sizeof(CertificateFingerprint) == SHA256_DIGEST_LENGTH);
+    CertificateFingerprint fingerprint{};
+    unsigned int size = 0;
+    if (certificate_cache == nullptr
+        || X509_digest(
+               peer_certificate, EVP_sha256(), fingerprint.data(), &size)
+               != 1
+        || size != fingerprint.size()) {
+      return verifyCertificate(peer_certificate, key_marshaller);
+    }
+    return certificate_cache->getOrMake(fingerprint, [&] {
+      return verifyCertificate(peer_certificate, key_marshaller);
+    });
   }
 
   const char *x509ErrorToStr(int error) {
@@ -0,0 +1,43 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/tls/tls_session_cache.hpp>
+
+namespace libp2p::security {
+
+  TlsSessionCache::TlsSessionCache(size_t capacity) : sessions_{capacity} {}
+
+  std::string TlsSessionCache::key(const peer::PeerId &peer,
+                                   const multi::Multiaddress &address) {
+    return peer.toBase58() + std::string{address.getStringAddress()};
+  }
+
+  void TlsSessionCache::put(const std::string &key, Entry entry) {
+    sessions_.put(key, std::move(entry));
+  }
+
+  std::optional<TlsSessionCache::Entry> TlsSessionCache::take(
+      const std::string &key, const peer::PeerId &peer) {
+    auto entry = sessions_.get(key);
+    if (!entry) {
+      return std::nullopt;
+    }
+    sessions_.erase(key);
+    if (entry->identity.peer_id != peer) {
+      SL_DEBUG(tls_details::log(),
+               "cached session identity {} mismatches expected {}",
+               entry->identity.peer_id.toBase58(),
+               peer.toBase58());
+      return std::nullopt;
+    }
+    return entry;
+  }
+
+  LruCacheStats TlsSessionCache::stats() const {
+    return sessions_.stats();
+  }
+
+}  // namespace libp2p::security
@@ -6,6 +6,8 @@
 
 #include <libp2p/transport/tcp/tcp_connection.hpp>
 
+#include <boost/container/small_vector.hpp>
+
 #include <libp2p/common/asio_buffer.hpp>
 #include <libp2p/transport/tcp/bytes_counter.hpp>
 #include <libp2p/transport/tcp/tcp_util.hpp>
@@ -186,6 +188,24 @@ namespace libp2p::transport {
                              closeOnError(*this, std::move(cb)));
   }
 
+  void TcpConnection::writeSomeV(std::span<const BytesIn> in,
+                                 TcpConnection::WriteCallbackFunc cb) {
+    boost::container::small_vector<boost::asio::const_buffer, 4> buffers;
+    size_t total = 0;
+    for (auto &buffer : in) {
+      if (!buffer.empty()) {
+        buffers.emplace_back(asioBuffer(buffer));
+        total += buffer.size();
+      }
+    }
+    ByteCounter::getInstance().incrementBytesWritten(total);
+    TRACE("{} write some up to {} in {} buffers",
+          debug_str_,
+          total,
+          buffers.size());
+    socket_.async_write_some(buffers, closeOnError(*this, std::move(cb)));
+  }
+
   void TcpConnection::deferReadCallback(outcome::result<size_t> res,
                                         ReadCallbackFunc cb) {
     boost::asio::post(context_, [res, cb{std::move(cb)}] { cb(res); });
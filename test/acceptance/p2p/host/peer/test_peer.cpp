@@ -156,7 +156,8 @@ Peer::sptr<host::BasicHost> Peer::makeHost(const crypto::KeyPair &keyPair) {
         std::make_shared<security::secio::ExchangeMessageMarshallerImpl>(),
         idmgr,
         key_marshaller,
-        hmac_provider_));
+        hmac_provider_,
+        nullptr));
   } else {
     security_adaptors.emplace_back(std::make_shared<security::Plaintext>(
         std::move(exchange_msg_marshaller), idmgr, std::move(key_marshaller)));
@@ -0,0 +1,329 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/asio/error.hpp>
+#include <libp2p/basic/scheduler/manual_scheduler_backend.hpp>
+#include <libp2p/basic/scheduler/scheduler_impl.hpp>
+#include <libp2p/connection/secure_connection.hpp>
+#include <testutil/libp2p/peer.hpp>
+
+namespace testutil {
+  using libp2p::Bytes;
+  using libp2p::BytesIn;
+  using libp2p::BytesOut;
+  using libp2p::basic::ManualSchedulerBackend;
+  using libp2p::basic::Scheduler;
+  using libp2p::basic::SchedulerImpl;
+  using libp2p::connection::SecureConnection;
+
+  /// Bytes one side may buffer before writes of the other side are held
+  constexpr size_t kPipeCapacity = 1024 * 1024;
+
+  /// Consecutive scheduler passes without pipe traffic before giving up
+  constexpr size_t kMaxIdlePasses = 1000;
+
+  /**
+   * One end of an in-memory connection. Data written to one end becomes
+   * readable on the other one, all completions are posted to the scheduler.
+   */
+  class MemoryPipe : public SecureConnection,
+                     public std::enable_shared_from_this<MemoryPipe> {
+   public:
+    MemoryPipe(std::shared_ptr<Scheduler> scheduler,
+               PeerId local,
+               PeerId remote,
+               bool initiator)
+        : scheduler_(std::move(scheduler)),
+          local_(std::move(local)),
+          remote_(std::move(remote)),
+          initiator_(initiator) {}
+
+    static std::pair<std::shared_ptr<MemoryPipe>, std::shared_ptr<MemoryPipe>>
+    makePair(const std::shared_ptr<Scheduler> &scheduler) {
+      auto a = testutil::randomPeerId();
+      auto b = testutil::randomPeerId();
+      auto client = std::make_shared<MemoryPipe>(scheduler, a, b, true);
+      auto server = std::make_shared<MemoryPipe>(scheduler, b, a, false);
+      client->peer_ = server;
+      server->peer_ = client;
+      return {client, server};
+    }
+
+    /// Total bytes read from this end
+    size_t bytesRead() const {
+      return bytes_read_;
+    }
+
+    outcome::result<PeerId> localPeer() const override {
+      return local_;
+    }
+
+    outcome::result<PeerId> remotePeer() const override {
+      return remote_;
+    }
+
+    outcome::result<libp2p::crypto::PublicKey> remotePublicKey()
+        const override {
+      return std::make_error_code(std::errc::not_supported);
+    }
+
+    bool isInitiator() const override {
+      return initiator_;
+    }
+
+    outcome::result<libp2p::multi::Multiaddress> localMultiaddr()
+        override {
+      return std::make_error_code(std::errc::not_supported);
+    }
+
+    outcome::result<libp2p::multi::Multiaddress> remoteMultiaddr()
+        override {
+      return std::make_error_code(std::errc::not_supported);
+    }
+
+    void readSome(BytesOut out, ReadCallbackFunc cb) override {
+      if (available() != 0) {
+        return post(std::move(cb), take(out));
+      }
+      if (closed_ || peer_.expired()) {
+        return deferReadCallback(
+            make_error_code(boost::asio::error::eof), std::move(cb));
+      }
+      pending_read_.emplace(PendingRead{out, std::move(cb)});
+    }
+
+    void deferReadCallback(outcome::result<size_t> res,
+                           ReadCallbackFunc cb) override {
+      scheduler_->schedule(
+          [res, cb{std::move(cb)}]() mutable { cb(std::move(res)); });
+    }
+
+    void writeSome(BytesIn in, WriteCallbackFunc cb) override {
+      writeSomeV(std::span<const BytesIn>(&in, 1), std::move(cb));
+    }
+
+    void writeSomeV(std::span<const BytesIn> in,
+                    WriteCallbackFunc cb) override {
+      auto peer = peer_.lock();
+      if (closed_ || !peer) {
+        return deferWriteCallback(
+            make_error_code(boost::asio::error::broken_pipe), std::move(cb));
+      }
+      auto n = peer->push(in);
+      if (n == 0) {
+        pending_write_.emplace(
+            PendingWrite{{in.begin(), in.end()}, std::move(cb)});
+        return;
+      }
+      post(std::move(cb), n);
+    }
+
+    void deferWriteCallback(std::error_code ec,
+                            WriteCallbackFunc cb) override {
+      scheduler_->schedule([ec, cb{std::move(cb)}] { cb(ec); });
+    }
+
+    bool isClosed() const override {
+      return closed_;
+    }
+
+    outcome::result<void> close() override {
+      if (closed_) {
+        return outcome::success();
+      }
+      closed_ = true;
+      failPending();
+      if (auto peer = peer_.lock()) {
+        peer->failPending();
+      }
+      return outcome::success();
+    }
+
+   private:
+    struct PendingRead {
+      BytesOut out;
+      ReadCallbackFunc cb;
+    };
+
+    struct PendingWrite {
+      std::vector<BytesIn> in;
+      WriteCallbackFunc cb;
+    };
+
+    template <typename Cb>
+    void post(Cb cb, size_t n) {
+      scheduler_->schedule([n, cb{std::move(cb)}] { cb(n); });
+    }
+
+    size_t available() const {
+      return inbox_.size() - inbox_offset_;
+    }
+
+    /// Appends as much of `in` as fits, serves a pending read
+    size_t push(std::span<const BytesIn> in) {
+      auto space = kPipeCapacity - std::min(kPipeCapacity, available());
+      size_t n = 0;
+      for (auto &buffer : in) {
+        auto chunk = std::min(buffer.size(), space - n);
+        inbox_.insert(inbox_.end(), buffer.begin(), buffer.begin() + chunk);
+        n += chunk;
+        if (n == space) {
+          break;
+        }
+      }
+      if (n != 0 && pending_read_) {
+        auto read = std::move(*pending_read_);
+        pending_read_.reset();
+        post(std::move(read.cb), take(read.out));
+      }
+      return n;
+    }
+
+    size_t take(BytesOut out) {
+      auto n = std::min(out.size(), available());
+      std::memcpy(out.data(), inbox_.data() + inbox_offset_, n);
+      inbox_offset_ += n;
+      bytes_read_ += n;
+      if (inbox_offset_ == inbox_.size()) {
+        inbox_.clear();
+        inbox_offset_ = 0;
+      } else if (inbox_offset_ >= kPipeCapacity) {
+        inbox_.erase(inbox_.begin(),
+                     inbox_.begin() + static_cast<ptrdiff_t>(inbox_offset_));
+        inbox_offset_ = 0;
+      }
+      if (auto peer = peer_.lock(); peer && peer->pending_write_) {
+        scheduler_->schedule([weak{peer_}] {
+          if (auto peer = weak.lock()) {
+            peer->retryWrite();
+          }
+        });
+      }
+      return n;
+    }
+
+    void retryWrite() {
+      if (!pending_write_) {
+        return;
+      }
+      auto write = std::move(*pending_write_);
+      pending_write_.reset();
+      writeSomeV(write.in, std::move(write.cb));
+    }
+
+    void failPending() {
+      if (pending_read_) {
+        auto read = std::move(*pending_read_);
+        pending_read_.reset();
+        deferReadCallback(make_error_code(boost::asio::error::eof),
+                          std::move(read.cb));
+      }
+      if (pending_write_) {
+        auto write = std::move(*pending_write_);
+        pending_write_.reset();
+        deferWriteCallback(make_error_code(boost::asio::error::broken_pipe),
+                           std::move(write.cb));
+      }
+    }
+
+    std::shared_ptr<Scheduler> scheduler_;
+    PeerId local_;
+    PeerId remote_;
+    bool initiator_;
+    std::weak_ptr<MemoryPipe> peer_;
+    Bytes inbox_;
+    size_t inbox_offset_ = 0;
+    size_t bytes_read_ = 0;
+    std::optional<PendingRead> pending_read_;
+    std::optional<PendingWrite> pending_write_;
+    bool closed_ = false;
+  };
+
+  /// Connected memory pipes driven by the manual scheduler backend
+  struct PipeEnv {
+    PipeEnv()
+        : backend(std::make_shared<ManualSchedulerBackend>()),
+          scheduler(
+              std::make_shared<SchedulerImpl>(backend, Scheduler::Config{})) {
+      std::tie(client_pipe, server_pipe) = MemoryPipe::makePair(scheduler);
+    }
+
+    /// Drives the event loop until `done` or until traffic stalls
+    bool runUntil(const std::function<bool()> &done) {
+      size_t idle = 0;
+      auto traffic = client_pipe->bytesRead() + server_pipe->bytesRead();
+      while (!done()) {
+        backend->shift(std::chrono::milliseconds::zero());
+        if (done()) {
+          break;
+        }
+        backend->shiftToTimer();
+        auto now = client_pipe->bytesRead() + server_pipe->bytesRead();
+        if (now != traffic) {
+          traffic = now;
+          idle = 0;
+        } else if (++idle == kMaxIdlePasses) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    std::shared_ptr<ManualSchedulerBackend> backend;
+    std::shared_ptr<SchedulerImpl> scheduler;
+    std::shared_ptr<MemoryPipe> client_pipe;
+    std::shared_ptr<MemoryPipe> server_pipe;
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  constexpr size_t kMiB = 1024 * 1024;
+
+  struct Result {
+    double value;
+    const char *unit;
+  };
+
+  inline double secondsSince(Clock::time_point started) {
+    return std::chrono::duration<double>(Clock::now() - started).count();
+  }
+
+  /// Peak resident set size of the process, KiB
+  inline long peakRssKiB() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+  }
+
+  /// Prints one result line, returns false if the scenario failed
+  inline bool report(const std::string &name,
+                     const std::optional<Result> &result) {
+    std::cout << std::left << std::setw(36) << name;
+    if (!result) {
+      std::cout << "FAILED\n";
+      return false;
+    }
+    std::cout << std::right << std::fixed << std::setprecision(1)
+              << std::setw(14) << result->value << ' ' << std::left
+              << std::setw(10) << result->unit << " peak_rss=" << peakRssKiB()
+              << " KiB\n";
+    return true;
+  }
+}  // namespace testutil
@@ -0,0 +1,277 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Encryption throughput benchmark for the transport stack.
+ *
+ * Measures raw ciphers on 64 KiB blocks and one-way transfers through secure
+ * connections over in-memory pipes driven by the manual scheduler backend.
+ * Handshake scenarios measure full Noise handshakes over fresh pipes.
+ * All numbers are for a single core.
+ *
+ * Usage: crypto_benchmark [filter]
+ * Only scenarios whose name contains `filter` are run.
+ */
+
+#include <cstdlib>
+
+#include <libp2p/basic/write.hpp>
+#include <libp2p/crypto/aes_ctr/aes_ctr_impl.hpp>
+#include <libp2p/crypto/chachapoly/chachapoly_impl.hpp>
+#include <libp2p/crypto/crypto_provider/crypto_provider_impl.hpp>
+#include <libp2p/crypto/ecdsa_provider/ecdsa_provider_impl.hpp>
+#include <libp2p/crypto/ed25519_provider/ed25519_provider_impl.hpp>
+#include <libp2p/crypto/hmac_provider/hmac_provider_impl.hpp>
+#include <libp2p/crypto/key_marshaller/key_marshaller_impl.hpp>
+#include <libp2p/crypto/key_validator/key_validator_impl.hpp>
+#include <libp2p/crypto/random_generator/boost_generator.hpp>
+#include <libp2p/crypto/rsa_provider/rsa_provider_impl.hpp>
+#include <libp2p/crypto/secp256k1_provider/secp256k1_provider_impl.hpp>
+#include <libp2p/security/noise.hpp>
+#include <libp2p/security/noise/handshake.hpp>
+#include <libp2p/security/noise/noise_connection.hpp>
+#include <libp2p/security/secio/secio_connection.hpp>
+#include <testutil/prepare_loggers.hpp>
+#include "benchmark/benchmark_util.hpp"
+
+namespace {
+  using namespace testutil;
+  using libp2p::connection::NoiseConnection;
+  using libp2p::connection::SecioConnection;
+  using libp2p::crypto::CryptoProvider;
+  using libp2p::crypto::CryptoProviderImpl;
+  using libp2p::crypto::PublicKey;
+  using libp2p::crypto::StretchedKey;
+  using libp2p::crypto::aes::AesCtrImpl;
+  using libp2p::crypto::chachapoly::ChaCha20Poly1305Impl;
+  using libp2p::crypto::marshaller::KeyMarshallerImpl;
+  using libp2p::crypto::validator::KeyValidatorImpl;
+  using libp2p::security::Noise;
+  using libp2p::security::noise::CipherState;
+  using libp2p::security::noise::Key32;
+
+  using SecurePair = std::pair<std::shared_ptr<SecureConnection>,
+                               std::shared_ptr<SecureConnection>>;
+  using SecureFactory = std::function<SecurePair(PipeEnv &)>;
+  using VoidResult = outcome::result<void>;
+
+  constexpr size_t kBlockSize = 64 * 1024;
+  constexpr size_t kWriteChunkSize = 1024 * 1024;
+  constexpr size_t kCipherBytes = 512 * kMiB;
+  constexpr size_t kTransferBytes = 256 * kMiB;
+
+  /// Applies `op` to 64 KiB blocks until `total` bytes are processed
+  std::optional<Result> cipherLoop(size_t total,
+                                   const std::function<bool(Bytes &)> &op) {
+    Bytes block(kBlockSize + libp2p::crypto::chachapoly::kTagSize, 0x42);
+    auto started = Clock::now();
+    for (size_t done = 0; done < total; done += kBlockSize) {
+      if (!op(block)) {
+        return std::nullopt;
+      }
+    }
+    return Result{static_cast<double>(total) / kMiB / secondsSince(started),
+                  "MiB/s"};
+  }
+
+  std::optional<Result> chachaEncrypt() {
+    ChaCha20Poly1305Impl codec({});
+    auto nonce = codec.uint64toNonce(0);
+    return cipherLoop(kCipherBytes, [&](Bytes &block) {
+      return codec.encrypt(nonce, BytesIn{block}.first(kBlockSize), {})
+          .has_value();
+    });
+  }
+
+  std::optional<Result> chachaSealInPlace() {
+    ChaCha20Poly1305Impl codec({});
+    auto nonce = codec.uint64toNonce(0);
+    return cipherLoop(kCipherBytes, [&](Bytes &block) {
+      return codec.seal(nonce, BytesIn{block}.first(kBlockSize), {}, block)
+          .has_value();
+    });
+  }
+
+  template <typename Secret>
+  std::optional<Result> aesCtr() {
+    AesCtrImpl cipher(Secret{}, AesCtrImpl::Mode::ENCRYPT);
+    return cipherLoop(kCipherBytes, [&](Bytes &block) {
+      return cipher.crypt(BytesIn{block}.first(kBlockSize)).has_value();
+    });
+  }
+
+  SecurePair noisePair(PipeEnv &env) {
+    auto suite = libp2p::security::noise::defaultCipherSuite();
+    auto marshaller = std::make_shared<KeyMarshallerImpl>(nullptr);
+    Key32 k1{};
+    Key32 k2{};
+    k1.fill(1);
+    k2.fill(2);
+    auto client = std::make_shared<NoiseConnection>(
+        env.client_pipe,
+        PublicKey{},
+        PublicKey{},
+        marshaller,
+        std::make_shared<CipherState>(suite, k1),
+        std::make_shared<CipherState>(suite, k2));
+    auto server = std::make_shared<NoiseConnection>(
+        env.server_pipe,
+        PublicKey{},
+        PublicKey{},
+        marshaller,
+        std::make_shared<CipherState>(suite, k2),
+        std::make_shared<CipherState>(suite, k1));
+    return {client, server};
+  }
+
+  SecurePair secioPair(PipeEnv &env) {
+    auto hmac = std::make_shared<libp2p::crypto::hmac::HmacProviderImpl>();
+    auto marshaller = std::make_shared<KeyMarshallerImpl>(nullptr);
+    auto key = [](uint8_t seed) {
+      return StretchedKey{Bytes(16, seed), Bytes(16, seed), Bytes(32, seed)};
+    };
+    auto make = [&](std::shared_ptr<MemoryPipe> pipe,
+                    StretchedKey local,
+                    StretchedKey remote) {
+      auto connection = std::make_shared<SecioConnection>(
+          std::move(pipe),
+          hmac,
+          marshaller,
+          PublicKey{},
+          PublicKey{},
+          libp2p::crypto::common::HashType::SHA256,
+          libp2p::crypto::common::CipherType::AES128,
+          std::move(local),
+          std::move(remote));
+      return connection->init() ? connection : nullptr;
+    };
+    return {make(env.client_pipe, key(1), key(2)),
+            make(env.server_pipe, key(2), key(1))};
+  }
+
+  /// One-way transfer of `total` bytes through a secure connection pair
+  std::optional<Result> transfer(const SecureFactory &factory, size_t total) {
+    size_t received = 0;
+    std::function<void()> read;
+    std::function<void(size_t)> write;
+    Bytes chunk(kWriteChunkSize, 0x42);
+    Bytes buffer(kBlockSize);
+    PipeEnv env;
+    auto [writer, reader] = factory(env);
+    if (!writer || !reader) {
+      return std::nullopt;
+    }
+
+    read = [&, reader{reader}] {
+      reader->readSome(buffer, [&](outcome::result<size_t> res) {
+        if (res) {
+          received += res.value();
+          if (received < total) {
+            read();
+          }
+        }
+      });
+    };
+    write = [&, writer{writer}](size_t remaining) {
+      auto n = std::min(remaining, chunk.size());
+      libp2p::write(writer,
+                    BytesIn{chunk}.first(n),
+                    [&, remaining, n](VoidResult res) {
+                      if (res && remaining != n) {
+                        write(remaining - n);
+                      }
+                    });
+    };
+    auto started = Clock::now();
+    read();
+    write(total);
+    if (!env.runUntil([&] { return received == total; })) {
+      return std::nullopt;
+    }
+    return Result{static_cast<double>(total) / kMiB / secondsSince(started),
+                  "MiB/s"};
+  }
+
+  std::shared_ptr<CryptoProvider> cryptoProvider() {
+    namespace crypto = libp2p::crypto;
+    auto random = std::make_shared<crypto::random::BoostRandomGenerator>();
+    return std::make_shared<CryptoProviderImpl>(
+        random,
+        std::make_shared<crypto::ed25519::Ed25519ProviderImpl>(),
+        std::make_shared<crypto::rsa::RsaProviderImpl>(),
+        std::make_shared<crypto::ecdsa::EcdsaProviderImpl>(),
+        std::make_shared<crypto::secp256k1::Secp256k1ProviderImpl>(random),
+        std::make_shared<crypto::hmac::HmacProviderImpl>());
+  }
+
+  /// Sequential Noise handshakes between two identities, each over new pipes
+  std::optional<Result> noiseHandshakes(size_t count) {
+    auto crypto = cryptoProvider();
+    auto marshaller = std::make_shared<KeyMarshallerImpl>(
+        std::make_shared<KeyValidatorImpl>(crypto));
+    auto client_key = crypto->generateKeys(
+        libp2p::crypto::Key::Type::Ed25519,
+        libp2p::crypto::common::RSAKeyType::RSA2048);
+    auto server_key = crypto->generateKeys(
+        libp2p::crypto::Key::Type::Ed25519,
+        libp2p::crypto::common::RSAKeyType::RSA2048);
+    if (!client_key || !server_key) {
+      return std::nullopt;
+    }
+    auto server_id = PeerId::fromPublicKey(
+        marshaller->marshal(server_key.value().publicKey).value());
+    auto client = std::make_shared<Noise>(
+        client_key.value(), crypto, marshaller, nullptr);
+    auto server = std::make_shared<Noise>(
+        server_key.value(), crypto, marshaller, nullptr);
+
+    using SecureResult = outcome::result<std::shared_ptr<SecureConnection>>;
+    auto started = Clock::now();
+    for (size_t i = 0; i < count; ++i) {
+      PipeEnv env;
+      size_t secured = 0;
+      auto cb = [&](SecureResult res) {
+        if (res) {
+          ++secured;
+        }
+      };
+      server->secureInbound(env.server_pipe, cb);
+      client->secureOutbound(env.client_pipe, server_id.value(), cb);
+      if (!env.runUntil([&] { return secured == 2; })) {
+        return std::nullopt;
+      }
+    }
+    return Result{static_cast<double>(count) / secondsSince(started),
+                  "handshakes/s"};
+  }
+}  // namespace
+
+int main(int argc, char **argv) {
+  testutil::prepareLoggers(soralog::Level::ERROR);
+  std::string filter = argc > 1 ? argv[1] : "";
+
+  using Run = std::function<std::optional<Result>()>;
+  std::vector<std::pair<std::string, Run>> scenarios{
+      {"chachapoly/encrypt", chachaEncrypt},
+      {"chachapoly/seal-in-place", chachaSealInPlace},
+      {"aes-ctr/128", aesCtr<libp2p::crypto::common::Aes128Secret>},
+      {"aes-ctr/256", aesCtr<libp2p::crypto::common::Aes256Secret>},
+      {"noise/transfer", [] { return transfer(noisePair, kTransferBytes); }},
+      {"secio/transfer", [] { return transfer(secioPair, kTransferBytes); }},
+      {"noise/handshake", [] { return noiseHandshakes(2000); }},
+  };
+
+  int status = EXIT_SUCCESS;
+  for (auto &[name, run] : scenarios) {
+    if (name.find(filter) == std::string::npos) {
+      continue;
+    }
+    if (!report(name, run())) {
+      status = EXIT_FAILURE;
+    }
+  }
+  return status;
+}
@@ -0,0 +1,308 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Throughput benchmark for stream multiplexers.
+ *
+ * Two muxer instances are connected back to back through an in-memory secure
+ * connection pair and driven by the manual scheduler backend, so results
+ * reflect muxer overhead only (no sockets, no encryption).
+ *
+ * Usage: muxer_benchmark [filter]
+ * Only scenarios whose name contains `filter` are run.
+ */
+
+#include <cstdlib>
+
+#include <libp2p/basic/read.hpp>
+#include <libp2p/basic/write.hpp>
+#include <libp2p/connection/stream.hpp>
+#include <libp2p/muxer/mplex/mplexed_connection.hpp>
+#include <libp2p/muxer/yamux/yamuxed_connection.hpp>
+#include <testutil/prepare_loggers.hpp>
+#include "benchmark/benchmark_util.hpp"
+
+namespace {
+  using namespace testutil;
+  using libp2p::connection::CapableConnection;
+  using libp2p::connection::MplexedConnection;
+  using libp2p::connection::Stream;
+  using libp2p::connection::YamuxedConnection;
+  using libp2p::muxer::MuxedConnectionConfig;
+
+  using MuxerFactory = std::function<std::shared_ptr<CapableConnection>(
+      std::shared_ptr<SecureConnection>, std::shared_ptr<Scheduler>)>;
+
+  /// Muxer pair connected through memory pipes
+  struct Env : PipeEnv {
+    explicit Env(const MuxerFactory &factory) {
+      client = factory(client_pipe, scheduler);
+      server = factory(server_pipe, scheduler);
+    }
+
+    ~Env() {
+      client->stop();
+      server->stop();
+      backend->shift(std::chrono::milliseconds::zero());
+    }
+
+    void start() {
+      client->start();
+      server->start();
+    }
+
+    std::shared_ptr<CapableConnection> client;
+    std::shared_ptr<CapableConnection> server;
+  };
+
+  using StreamResult = outcome::result<std::shared_ptr<Stream>>;
+  using VoidResult = outcome::result<void>;
+
+  constexpr size_t kChunkSize = 64 * 1024;
+  constexpr size_t kRpcMessageSize = 64;
+
+  /// Reads from `stream` until it fails or reaches EOF
+  void drain(std::shared_ptr<Stream> stream,
+             std::shared_ptr<Bytes> buffer,
+             std::function<void(size_t)> on_data,
+             std::function<void()> on_eof) {
+    auto out = BytesOut{*buffer};
+    stream->readSome(out,
+                     [stream,
+                      buffer,
+                      on_data{std::move(on_data)},
+                      on_eof{std::move(on_eof)}](
+                         outcome::result<size_t> res) mutable {
+                       if (!res) {
+                         return on_eof();
+                       }
+                       on_data(res.value());
+                       drain(std::move(stream),
+                             std::move(buffer),
+                             std::move(on_data),
+                             std::move(on_eof));
+                     });
+  }
+
+  /// Writes `remaining` bytes to `stream` chunk by chunk, then closes it
+  void pump(std::shared_ptr<Stream> stream,
+            std::shared_ptr<const Bytes> chunk,
+            size_t remaining) {
+    if (remaining == 0) {
+      stream->close([stream](VoidResult) {});
+      return;
+    }
+    auto n = std::min(remaining, chunk->size());
+    libp2p::write(stream,
+                  BytesIn{*chunk}.first(n),
+                  [stream, chunk, remaining, n](VoidResult res) {
+                    if (res) {
+                      pump(stream, chunk, remaining - n);
+                    }
+                  });
+  }
+
+  /// Sends every request back to the caller
+  void echo(std::shared_ptr<Stream> stream, std::shared_ptr<Bytes> buffer) {
+    libp2p::read(stream, *buffer, [stream, buffer](VoidResult res) {
+      if (!res) {
+        stream->close([stream](VoidResult) {});
+        return;
+      }
+      libp2p::write(stream, *buffer, [stream, buffer](VoidResult res) {
+        if (res) {
+          echo(stream, buffer);
+        }
+      });
+    });
+  }
+
+  /// Throughput of `streams` concurrent bulk transfers
+  std::optional<Result> bulk(const MuxerFactory &factory,
+                             size_t streams,
+                             size_t bytes_per_stream) {
+    size_t received = 0;
+    auto total = streams * bytes_per_stream;
+    Env env(factory);
+    env.server->onStream([&](std::shared_ptr<Stream> stream) {
+      drain(
+          stream,
+          std::make_shared<Bytes>(kChunkSize),
+          [&](size_t n) { received += n; },
+          [stream] { stream->close([stream](VoidResult) {}); });
+    });
+    env.start();
+
+    auto chunk = std::make_shared<const Bytes>(kChunkSize, 0x42);
+    auto started = Clock::now();
+    for (size_t i = 0; i < streams; ++i) {
+      env.client->newStream([chunk, bytes_per_stream](StreamResult res) {
+        if (res) {
+          pump(res.value(), chunk, bytes_per_stream);
+        }
+      });
+    }
+    if (!env.runUntil([&] { return received == total; })) {
+      return std::nullopt;
+    }
+    return Result{static_cast<double>(received) / kMiB
+                      / secondsSince(started),
+                  "MiB/s"};
+  }
+
+  /// Request/response round trips over one stream
+  std::optional<Result> rpc(const MuxerFactory &factory, size_t messages) {
+    size_t done = 0;
+    std::shared_ptr<Stream> stream;
+    std::function<void()> call;
+    Bytes request(kRpcMessageSize, 0x42);
+    Bytes response(kRpcMessageSize);
+    Env env(factory);
+    env.server->onStream([](std::shared_ptr<Stream> stream) {
+      echo(stream, std::make_shared<Bytes>(kRpcMessageSize));
+    });
+    env.start();
+
+    env.client->newStream([&](StreamResult res) {
+      if (res) {
+        stream = res.value();
+      }
+    });
+    if (!env.runUntil([&] { return stream != nullptr; })) {
+      return std::nullopt;
+    }
+    call = [&] {
+      libp2p::write(stream, request, [&](VoidResult res) {
+        if (!res) {
+          return;
+        }
+        libp2p::read(stream, response, [&](VoidResult res) {
+          if (res && ++done < messages) {
+            call();
+          }
+        });
+      });
+    };
+    auto started = Clock::now();
+    call();
+    if (!env.runUntil([&] { return done == messages; })) {
+      return std::nullopt;
+    }
+    return Result{static_cast<double>(done) / secondsSince(started),
+                  "msg/s"};
+  }
+
+  /// Sequential request/response exchanges, each over a fresh stream
+  std::optional<Result> openClose(const MuxerFactory &factory, size_t count) {
+    size_t done = 0;
+    std::function<void()> open;
+    Bytes request(kRpcMessageSize, 0x42);
+    Bytes response(kRpcMessageSize);
+    Env env(factory);
+    env.server->onStream([](std::shared_ptr<Stream> stream) {
+      auto buffer = std::make_shared<Bytes>(kRpcMessageSize);
+      libp2p::read(stream, *buffer, [stream, buffer](VoidResult res) {
+        if (!res) {
+          return stream->reset();
+        }
+        libp2p::write(stream, *buffer, [stream, buffer](VoidResult res) {
+          if (res) {
+            stream->close([stream](VoidResult) {});
+          }
+        });
+      });
+    });
+    env.start();
+
+    open = [&] {
+      env.client->newStream([&](StreamResult res) {
+        if (!res) {
+          return;
+        }
+        auto stream = res.value();
+        libp2p::write(stream, request, [&, stream](VoidResult res) {
+          if (!res) {
+            return;
+          }
+          libp2p::read(stream, response, [&, stream](VoidResult res) {
+            if (!res) {
+              return;
+            }
+            stream->close([&, stream](VoidResult) {
+              if (++done < count) {
+                open();
+              }
+            });
+          });
+        });
+      });
+    };
+    auto started = Clock::now();
+    open();
+    if (!env.runUntil([&] { return done == count; })) {
+      return std::nullopt;
+    }
+    return Result{static_cast<double>(done) / secondsSince(started),
+                  "streams/s"};
+  }
+
+  MuxerFactory yamux(MuxedConnectionConfig config) {
+    return [config](std::shared_ptr<SecureConnection> connection,
+                    std::shared_ptr<Scheduler> scheduler) {
+      return std::make_shared<YamuxedConnection>(
+          std::move(connection), std::move(scheduler), nullptr, config);
+    };
+  }
+
+  MuxerFactory mplex(MuxedConnectionConfig config) {
+    config.mplex_overflow_policy =
+        MuxedConnectionConfig::MplexOverflowPolicy::PAUSE;
+    return [config](std::shared_ptr<SecureConnection> connection,
+                    std::shared_ptr<Scheduler>) {
+      return std::make_shared<MplexedConnection>(std::move(connection),
+                                                 config);
+    };
+  }
+}  // namespace
+
+int main(int argc, char **argv) {
+  testutil::prepareLoggers(soralog::Level::ERROR);
+  std::string filter = argc > 1 ? argv[1] : "";
+
+  MuxedConnectionConfig coalescing;
+  coalescing.write_coalescing = true;
+  std::vector<std::pair<std::string, MuxerFactory>> muxers{
+      {"yamux", yamux({})},
+      {"yamux-coalescing", yamux(coalescing)},
+      {"mplex", mplex({})},
+  };
+
+  using Run = std::function<std::optional<Result>(const MuxerFactory &)>;
+  std::vector<std::pair<std::string, Run>> scenarios{
+      {"bulk/1-stream",
+       [](const MuxerFactory &f) { return bulk(f, 1, 256 * kMiB); }},
+      {"bulk/16-streams",
+       [](const MuxerFactory &f) { return bulk(f, 16, 16 * kMiB); }},
+      {"rpc/64-bytes",
+       [](const MuxerFactory &f) { return rpc(f, 100000); }},
+      {"open-close",
+       [](const MuxerFactory &f) { return openClose(f, 10000); }},
+  };
+
+  int status = EXIT_SUCCESS;
+  for (auto &[muxer, factory] : muxers) {
+    for (auto &[scenario, run] : scenarios) {
+      auto name = muxer + "/" + scenario;
+      if (name.find(filter) == std::string::npos) {
+        continue;
+      }
+      if (!report(name, run(factory))) {
+        status = EXIT_FAILURE;
+      }
+    }
+  }
+  return status;
+}
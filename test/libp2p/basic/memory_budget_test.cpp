@@ -0,0 +1,85 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <libp2p/basic/memory_budget.hpp>
+
+using libp2p::basic::MemoryBudget;
+
+/**
+ * @given memory budget
+ * @when bytes are reserved and released
+ * @then reservations beyond limit are refused or truncated
+ */
+TEST(MemoryBudget, Limit) {
+  MemoryBudget budget{100};
+  EXPECT_TRUE(budget.reserve(60));
+  EXPECT_FALSE(budget.reserve(60));
+  EXPECT_EQ(budget.available(), 40);
+  EXPECT_EQ(budget.reserveUpTo(60), 40);
+  EXPECT_EQ(budget.available(), 0);
+  budget.release(100);
+  EXPECT_EQ(budget.used(), 0);
+  EXPECT_TRUE(budget.reserve(100));
+}
+
+/**
+ * @given connection budgets sharing host budget
+ * @when bytes are reserved in connection budgets
+ * @then host budget limits them, and gets reservations back on destruction
+ */
+TEST(MemoryBudget, Parent) {
+  auto host = std::make_shared<MemoryBudget>(100);
+  MemoryBudget conn1{80, host};
+  {
+    MemoryBudget conn2{80, host};
+    EXPECT_TRUE(conn1.reserve(50));
+    EXPECT_EQ(conn2.available(), 50);
+    EXPECT_FALSE(conn2.reserve(60));
+    EXPECT_EQ(conn2.reserveUpTo(60), 50);
+    EXPECT_EQ(host->used(), 100);
+    EXPECT_EQ(conn1.available(), 0);
+  }
+  EXPECT_EQ(host->used(), 50);
+  EXPECT_EQ(conn1.available(), 30);
+  conn1.release(50);
+  EXPECT_EQ(host->used(), 0);
+}
+
+/**
+ * @given host budget shared by connection budgets in different threads
+ * @when they reserve and release concurrently
+ * @then host budget is never exceeded and is balanced in the end
+ */
+TEST(MemoryBudget, SharedByThreads) {
+  constexpr size_t kLimit = 1000;
+  auto host = std::make_shared<MemoryBudget>(kLimit);
+  std::atomic_bool exceeded = false;
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      MemoryBudget conn{kLimit, host};
+      for (auto j = 0; j < 10000; ++j) {
+        auto reserved = conn.reserveUpTo(j % 300);
+        if (host->used() > kLimit) {
+          exceeded = true;
+        }
+        if (conn.reserve(j % 7)) {
+          reserved += j % 7;
+        }
+        conn.release(reserved);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_FALSE(exceeded);
+  EXPECT_EQ(host->used(), 0);
+}
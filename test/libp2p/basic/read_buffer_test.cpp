@@ -0,0 +1,167 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <thread>
+
+#include <libp2p/basic/read_buffer.hpp>
+
+using libp2p::Bytes;
+using libp2p::BytesIn;
+using libp2p::basic::ReadBuffer;
+using libp2p::basic::UninitializedBytes;
+
+namespace {
+  std::shared_ptr<UninitializedBytes> makeBytes(size_t size) {
+    auto bytes = std::make_shared<UninitializedBytes>(size);
+    std::iota(bytes->begin(), bytes->end(), 0);
+    return bytes;
+  }
+}  // namespace
+
+/**
+ * @given read buffer
+ * @when large part of shared memory is added
+ * @then it is referenced, not copied
+ */
+TEST(ReadBuffer, SharedFragmentIsReferenced) {
+  auto owner = makeBytes(100);
+  ReadBuffer buffer;
+  buffer.add(BytesIn{*owner}.subspan(10, 50), owner);
+  EXPECT_EQ(owner.use_count(), 2);
+  EXPECT_EQ(buffer.size(), 50);
+
+  Bytes out(20);
+  EXPECT_EQ(buffer.consume(out), 20);
+  EXPECT_EQ(out, Bytes(owner->begin() + 10, owner->begin() + 30));
+  EXPECT_EQ(owner.use_count(), 2);
+
+  out.resize(100);
+  EXPECT_EQ(buffer.consume(out), 30);
+  out.resize(30);
+  EXPECT_EQ(out, Bytes(owner->begin() + 30, owner->begin() + 60));
+  EXPECT_EQ(owner.use_count(), 1);
+}
+
+/**
+ * @given read buffer
+ * @when small part of shared memory is added
+ * @then it is copied, not to pin the whole memory
+ */
+TEST(ReadBuffer, SmallSharedFragmentIsCopied) {
+  auto owner = makeBytes(ReadBuffer::kMaxSharedOverhead * 10);
+  ReadBuffer buffer;
+  buffer.add(BytesIn{*owner}.first(9), owner);
+  EXPECT_EQ(owner.use_count(), 1);
+  buffer.add(BytesIn{*owner}.subspan(9, 10), owner);
+  EXPECT_EQ(owner.use_count(), 2);
+  buffer.add(BytesIn{*owner}.subspan(19, 1), owner);
+
+  Bytes out(20);
+  EXPECT_EQ(buffer.addAndConsume(BytesIn{*owner}.subspan(20), out, owner), 20);
+  EXPECT_EQ(out, Bytes(owner->begin(), owner->begin() + 20));
+  EXPECT_EQ(buffer.size(), owner->size() - 20);
+  buffer.clear();
+  EXPECT_EQ(owner.use_count(), 1);
+}
+
+/**
+ * @given read buffer with buffer pool
+ * @when data is added and consumed
+ * @then fragments are returned to pool and reused
+ */
+TEST(ReadBuffer, PooledFragments) {
+  auto pool = std::make_shared<libp2p::basic::BufferPool>();
+  auto small = makeBytes(1000);
+  auto large = makeBytes(8000);
+  {
+    ReadBuffer buffer(4096, pool);
+    buffer.add(*small);
+    EXPECT_EQ(pool->stats().misses, 1);
+    // fragment is reallocated to larger capacity, previous one is pooled
+    buffer.add(*large);
+    EXPECT_EQ(pool->stats().misses, 2);
+    EXPECT_EQ(pool->stats().resident_bytes, 4096);
+
+    Bytes out(small->size() + large->size());
+    EXPECT_EQ(buffer.consume(out), out.size());
+    Bytes expected(small->begin(), small->end());
+    expected.insert(expected.end(), large->begin(), large->end());
+    EXPECT_EQ(out, expected);
+    EXPECT_EQ(pool->stats().resident_bytes, 4096 + 16384);
+  }
+
+  ReadBuffer buffer(4096, pool);
+  buffer.add(*small);
+  EXPECT_EQ(pool->stats().hits, 1);
+  EXPECT_EQ(pool->stats().resident_bytes, 16384);
+}
+
+/**
+ * @given read buffer with buffer pool and some data
+ * @when buffer is reset for reuse
+ * @then data is dropped, fragments are returned to pool
+ */
+TEST(ReadBuffer, ResetForReuse) {
+  auto pool = std::make_shared<libp2p::basic::BufferPool>();
+  auto data = makeBytes(1000);
+  ReadBuffer buffer(4096, pool);
+  buffer.add(*data);
+  buffer.reset();
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(pool->stats().resident_bytes, 4096);
+
+  buffer.add(*data);
+  EXPECT_EQ(pool->stats().hits, 1);
+  Bytes out(data->size());
+  EXPECT_EQ(buffer.consume(out), out.size());
+  EXPECT_EQ(out, Bytes(data->begin(), data->end()));
+}
+
+/**
+ * @given read buffer with buffer pool and default granularity
+ * @when data of granularity size is added
+ * @then fragment takes granularity size class, not the next one
+ */
+TEST(ReadBuffer, PooledFragmentFitsGranularity) {
+  auto pool = std::make_shared<libp2p::basic::BufferPool>();
+  auto data = makeBytes(ReadBuffer::kDefaultAllocGranularity);
+  ReadBuffer buffer(ReadBuffer::kDefaultAllocGranularity, pool);
+  buffer.add(*data);
+  buffer.reset();
+  EXPECT_EQ(pool->stats().resident_bytes,
+            ReadBuffer::kDefaultAllocGranularity);
+}
+
+/**
+ * @given buffer pool shared by several threads
+ * @when they acquire and release buffers concurrently
+ * @then pool stats stay consistent
+ */
+TEST(BufferPool, SharedByThreads) {
+  constexpr size_t kThreads = 4;
+  constexpr size_t kIterations = 1000;
+  libp2p::basic::BufferPool pool;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&] {
+      for (size_t i = 0; i < kIterations; ++i) {
+        auto buffer = pool.acquire(5000);
+        buffer.resize(5000);
+        pool.release(std::move(buffer));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto stats = pool.stats();
+  EXPECT_EQ(stats.hits + stats.misses, kThreads * kIterations);
+  EXPECT_LE(stats.misses, kThreads);
+  EXPECT_EQ(stats.resident_bytes, stats.misses * 8192);
+}
@@ -0,0 +1,106 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <libp2p/basic/write.hpp>
+
+using libp2p::Bytes;
+using libp2p::BytesIn;
+using libp2p::basic::Writer;
+
+/// Writer which writes at most `limit` bytes per call
+struct LimitedWriter : Writer {
+  explicit LimitedWriter(size_t limit) : limit{limit} {}
+
+  void writeSome(BytesIn in, WriteCallbackFunc cb) override {
+    auto n = std::min(limit, in.size());
+    written.insert(written.end(), in.begin(), in.begin() + n);
+    ++calls;
+    cb(n);
+  }
+
+  void writeSomeV(std::span<const BytesIn> in, WriteCallbackFunc cb) override {
+    size_t n = 0;
+    for (auto &buffer : in) {
+      auto k = std::min(limit - n, buffer.size());
+      written.insert(written.end(), buffer.begin(), buffer.begin() + k);
+      n += k;
+    }
+    ++calls;
+    cb(n);
+  }
+
+  void deferWriteCallback(std::error_code ec, WriteCallbackFunc cb) override {
+    cb(ec);
+  }
+
+  size_t limit;
+  size_t calls = 0;
+  Bytes written;
+};
+
+/**
+ * @given writer which writes a few bytes per call
+ * @when writing buffer sequence with writeV
+ * @then all buffers are written in order, buffer boundaries don't matter
+ */
+TEST(WriteV, PartialWrites) {
+  Bytes a{1, 2, 3}, b{}, c{4, 5, 6, 7, 8};
+  Bytes expected{1, 2, 3, 4, 5, 6, 7, 8};
+  for (size_t limit = 1; limit <= expected.size(); ++limit) {
+    auto writer = std::make_shared<LimitedWriter>(limit);
+    std::array<BytesIn, 3> buffers{a, b, c};
+    bool done = false;
+    libp2p::writeV(writer, buffers, [&](outcome::result<void> r) {
+      EXPECT_TRUE(r.has_value());
+      done = true;
+    });
+    EXPECT_TRUE(done);
+    EXPECT_EQ(writer->written, expected);
+    EXPECT_EQ(writer->calls, (expected.size() + limit - 1) / limit);
+  }
+}
+
+/**
+ * @given writer without own vectored write implementation
+ * @when writing buffer sequences with writeSomeV
+ * @then several non-empty buffers are joined and written with one writeSome,
+ * single non-empty buffer is written as is
+ */
+TEST(WriteV, DefaultWriteSomeV) {
+  struct Simple : Writer {
+    void writeSome(BytesIn in, WriteCallbackFunc cb) override {
+      written.assign(in.begin(), in.end());
+      data = in.data();
+      ++calls;
+      cb(in.size());
+    }
+    void deferWriteCallback(std::error_code ec, WriteCallbackFunc cb) override {
+      cb(ec);
+    }
+    Bytes written;
+    const uint8_t *data = nullptr;
+    size_t calls = 0;
+  } writer;
+  Bytes a{}, b{1, 2}, c{3};
+  std::array<BytesIn, 3> buffers{a, b, c};
+  size_t n = 0;
+  writer.writeSomeV(buffers, [&](outcome::result<size_t> r) {
+    n = r.value();
+  });
+  EXPECT_EQ(n, 3);
+  EXPECT_EQ(writer.calls, 1);
+  EXPECT_EQ(writer.written, (Bytes{1, 2, 3}));
+
+  std::array<BytesIn, 2> single{a, b};
+  writer.writeSomeV(single, [&](outcome::result<size_t> r) {
+    n = r.value();
+  });
+  EXPECT_EQ(n, 2);
+  EXPECT_EQ(writer.written, b);
+  EXPECT_EQ(writer.data, b.data());
+}
@@ -0,0 +1,54 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/common/lru_cache.hpp>
+
+#include <gtest/gtest.h>
+
+using libp2p::LruCache;
+
+/**
+ * @given cache of capacity 2
+ * @when third key is inserted
+ * @then least recently used key is evicted and counted
+ */
+TEST(LruCacheTest, EvictsLeastRecentlyUsed) {
+  LruCache<int, int> cache{2};
+  cache.put(1, 10);
+  cache.put(2, 20);
+  ASSERT_EQ(cache.get(1), 10);
+  cache.put(3, 30);
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_EQ(cache.get(2), std::nullopt);
+  ASSERT_EQ(cache.get(1), 10);
+  ASSERT_EQ(cache.get(3), 30);
+  ASSERT_EQ(cache.stats().evictions, 1);
+}
+
+/**
+ * @given empty cache
+ * @when getOrMake is called twice for the same key and once with error
+ * @then value is made once, error is not cached, counters are updated
+ */
+TEST(LruCacheTest, GetOrMake) {
+  LruCache<int, int> cache{4};
+  int made = 0;
+  auto make = [&]() -> outcome::result<int> { return ++made; };
+  ASSERT_EQ(cache.getOrMake(1, make).value(), 1);
+  ASSERT_EQ(cache.getOrMake(1, make).value(), 1);
+  ASSERT_EQ(made, 1);
+
+  auto fail = []() -> outcome::result<int> {
+    return std::errc::invalid_argument;
+  };
+  ASSERT_FALSE(cache.getOrMake(2, fail));
+  ASSERT_EQ(cache.size(), 1);
+
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.hits, 1);
+  ASSERT_EQ(stats.misses, 2);
+  ASSERT_DOUBLE_EQ(stats.hitRate(), 1.0 / 3);
+}
@@ -158,3 +158,31 @@ TEST_F(ChaChaPolyTest, Decrypt) {
   ASSERT_OUTCOME_SUCCESS(result, codec.decrypt(nonce, ciphertext, aad));
   ASSERT_EQ(result, plaintext);
 }
+
+/**
+ * @given CCP codec
+ * @when the predefined input is encrypted and then decrypted in place
+ * @then buffer contents match expected ciphertext and then plaintext, and
+ * the same codec can be reused for next calls
+ */
+TEST_F(ChaChaPolyTest, InPlace) {
+  ChaCha20Poly1305Impl codec(key);
+  using libp2p::crypto::chachapoly::kTagSize;
+
+  for (auto i = 0; i < 2; ++i) {
+    Bytes buffer = plaintext;
+    buffer.resize(plaintext.size() + kTagSize);
+    ASSERT_OUTCOME_SUCCESS(
+        sealed,
+        codec.seal(nonce,
+                   std::span{buffer}.first(plaintext.size()),
+                   aad,
+                   buffer));
+    ASSERT_EQ(sealed, ciphertext.size());
+    ASSERT_EQ(buffer, ciphertext);
+
+    ASSERT_OUTCOME_SUCCESS(opened, codec.open(nonce, buffer, aad, buffer));
+    buffer.resize(opened);
+    ASSERT_EQ(buffer, plaintext);
+  }
+}
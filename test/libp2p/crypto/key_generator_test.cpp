@@ -111,6 +111,34 @@ TEST_P(KeyGeneratorTest, DerivePublicKeySuccess) {
   ASSERT_EQ(keys.publicKey.data, derived.data);
 }
 
+/**
+ * @given key pairs of type specified as parameter and signed messages
+ * @when verifyBatch is called with valid, tampered and malformed signatures
+ * @then the result matches one by one verification
+ */
+TEST_P(KeyGeneratorTest, VerifyBatch) {
+  auto key_type = GetParam();
+  ASSERT_OUTCOME_SUCCESS(keys1, crypto_provider_->generateKeys(key_type));
+  ASSERT_OUTCOME_SUCCESS(keys2, crypto_provider_->generateKeys(key_type));
+  auto msg1 = "first message"_v;
+  auto msg2 = "second message"_v;
+  ASSERT_OUTCOME_SUCCESS(sig1, crypto_provider_->sign(msg1, keys1.privateKey));
+  ASSERT_OUTCOME_SUCCESS(sig2, crypto_provider_->sign(msg2, keys2.privateKey));
+  auto tampered = sig2;
+  tampered.back() ^= 1;
+  Bytes malformed{1, 2, 3};
+
+  std::vector<libp2p::crypto::SignatureBatchItem> batch{
+      {msg1, sig1, keys1.publicKey},
+      {msg2, sig2, keys2.publicKey},
+      {msg2, tampered, keys2.publicKey},
+      {msg1, sig1, keys2.publicKey},
+      {msg1, malformed, keys1.publicKey},
+  };
+  ASSERT_OUTCOME_SUCCESS(result, crypto_provider_->verifyBatch(batch));
+  ASSERT_EQ(result, (std::vector<bool>{true, true, false, false, false}));
+}
+
 INSTANTIATE_TEST_SUITE_P(TestAllKeyTypes,
                          KeyGeneratorTest,
                          ::testing::Values(Key::Type::RSA,
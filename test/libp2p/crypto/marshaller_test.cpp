@@ -137,3 +137,22 @@ INSTANTIATE_TEST_SUITE_P(Marshaller,
 INSTANTIATE_TEST_SUITE_P(Marshaller,
                          Privkey,
                          ::testing::ValuesIn(makeTestCases<PrivateKey>()));
+
+/**
+ * @given marshalled public key
+ * @when it is unmarshalled twice
+ * @then the second call is served from cache without validation
+ */
+TEST(MarshallerCache, UnmarshalPublicKeyCached) {
+  auto validator = std::make_shared<KeyValidatorMock>();
+  KeyMarshallerImpl marshaller{validator};
+  PublicKey key{{Key::Type::Ed25519, randomBuffer(32)}};
+  auto proto_key = marshaller.marshal(key).value();
+
+  EXPECT_CALL(*validator, validate(An<const PublicKey &>()))
+      .WillOnce(Return(outcome::success()));
+  ASSERT_EQ(marshaller.unmarshalPublicKey(proto_key).value(), key);
+  ASSERT_EQ(marshaller.unmarshalPublicKey(proto_key).value(), key);
+  ASSERT_EQ(marshaller.keyCacheStats().hits, 1);
+  ASSERT_EQ(marshaller.keyCacheStats().misses, 1);
+}
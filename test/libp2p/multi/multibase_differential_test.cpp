@@ -0,0 +1,356 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <optional>
+#include <random>
+#include <regex>
+
+#include <boost/algorithm/hex.hpp>
+#include <gtest/gtest.h>
+#include <libp2p/multi/multibase_codec/codecs/base16.hpp>
+#include <libp2p/multi/multibase_codec/codecs/base32.hpp>
+#include <libp2p/multi/multibase_codec/codecs/base58.hpp>
+#include <libp2p/multi/multibase_codec/codecs/base64.hpp>
+
+using libp2p::Bytes;
+using libp2p::BytesIn;
+namespace detail = libp2p::multi::detail;
+
+/**
+ * Straightforward bit stream codecs which follow behaviour of the previous
+ * byte-at-a-time implementations. Only success and decoded value are
+ * compared, error codes may differ
+ */
+namespace reference {
+  using Decoded = std::optional<Bytes>;
+
+  bool isUpper(std::string_view string) {
+    return std::all_of(string.begin(), string.end(), [](char c) {
+      return !std::isalpha(c) || std::isupper(c);
+    });
+  }
+
+  Decoded unhex(std::string_view string) {
+    Bytes out;
+    try {
+      boost::algorithm::unhex(
+          string.begin(), string.end(), std::back_inserter(out));
+    } catch (const std::exception &) {
+      return std::nullopt;
+    }
+    return out;
+  }
+
+  std::string encodeBase16Upper(BytesIn bytes) {
+    std::string out;
+    boost::algorithm::hex(bytes.begin(), bytes.end(), std::back_inserter(out));
+    return out;
+  }
+
+  std::string encodeBase16Lower(BytesIn bytes) {
+    std::string out;
+    boost::algorithm::hex_lower(
+        bytes.begin(), bytes.end(), std::back_inserter(out));
+    return out;
+  }
+
+  Decoded decodeBase16Upper(std::string_view string) {
+    return isUpper(string) ? unhex(string) : std::nullopt;
+  }
+
+  Decoded decodeBase16Lower(std::string_view string) {
+    return isUpper(string) ? std::nullopt : unhex(string);
+  }
+
+  std::string encodeBase32(BytesIn bytes, std::string_view alphabet) {
+    std::string out;
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (auto byte : bytes) {
+      buffer = buffer << 8 | byte;
+      bits += 8;
+      while (bits >= 5) {
+        bits -= 5;
+        out += alphabet[(buffer >> bits) & 0x1f];
+      }
+    }
+    if (bits > 0) {
+      out += alphabet[(buffer << (5 - bits)) & 0x1f];
+    }
+    return out;
+  }
+
+  Decoded decodeBase32(std::string_view string, std::string_view alphabet) {
+    Bytes out;
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (auto c : string) {
+      auto pos = alphabet.find(c);
+      if (pos == std::string_view::npos) {
+        return std::nullopt;
+      }
+      buffer = buffer << 5 | pos;
+      bits += 5;
+      if (bits >= 8) {
+        bits -= 8;
+        out.push_back(static_cast<uint8_t>(buffer >> bits));
+      }
+    }
+    return out;
+  }
+
+  constexpr std::string_view kBase32Upper = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+  constexpr std::string_view kBase32Lower = "abcdefghijklmnopqrstuvwxyz234567";
+  constexpr std::string_view kBase58 =
+      "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+  constexpr std::string_view kBase64 =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  std::string encodeBase58(BytesIn bytes) {
+    size_t zeroes = 0;
+    while (zeroes < bytes.size() && bytes[zeroes] == 0) {
+      ++zeroes;
+    }
+    std::vector<uint8_t> b58;
+    for (auto byte : bytes.subspan(zeroes)) {
+      int carry = byte;
+      for (auto &digit : b58) {
+        carry += 256 * digit;
+        digit = carry % 58;
+        carry /= 58;
+      }
+      while (carry != 0) {
+        b58.push_back(carry % 58);
+        carry /= 58;
+      }
+    }
+    std::string out(zeroes, '1');
+    for (auto it = b58.rbegin(); it != b58.rend(); ++it) {
+      out += kBase58[*it];
+    }
+    return out;
+  }
+
+  bool isSpace(char c) {
+    return c == ' ' || c == '\f' || c == '\n' || c == '\r' || c == '\t'
+        || c == '\v';
+  }
+
+  Decoded decodeBase58(std::string_view string) {
+    size_t pos = 0;
+    while (pos < string.size() && isSpace(string[pos])) {
+      ++pos;
+    }
+    size_t zeroes = 0;
+    while (pos < string.size() && string[pos] == '1') {
+      ++zeroes;
+      ++pos;
+    }
+    std::vector<uint8_t> b256;
+    for (; pos < string.size() && !isSpace(string[pos]); ++pos) {
+      auto digit = kBase58.find(string[pos]);
+      if (digit == std::string_view::npos) {
+        return std::nullopt;
+      }
+      auto carry = static_cast<int>(digit);
+      for (auto &byte : b256) {
+        carry += 58 * byte;
+        byte = carry % 256;
+        carry /= 256;
+      }
+      while (carry != 0) {
+        b256.push_back(carry % 256);
+        carry /= 256;
+      }
+    }
+    while (pos < string.size() && isSpace(string[pos])) {
+      ++pos;
+    }
+    if (pos != string.size()) {
+      return std::nullopt;
+    }
+    Bytes out(zeroes, 0);
+    out.insert(out.end(), b256.rbegin(), b256.rend());
+    return out;
+  }
+
+  std::string encodeBase64(BytesIn bytes) {
+    std::string out;
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (auto byte : bytes) {
+      buffer = buffer << 8 | byte;
+      bits += 8;
+      while (bits >= 6) {
+        bits -= 6;
+        out += kBase64[(buffer >> bits) & 0x3f];
+      }
+    }
+    if (bits > 0) {
+      out += kBase64[(buffer << (6 - bits)) & 0x3f];
+    }
+    while (out.size() % 4 != 0) {
+      out += '=';
+    }
+    return out;
+  }
+
+  Decoded decodeBase64(std::string_view string) {
+    static const std::regex base64_regex{"^[a-zA-Z0-9\\+/]*={0,2}$"};
+    if (string.size() % 4 != 0
+        || !std::regex_match(
+            string.begin(), string.end(), base64_regex)) {
+      return std::nullopt;
+    }
+    Bytes out;
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (auto c : string.substr(0, string.find('='))) {
+      buffer = buffer << 6 | kBase64.find(c);
+      bits += 6;
+      if (bits >= 8) {
+        bits -= 8;
+        out.push_back(static_cast<uint8_t>(buffer >> bits));
+      }
+    }
+    return out;
+  }
+}  // namespace reference
+
+namespace {
+  template <typename Result>
+  reference::Decoded toOptional(const Result &result) {
+    if (!result) {
+      return std::nullopt;
+    }
+    return result.value();
+  }
+
+  struct Codec {
+    std::string name;
+    std::function<std::string(BytesIn)> encode;
+    std::function<std::string(BytesIn)> reference_encode;
+    std::function<reference::Decoded(std::string_view)> decode;
+    std::function<reference::Decoded(std::string_view)> reference_decode;
+    /// chars used to make random strings for decoding
+    std::string chars;
+  };
+
+  template <typename Decode>
+  std::function<reference::Decoded(std::string_view)> wrap(Decode decode) {
+    return [decode](std::string_view string) {
+      return toOptional(decode(string));
+    };
+  }
+
+  std::vector<Codec> codecs() {
+    return {
+        {"base16-upper",
+         detail::encodeBase16Upper,
+         reference::encodeBase16Upper,
+         wrap(detail::decodeBase16Upper),
+         reference::decodeBase16Upper,
+         "0123456789ABCDEFabcdefXx "},
+        {"base16-lower",
+         detail::encodeBase16Lower,
+         reference::encodeBase16Lower,
+         wrap(detail::decodeBase16Lower),
+         reference::decodeBase16Lower,
+         "0123456789ABCDEFabcdefXx "},
+        {"base32-upper",
+         detail::encodeBase32Upper,
+         [](BytesIn bytes) {
+           return reference::encodeBase32(bytes, reference::kBase32Upper);
+         },
+         wrap(detail::decodeBase32Upper),
+         [](std::string_view string) {
+           return reference::decodeBase32(string, reference::kBase32Upper);
+         },
+         std::string{reference::kBase32Upper} + "a1=\xff"},
+        {"base32-lower",
+         detail::encodeBase32Lower,
+         [](BytesIn bytes) {
+           return reference::encodeBase32(bytes, reference::kBase32Lower);
+         },
+         wrap(detail::decodeBase32Lower),
+         [](std::string_view string) {
+           return reference::decodeBase32(string, reference::kBase32Lower);
+         },
+         std::string{reference::kBase32Lower} + "A1=\xff"},
+        {"base58",
+         detail::encodeBase58,
+         reference::encodeBase58,
+         wrap(detail::decodeBase58),
+         reference::decodeBase58,
+         std::string{reference::kBase58} + "111 \t0Il\xff"},
+        {"base64",
+         detail::encodeBase64,
+         reference::encodeBase64,
+         wrap(detail::decodeBase64),
+         reference::decodeBase64,
+         std::string{reference::kBase64} + "===-_\xff"},
+    };
+  }
+}  // namespace
+
+class MultibaseDifferentialTest : public ::testing::TestWithParam<Codec> {
+ protected:
+  std::mt19937 random{42};  // NOLINT
+};
+
+/**
+ * @given random byte strings of different sizes, some with leading zeroes
+ * @when they are encoded and decoded
+ * @then results equal the ones of reference codec
+ */
+TEST_P(MultibaseDifferentialTest, RandomBytes) {
+  const auto &codec = GetParam();
+  for (size_t size = 0; size <= 130; ++size) {
+    for (auto zeroes : {size_t{0}, size / 3}) {
+      Bytes bytes(size);
+      std::generate(bytes.begin(), bytes.end(), std::ref(random));
+      std::fill_n(bytes.begin(), zeroes, 0);
+      auto encoded = codec.encode(bytes);
+      ASSERT_EQ(encoded, codec.reference_encode(bytes)) << size;
+      auto decoded = codec.decode(encoded);
+      auto expected = codec.reference_decode(encoded);
+      ASSERT_EQ(decoded, expected) << encoded;
+      if (codec.name != "base16-lower" || decoded) {
+        ASSERT_EQ(decoded, bytes) << encoded;
+      }
+    }
+  }
+}
+
+/**
+ * @given random strings made of alphabet and some invalid chars
+ * @when they are decoded
+ * @then result equals the one of reference codec
+ */
+TEST_P(MultibaseDifferentialTest, RandomStrings) {
+  const auto &codec = GetParam();
+  std::uniform_int_distribution<size_t> pick(0, codec.chars.size() - 1);
+  for (size_t i = 0; i < 20000; ++i) {
+    std::string string(i % 24, ' ');
+    for (auto &c : string) {
+      c = codec.chars[pick(random)];
+    }
+    ASSERT_EQ(codec.decode(string), codec.reference_decode(string))
+        << '"' << string << '"';
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Codecs,
+    MultibaseDifferentialTest,
+    ::testing::ValuesIn(codecs()),
+    [](const ::testing::TestParamInfo<Codec> &info) {
+      auto name = info.param.name;
+      std::replace(name.begin(), name.end(), '-', '_');
+      return name;
+    });
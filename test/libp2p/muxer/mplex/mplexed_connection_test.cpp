@@ -0,0 +1,161 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/muxer/mplex/mplexed_connection.hpp>
+
+#include <gtest/gtest.h>
+#include <libp2p/muxer/mplex/mplex_frame.hpp>
+
+#include "mock/libp2p/connection/secure_connection_mock.hpp"
+
+using libp2p::Bytes;
+using libp2p::BytesIn;
+using libp2p::BytesOut;
+using libp2p::connection::MplexedConnection;
+using libp2p::connection::MplexFrame;
+using libp2p::connection::SecureConnectionMock;
+using libp2p::connection::Stream;
+using libp2p::muxer::MuxedConnectionConfig;
+using testing::_;
+using testing::Return;
+
+using Policy = MuxedConnectionConfig::MplexOverflowPolicy;
+
+/// Mplex connection over mocked secure connection. Reads are served from
+/// bytes received by test, writes complete immediately
+class MplexedConnectionTest : public testing::Test {
+ protected:
+  static constexpr size_t kBufferSize = 100;
+
+  void SetUp() override {
+    ON_CALL(*raw, isClosed()).WillByDefault(Return(false));
+    ON_CALL(*raw, close()).WillByDefault(Return(outcome::success()));
+    ON_CALL(*raw, readSome(_, _))
+        .WillByDefault([this](BytesOut out, auto cb) {
+          read_out = out;
+          read_cb = std::move(cb);
+          deliver();
+        });
+    ON_CALL(*raw, writeSome(_, _)).WillByDefault([this](BytesIn in, auto cb) {
+      written.insert(written.end(), in.begin(), in.end());
+      cb(in.size());
+    });
+  }
+
+  void start(Policy policy) {
+    MuxedConnectionConfig config;
+    config.mplex_overflow_policy = policy;
+    config.mplex_receive_buffer_size = kBufferSize;
+    connection = std::make_shared<MplexedConnection>(raw, config);
+    connection->onStream(
+        [this](std::shared_ptr<Stream> stream) { inbound = stream; });
+    connection->start();
+  }
+
+  /// Receives frame from peer, which opened stream 0
+  void receive(MplexFrame::Flag flag, Bytes data = {}) {
+    auto frame = libp2p::connection::createFrameBytes(flag, 0, data);
+    incoming.insert(incoming.end(), frame.begin(), frame.end());
+    deliver();
+  }
+
+  /// Completes pending read with received bytes
+  void deliver() {
+    if (!read_cb || incoming.empty()) {
+      return;
+    }
+    auto n = std::min(read_out.size(), incoming.size());
+    std::copy_n(incoming.begin(), n, read_out.begin());
+    incoming.erase(incoming.begin(), incoming.begin() + n);
+    auto cb = std::move(read_cb);
+    read_cb = nullptr;
+    cb(n);
+  }
+
+  /// True if stream 0 was reset by this side
+  bool resetSent() const {
+    auto frame = libp2p::connection::createFrameBytes(
+        MplexFrame::Flag::RESET_RECEIVER, 0);
+    return std::search(
+               written.begin(), written.end(), frame.begin(), frame.end())
+        != written.end();
+  }
+
+  /// Reads what is buffered by stream
+  Bytes read(size_t size) {
+    Bytes out(size);
+    size_t n = 0;
+    inbound->readSome(out, [&](outcome::result<size_t> r) { n = r.value(); });
+    out.resize(n);
+    return out;
+  }
+
+  std::shared_ptr<SecureConnectionMock> raw =
+      std::make_shared<testing::NiceMock<SecureConnectionMock>>();
+  std::shared_ptr<MplexedConnection> connection;
+  std::shared_ptr<Stream> inbound;
+
+  BytesOut read_out;
+  libp2p::basic::Reader::ReadCallbackFunc read_cb;
+  Bytes incoming;
+  Bytes written;
+};
+
+/**
+ * @given mplex connection with RESET overflow policy
+ * @when stream receives more data than its buffer can hold
+ * @then the stream is reset and counted, reading goes on
+ */
+TEST_F(MplexedConnectionTest, ResetOnOverflow) {
+  start(Policy::RESET);
+  receive(MplexFrame::Flag::NEW_STREAM);
+  ASSERT_TRUE(inbound);
+  receive(MplexFrame::Flag::MESSAGE_INITIATOR, Bytes(60, 1));
+  EXPECT_EQ(connection->stats().receive_buffered_bytes, 60);
+  receive(MplexFrame::Flag::MESSAGE_INITIATOR, Bytes(60, 2));
+
+  EXPECT_TRUE(resetSent());
+  auto stats = connection->stats();
+  EXPECT_EQ(stats.overflow_resets, 1);
+  EXPECT_EQ(stats.read_pauses, 0);
+  EXPECT_TRUE(read_cb);
+  EXPECT_TRUE(incoming.empty());
+}
+
+/**
+ * @given mplex connection with PAUSE overflow policy
+ * @when stream receives more data than its buffer can hold
+ * @then reading is paused until reader frees the buffer, then the held data
+ * is delivered and reading resumes
+ */
+TEST_F(MplexedConnectionTest, PauseThenResume) {
+  start(Policy::PAUSE);
+  receive(MplexFrame::Flag::NEW_STREAM);
+  ASSERT_TRUE(inbound);
+  receive(MplexFrame::Flag::MESSAGE_INITIATOR, Bytes(60, 1));
+  receive(MplexFrame::Flag::MESSAGE_INITIATOR, Bytes(60, 2));
+  receive(MplexFrame::Flag::MESSAGE_INITIATOR, Bytes(10, 3));
+
+  // paused, next frame is not read
+  auto stats = connection->stats();
+  EXPECT_EQ(stats.read_pauses, 1);
+  EXPECT_EQ(stats.receive_buffered_bytes, 60);
+  EXPECT_FALSE(read_cb);
+  EXPECT_FALSE(incoming.empty());
+
+  EXPECT_EQ(read(kBufferSize), Bytes(60, 1));
+  EXPECT_TRUE(incoming.empty());
+  EXPECT_TRUE(read_cb);
+  auto expected = Bytes(60, 2);
+  expected.insert(expected.end(), 10, 3);
+  EXPECT_EQ(read(kBufferSize), expected);
+
+  EXPECT_FALSE(resetSent());
+  stats = connection->stats();
+  EXPECT_EQ(stats.overflow_resets, 0);
+  EXPECT_EQ(stats.read_pauses, 1);
+  EXPECT_EQ(stats.receive_buffered_bytes, 0);
+}
@@ -6,13 +6,18 @@
 
 #include <cstdlib>
 #include <iosfwd>
+#include <optional>
+#include <utility>
 
 #include <gtest/gtest.h>
+#include <openssl/ssl.h>
 #include <boost/di/extension/scopes/shared.hpp>
 
 #include <libp2p/basic/read.hpp>
 #include <libp2p/basic/write.hpp>
 #include <libp2p/injector/host_injector.hpp>
+#include <libp2p/security/tls/ssl_context.hpp>
+#include <libp2p/security/tls/tls_session_cache.hpp>
 
 #define TRACE_ENABLED 1
 #include <libp2p/common/trace.hpp>
@@ -120,6 +125,8 @@ namespace libp2p::regression {
 
               std::forward<decltype(args)>(args)...);
       host_ = injector.template create<std::shared_ptr<Host>>();
+      ssl_context_ =
+          injector.template create<std::shared_ptr<security::SslContext>>();
 
       if (!jumbo_msg) {
         write_buf_ = std::make_shared<Bytes>(getId().toVector());
@@ -139,6 +146,40 @@ namespace libp2p::regression {
       return host_->getId();
     }
 
+    ~Node() {
+      auto ctx = ssl_context_->tls->native_handle();
+      if (SSL_CTX_get_app_data(ctx) == this) {
+        SSL_CTX_set_info_callback(ctx, nullptr);
+        SSL_CTX_set_app_data(ctx, nullptr);
+      }
+    }
+
+    const security::SslContext &sslContext() const {
+      return *ssl_context_;
+    }
+
+    /// Records whether TLS handshakes of this node resume a session
+    void trackTlsSessionReuse() {
+      auto ctx = ssl_context_->tls->native_handle();
+      SSL_CTX_set_app_data(ctx, this);
+      // HANDSHAKE_DONE is also reported for each post-handshake session
+      // ticket
+      SSL_CTX_set_info_callback(ctx, +[](const SSL *ssl, int where, int) {
+        if ((where & SSL_CB_HANDSHAKE_DONE) == 0) {
+          return;
+        }
+        auto node = static_cast<Node *>(
+            SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+        node->tls_session_reused_ = SSL_session_reused(ssl) == 1;
+      });
+    }
+
+    /// SSL_session_reused of the last TLS handshake, if any since the
+    /// previous call
+    std::optional<bool> takeTlsSessionReused() {
+      return std::exchange(tls_session_reused_, std::nullopt);
+    }
+
     void connect(const peer::PeerInfo &connect_to) {
       start();
       host_->newStream(connect_to,
@@ -200,7 +241,7 @@ namespace libp2p::regression {
                     });
     }
 
-    void stop() {
+    void disconnect() {
       if (accepted_stream_) {
         auto p = accepted_stream_->remotePeerId();
         if (p) {
@@ -215,7 +256,10 @@ namespace libp2p::regression {
               p.value());
         }
       }
+    }
 
+    void stop() {
+      disconnect();
       host_->stop();
     }
 
@@ -223,6 +267,8 @@ namespace libp2p::regression {
     const Behavior &behavior_;
     Stats stats_;
     std::shared_ptr<libp2p::Host> host_;
+    std::shared_ptr<security::SslContext> ssl_context_;
+    std::optional<bool> tls_session_reused_;
     std::shared_ptr<connection::Stream> accepted_stream_;
     std::shared_ptr<connection::Stream> connected_stream_;
     std::shared_ptr<Bytes> read_buf_;
@@ -516,6 +562,110 @@ void testOutboundConnectionAcceptsStreams(InjectorArgs &&...args) {
   }
 }
 
+template <typename... InjectorArgs>
+void testTlsReconnect(bool mismatch_identity, InjectorArgs &&...args) {
+  using namespace libp2p::regression;  // NOLINT
+
+  constexpr size_t kServerId = 0;
+  constexpr size_t kClientId = 1;
+
+  // session reuse of each client connection
+  std::vector<std::optional<bool>> reused;
+
+  std::shared_ptr<boost::asio::io_context> io;
+  std::shared_ptr<Node> client;
+  std::shared_ptr<Node> server;
+
+  auto listen_to =
+      libp2p::multi::Multiaddress::create("/ip4/127.0.0.1/tcp/40002").value();
+
+  Node::Behavior server_behavior = [&](Node &node) {
+    auto stats = node.getStats();
+    TRACE("Server event: {}", stats.lastEvent());
+    switch (stats.lastEvent()) {
+      case Stats::ACCEPTED:
+        return node.read(ACCEPTED_STREAM);
+      case Stats::READ:
+        return node.write(ACCEPTED_STREAM);
+      case Stats::FATAL_ERROR:
+        break;
+      default:
+        // client disconnects after the first exchange
+        return;
+    }
+    io->stop();
+  };
+
+  Node::Behavior client_behavior = [&](Node &node) {
+    auto stats = node.getStats();
+    TRACE("Client event: {}", stats.lastEvent());
+    switch (stats.lastEvent()) {
+      case Stats::CONNECTED:
+        return node.write(CONNECTED_STREAM);
+      case Stats::WRITE:
+        return node.read(CONNECTED_STREAM);
+      case Stats::READ: {
+        // session tickets precede server's reply, so they are cached by now
+        reused.push_back(node.takeTlsSessionReused());
+        if (reused.size() == 2) {
+          break;
+        }
+        if (mismatch_identity) {
+          auto &sessions = *node.sslContext().tls_sessions;
+          auto key = libp2p::security::TlsSessionCache::key(server->getId(),
+                                                            listen_to);
+          auto entry = sessions.take(key, server->getId());
+          EXPECT_TRUE(entry);
+          if (entry) {
+            entry->identity.peer_id = node.getId();
+            sessions.put(key, std::move(entry.value()));
+          }
+        }
+        node.disconnect();
+        return node.connect(
+            libp2p::peer::PeerInfo{server->getId(), {listen_to}});
+      }
+      default:
+        break;
+    }
+    io->stop();
+  };
+
+  io = std::make_shared<boost::asio::io_context>();
+
+  server = std::make_shared<Node>(kServerId,
+                                  false,
+                                  server_behavior,
+                                  io,
+                                  std::forward<decltype(args)>(args)...);
+  client = std::make_shared<Node>(kClientId,
+                                  false,
+                                  client_behavior,
+                                  io,
+                                  std::forward<decltype(args)>(args)...);
+
+  client->trackTlsSessionReuse();
+
+  post(*io, [&]() {
+    server->listen(listen_to);
+    libp2p::peer::PeerInfo peer_info{server->getId(), {listen_to}};
+    client->connect(peer_info);
+  });
+
+  runEventLoop(io);
+
+  // full handshake, then resumption unless cached identity mismatches
+  EXPECT_EQ(reused,
+            (std::vector<std::optional<bool>>{false, !mismatch_identity}));
+
+  if (server) {
+    server->stop();
+  }
+  if (client) {
+    client->stop();
+  }
+}
+
 TEST(StreamsRegression, YamuxStreamsGetNotifiedAboutEOF) {
   testStreamsGetNotifiedAboutEOF(
       false,
@@ -564,6 +714,33 @@ TEST(StreamsRegression, YamuxTLSStreamsGetNotifiedAboutEOF) {
       libp2p::injector::useSecurityAdaptors<libp2p::security::TlsAdaptor>());
 }
 
+/**
+ * @given client which made TLS connection to server and received session
+ * tickets
+ * @when client reconnects to server
+ * @then cached session is resumed
+ */
+TEST(StreamsRegression, YamuxTLSReconnectResumesSession) {
+  testTlsReconnect(
+      false,
+      boost::di::bind<libp2p::muxer::MuxerAdaptor *[]>()
+          .to<libp2p::muxer::Yamux>()[boost::di::override],
+      libp2p::injector::useSecurityAdaptors<libp2p::security::TlsAdaptor>());
+}
+
+/**
+ * @given client with cached TLS session whose identity is not the server's
+ * @when client reconnects to server
+ * @then session is not offered, full handshake succeeds
+ */
+TEST(StreamsRegression, YamuxTLSReconnectWithMismatchedIdentity) {
+  testTlsReconnect(
+      true,
+      boost::di::bind<libp2p::muxer::MuxerAdaptor *[]>()
+          .to<libp2p::muxer::Yamux>()[boost::di::override],
+      libp2p::injector::useSecurityAdaptors<libp2p::security::TlsAdaptor>());
+}
+
 TEST(StreamsRegression, OutboundYamuxNoiseConnectionAcceptsStreams) {
   testOutboundConnectionAcceptsStreams(
       boost::di::bind<libp2p::muxer::MuxerAdaptor *[]>()
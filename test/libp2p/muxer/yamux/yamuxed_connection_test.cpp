@@ -0,0 +1,416 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/muxer/yamux/yamuxed_connection.hpp>
+
+#include <map>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <libp2p/basic/scheduler/manual_scheduler_backend.hpp>
+#include <libp2p/basic/scheduler/scheduler_impl.hpp>
+
+#include "mock/libp2p/connection/secure_connection_mock.hpp"
+#include "testutil/libp2p/peer.hpp"
+
+using libp2p::Bytes;
+using libp2p::BytesIn;
+using libp2p::BytesOut;
+using libp2p::basic::ManualSchedulerBackend;
+using libp2p::basic::Scheduler;
+using libp2p::basic::SchedulerImpl;
+using libp2p::connection::SecureConnectionMock;
+using libp2p::connection::Stream;
+using libp2p::connection::YamuxedConnection;
+using libp2p::connection::YamuxFrame;
+using libp2p::muxer::MuxedConnectionConfig;
+using testing::_;
+using testing::Return;
+
+using std::chrono_literals::operator""ms;
+
+namespace yamux = libp2p::connection;
+
+/// Yamux connection over mocked secure connection. Bytes written by the
+/// connection are parsed into frames, write completion is controlled by test
+class YamuxedConnectionTest : public testing::Test {
+ protected:
+  struct Frame {
+    YamuxFrame header;
+    Bytes data;
+  };
+
+  void SetUp() override {
+    ON_CALL(*raw, isInitiator_hack()).WillByDefault(Return(true));
+    ON_CALL(*raw, isClosed()).WillByDefault(Return(false));
+    ON_CALL(*raw, close()).WillByDefault(Return(outcome::success()));
+    ON_CALL(*raw, remotePeer()).WillByDefault(Return(peer));
+    ON_CALL(*raw, readSome(_, _))
+        .WillByDefault([this](BytesOut out, auto cb) {
+          read_out = out;
+          read_cb = std::move(cb);
+        });
+    ON_CALL(*raw, writeSome(_, _)).WillByDefault([this](BytesIn in, auto cb) {
+      written.insert(written.end(), in.begin(), in.end());
+      ++write_calls;
+      pending_writes.emplace_back(in.size(), std::move(cb));
+    });
+    ON_CALL(*raw, deferWriteCallback(_, _))
+        .WillByDefault([this](std::error_code ec, auto cb) {
+          backend->post([ec, cb{std::move(cb)}] { cb(ec); });
+        });
+  }
+
+  void TearDown() override {
+    if (connection) {
+      std::ignore = connection->close();
+      completeWrites();
+    }
+  }
+
+  void start(MuxedConnectionConfig config = {}) {
+    connection = std::make_shared<YamuxedConnection>(
+        raw, scheduler, nullptr, config);
+    connection->onStream(
+        [this](std::shared_ptr<Stream> stream) { inbound = stream; });
+    connection->start();
+  }
+
+  /// Delivers bytes to connection as received from peer
+  void receive(BytesIn bytes) {
+    ASSERT_TRUE(read_cb);
+    ASSERT_GE(read_out.size(), bytes.size());
+    std::copy(bytes.begin(), bytes.end(), read_out.begin());
+    auto cb = std::move(read_cb);
+    read_cb = nullptr;
+    cb(bytes.size());
+  }
+
+  /// Delivers data frame
+  void receiveData(uint32_t stream_id, const Bytes &data) {
+    auto frame = yamux::dataMsg(stream_id, data.size(), false);
+    frame.insert(frame.end(), data.begin(), data.end());
+    for (BytesIn rest{frame}; !rest.empty();) {
+      auto n = std::min(rest.size(), read_out.size());
+      receive(rest.first(n));
+      rest = rest.subspan(n);
+    }
+  }
+
+  /// Completes pending writes, including writes made on completion
+  void completeWrites() {
+    while (true) {
+      backend->shift(0ms);
+      if (pending_writes.empty()) {
+        break;
+      }
+      auto [n, cb] = std::move(pending_writes.front());
+      pending_writes.pop_front();
+      cb(n);
+    }
+  }
+
+  /// Parses frames written since previous call
+  std::vector<Frame> frames() {
+    std::vector<Frame> result;
+    BytesIn rest{written};
+    while (rest.size() >= YamuxFrame::kHeaderLength) {
+      auto header = yamux::parseFrame(rest.first(YamuxFrame::kHeaderLength));
+      EXPECT_TRUE(header);
+      rest = rest.subspan(YamuxFrame::kHeaderLength);
+      Frame frame{*header, {}};
+      if (header->type == YamuxFrame::FrameType::DATA) {
+        EXPECT_GE(rest.size(), header->length);
+        frame.data.assign(rest.begin(), rest.begin() + header->length);
+        rest = rest.subspan(header->length);
+      }
+      result.emplace_back(std::move(frame));
+    }
+    EXPECT_TRUE(rest.empty());
+    written.clear();
+    return result;
+  }
+
+  /// Reads until `size` bytes are read or stream has no more data
+  Bytes read(const std::shared_ptr<Stream> &stream, size_t size) {
+    Bytes result;
+    Bytes buffer(size);
+    bool more = true;
+    while (more && result.size() < size) {
+      more = false;
+      stream->readSome(BytesOut{buffer}.first(size - result.size()),
+                       [&](outcome::result<size_t> r) {
+                         if (r) {
+                           result.insert(result.end(),
+                                         buffer.begin(),
+                                         buffer.begin() + r.value());
+                           more = true;
+                         }
+                       });
+      backend->shift(0ms);
+    }
+    return result;
+  }
+
+  std::shared_ptr<ManualSchedulerBackend> backend =
+      std::make_shared<ManualSchedulerBackend>();
+  std::shared_ptr<Scheduler> scheduler =
+      std::make_shared<SchedulerImpl>(backend, Scheduler::Config{});
+  std::shared_ptr<SecureConnectionMock> raw =
+      std::make_shared<testing::NiceMock<SecureConnectionMock>>();
+  libp2p::peer::PeerId peer = testutil::randomPeerId();
+  std::shared_ptr<YamuxedConnection> connection;
+  std::shared_ptr<Stream> inbound;
+
+  BytesOut read_out;
+  libp2p::basic::Reader::ReadCallbackFunc read_cb;
+  Bytes written;
+  size_t write_calls = 0;
+  std::deque<std::pair<size_t, libp2p::basic::Writer::WriteCallbackFunc>>
+      pending_writes;
+};
+
+/**
+ * @given connection with receive window auto tuning, and link RTT measured
+ * by ping
+ * @when reader consumes the whole receive window within 2 RTT
+ * @then the window grows, as bandwidth-delay product is above it
+ */
+TEST_F(YamuxedConnectionTest, WindowGrowsWithBandwidthDelayProduct) {
+  MuxedConnectionConfig config;
+  config.window_auto_tuning = true;
+  start(config);
+  completeWrites();
+  auto sent = frames();
+  ASSERT_EQ(sent.size(), 1);
+  ASSERT_EQ(sent[0].header.type, YamuxFrame::FrameType::PING);
+
+  // link delay
+  std::this_thread::sleep_for(20ms);
+  receive(yamux::pingResponseMsg(sent[0].header.length));
+
+  receive(yamux::newStreamMsg(2));
+  ASSERT_TRUE(inbound);
+  completeWrites();
+  frames();
+
+  Bytes data(YamuxFrame::kInitialWindowSize, 0x55);
+  receiveData(2, data);
+  EXPECT_EQ(read(inbound, data.size()), data);
+  completeWrites();
+
+  size_t window_delta = 0;
+  for (auto &frame : frames()) {
+    if (frame.header.type == YamuxFrame::FrameType::WINDOW_UPDATE
+        && frame.header.stream_id == 2) {
+      window_delta += frame.header.length;
+    }
+  }
+  // consumed bytes are acked, and the window is doubled
+  EXPECT_EQ(window_delta, 2 * YamuxFrame::kInitialWindowSize);
+}
+
+/**
+ * @given connection with receive window auto tuning
+ * @when it is busy writing for longer than ping interval
+ * @then it still sends pings to measure RTT
+ */
+TEST_F(YamuxedConnectionTest, PingsWhileWriting) {
+  MuxedConnectionConfig config;
+  config.window_auto_tuning = true;
+  start(config);
+  completeWrites();
+  frames();
+
+  auto stream = connection->newStream().value();
+  Bytes data(64 * 1024, 1);
+  stream->writeSome(data, [](outcome::result<size_t>) {});
+  backend->shift(0ms);
+  ASSERT_FALSE(pending_writes.empty());
+
+  backend->shift(config.ping_interval);
+  backend->shiftToTimer();
+  completeWrites();
+  size_t pings = 0;
+  for (auto &frame : frames()) {
+    if (frame.header.type == YamuxFrame::FrameType::PING) {
+      ++pings;
+    }
+  }
+  EXPECT_GE(pings, 1);
+}
+
+/**
+ * @given connection with receive memory limit slightly above one window
+ * @when stream's receive window is grown beyond the limit
+ * @then the growth fails with budget exhausted error
+ */
+TEST_F(YamuxedConnectionTest, AdjustWindowBeyondBudget) {
+  MuxedConnectionConfig config;
+  config.receive_memory_limit = YamuxFrame::kInitialWindowSize + 1000;
+  start(config);
+  auto stream = connection->newStream().value();
+
+  std::optional<outcome::result<void>> result;
+  stream->adjustWindowSize(YamuxFrame::kInitialWindowSize + 500,
+                           [&](outcome::result<void> r) { result = r; });
+  backend->shift(0ms);
+  ASSERT_TRUE(result);
+  EXPECT_TRUE(result->has_value());
+
+  result.reset();
+  stream->adjustWindowSize(2 * YamuxFrame::kInitialWindowSize,
+                           [&](outcome::result<void> r) { result = r; });
+  backend->shift(0ms);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(result->error(), Stream::Error::STREAM_RECEIVE_BUDGET_EXHAUSTED);
+}
+
+/**
+ * @given streams with weights 1:3 having queued data
+ * @when the connection writes their frames
+ * @then bandwidth is shared by weights until one of streams is drained
+ */
+TEST_F(YamuxedConnectionTest, WeightedFairness) {
+  start();
+  auto light = connection->newStream().value();
+  auto heavy = connection->newStream().value();
+  heavy->setWeight(3 * Stream::kDefaultWeight);
+  Bytes data(8 * YamuxedConnection::kMaxDataFrameSize, 1);
+  light->writeSome(data, [](outcome::result<size_t>) {});
+  heavy->writeSome(data, [](outcome::result<size_t>) {});
+  completeWrites();
+
+  std::vector<uint32_t> order;
+  for (auto &frame : frames()) {
+    if (frame.header.type == YamuxFrame::FrameType::DATA
+        && !frame.data.empty()) {
+      EXPECT_EQ(frame.data.size(), YamuxedConnection::kMaxDataFrameSize);
+      order.push_back(frame.header.stream_id);
+    }
+  }
+  ASSERT_EQ(order.size(), 16);
+  // rounds of 1 light and 3 heavy frames
+  std::vector<uint32_t> expected{1, 3, 3, 3, 1, 3, 3, 3, 1, 3, 3};
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), order.begin()));
+}
+
+/**
+ * @given stream with data frames queued behind a write in progress
+ * @when peer resets the stream
+ * @then queued frames are dropped, and the stream's write fails
+ */
+TEST_F(YamuxedConnectionTest, NoDataAfterRstReceived) {
+  start();
+  auto stream = connection->newStream().value();
+  ASSERT_FALSE(pending_writes.empty());
+  std::optional<outcome::result<size_t>> result;
+  Bytes data(4 * YamuxedConnection::kMaxDataFrameSize, 1);
+  stream->writeSome(data, [&](outcome::result<size_t> r) { result = r; });
+  backend->shift(0ms);
+
+  receive(yamux::resetStreamMsg(1));
+  completeWrites();
+  for (auto &frame : frames()) {
+    EXPECT_TRUE(frame.header.type != YamuxFrame::FrameType::DATA
+                || frame.data.empty());
+  }
+  ASSERT_TRUE(result);
+  EXPECT_EQ(result->error(), Stream::Error::STREAM_RESET_BY_PEER);
+}
+
+/**
+ * @given inbound stream with data frames queued behind a write in progress
+ * @when peer overflows the stream's receive window
+ * @then the stream is reset, and no data frame follows the RST
+ */
+TEST_F(YamuxedConnectionTest, NoDataAfterRstSent) {
+  start();
+  receive(yamux::newStreamMsg(2));
+  ASSERT_TRUE(inbound);
+  ASSERT_FALSE(pending_writes.empty());
+  Bytes data(4 * YamuxedConnection::kMaxDataFrameSize, 1);
+  inbound->writeSome(data, [](outcome::result<size_t>) {});
+  backend->shift(0ms);
+
+  receiveData(2, Bytes(YamuxFrame::kInitialWindowSize + 1, 2));
+  completeWrites();
+  auto reset = false;
+  for (auto &frame : frames()) {
+    if (frame.header.flagIsSet(YamuxFrame::Flag::RST)) {
+      reset = true;
+    } else if (reset) {
+      EXPECT_NE(frame.header.stream_id, 2);
+    }
+  }
+  EXPECT_TRUE(reset);
+}
+
+/**
+ * @given connection with write coalescing
+ * @when several streams enqueue frames within one loop iteration
+ * @then they are written at once, each frame delimited correctly
+ */
+TEST_F(YamuxedConnectionTest, CoalescedFramesDelimited) {
+  MuxedConnectionConfig config;
+  config.write_coalescing = true;
+  start(config);
+  completeWrites();
+  frames();
+  write_calls = 0;
+
+  auto stream1 = connection->newStream().value();
+  auto stream3 = connection->newStream().value();
+  Bytes data1{1, 2, 3};
+  Bytes data3{4, 5};
+  stream1->writeSome(data1, [](outcome::result<size_t>) {});
+  stream3->writeSome(data3, [](outcome::result<size_t>) {});
+  completeWrites();
+  EXPECT_EQ(write_calls, 1);
+
+  std::map<uint32_t, Bytes> data;
+  size_t syn = 0;
+  for (auto &frame : frames()) {
+    if (frame.header.flagIsSet(YamuxFrame::Flag::SYN)) {
+      ++syn;
+    }
+    auto &bytes = data[frame.header.stream_id];
+    bytes.insert(bytes.end(), frame.data.begin(), frame.data.end());
+  }
+  EXPECT_EQ(syn, 2);
+  EXPECT_EQ(data[1], data1);
+  EXPECT_EQ(data[3], data3);
+}
+
+/**
+ * @given stream which was reset with unread data
+ * @when its object is reused for a new stream
+ * @then the new stream carries no state of the previous one
+ */
+TEST_F(YamuxedConnectionTest, ReusedStreamIsClean) {
+  start();
+  auto stream = connection->newStream().value();
+  auto *object = stream.get();
+  receiveData(1, Bytes(100, 7));
+  receive(yamux::resetStreamMsg(1));
+  completeWrites();
+  EXPECT_TRUE(stream->isClosed());
+  stream.reset();
+
+  stream = connection->newStream().value();
+  ASSERT_EQ(stream.get(), object);
+  EXPECT_FALSE(stream->isClosed());
+  Bytes data{1, 2, 3};
+  receiveData(3, data);
+  EXPECT_EQ(read(stream, 100), data);
+
+  std::optional<outcome::result<size_t>> result;
+  Bytes window(YamuxFrame::kInitialWindowSize, 1);
+  stream->writeSome(window, [&](outcome::result<size_t> r) { result = r; });
+  completeWrites();
+  ASSERT_TRUE(result);
+  EXPECT_EQ(result->value(), window.size());
+}
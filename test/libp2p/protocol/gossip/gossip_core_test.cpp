@@ -0,0 +1,708 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/protocol/gossip/impl/gossip_core.hpp"
+
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <boost/asio/executor_work_guard.hpp>
+#include <libp2p/basic/scheduler/manual_scheduler_backend.hpp>
+#include <libp2p/basic/scheduler/scheduler_impl.hpp>
+#include <libp2p/multi/uvarint.hpp>
+#include <libp2p/security/crypto_thread_pool.hpp>
+
+#include "mock/libp2p/connection/stream_mock.hpp"
+#include "mock/libp2p/crypto/crypto_provider_mock.hpp"
+#include "mock/libp2p/crypto/key_marshaller_mock.hpp"
+#include "mock/libp2p/host/host_mock.hpp"
+#include "mock/libp2p/peer/address_repository_mock.hpp"
+#include "mock/libp2p/peer/peer_repository_mock.hpp"
+#include "src/protocol/gossip/impl/message_builder.hpp"
+#include "src/protocol/gossip/impl/message_parser.hpp"
+#include "src/protocol/gossip/impl/peer_context.hpp"
+#include "testutil/libp2p/peer.hpp"
+
+using libp2p::Bytes;
+using libp2p::BytesIn;
+using libp2p::BytesOut;
+using libp2p::HostMock;
+using libp2p::StreamAndProtocol;
+using libp2p::StreamAndProtocolCb;
+using libp2p::basic::ManualSchedulerBackend;
+using libp2p::basic::Scheduler;
+using libp2p::basic::SchedulerImpl;
+using libp2p::connection::StreamMock;
+using libp2p::crypto::CryptoProviderMock;
+using libp2p::crypto::SignatureBatchItem;
+using libp2p::crypto::marshaller::KeyMarshallerMock;
+using libp2p::peer::AddressRepositoryMock;
+using libp2p::peer::PeerId;
+using libp2p::peer::PeerInfo;
+using libp2p::peer::PeerRepositoryMock;
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnRef;
+
+using std::chrono_literals::operator""ms;
+
+namespace g = libp2p::protocol::gossip;
+
+namespace {
+  const g::TopicId kTopic = "topic";
+
+  Bytes toBytes(std::string_view s) {
+    return {s.begin(), s.end()};
+  }
+
+  /// Random key short enough to be inlined into identity peer id
+  Bytes randomKey() {
+    Bytes key(32);
+    for (auto &byte : key) {
+      byte = rand() & 0xff;  // NOLINT
+    }
+    return key;
+  }
+
+  /// Records parts of RPCs written to a remote peer
+  struct Rpcs : public g::MessageReceiver {
+    void onSubscription(const g::PeerContextPtr &,
+                        bool,
+                        const g::TopicId &) override {}
+    void onIHave(const g::PeerContextPtr &,
+                 const g::TopicId &,
+                 const g::MessageId &msg_id) override {
+      ihave.push_back(msg_id);
+    }
+    void onIWant(const g::PeerContextPtr &, const g::MessageId &) override {}
+    void onIDontWant(const g::PeerContextPtr &,
+                     const g::MessageId &msg_id) override {
+      idontwant.push_back(msg_id);
+    }
+    void onGraft(const g::PeerContextPtr &, const g::TopicId &topic) override {
+      grafts.push_back(topic);
+    }
+    void onPrune(const g::PeerContextPtr &,
+                 const g::TopicId &topic,
+                 uint64_t) override {
+      prunes.push_back(topic);
+    }
+    void onTopicMessage(const g::PeerContextPtr &,
+                        g::TopicMessage::Ptr msg) override {
+      messages.push_back(msg->data);
+    }
+    void onMessageEnd(const g::PeerContextPtr &) override {}
+
+    std::vector<g::MessageId> ihave;
+    std::vector<g::MessageId> idontwant;
+    std::vector<g::TopicId> grafts;
+    std::vector<g::TopicId> prunes;
+    std::vector<Bytes> messages;
+  };
+}  // namespace
+
+/// Gossip core over mocked host. Remote peers are connected by inbound
+/// streams which receive RPCs built by test, RPCs written to their outbound
+/// streams are parsed back
+class GossipCoreTest : public testing::Test {
+ protected:
+  struct Remote {
+    Bytes key = randomKey();
+    PeerId id =
+        PeerId::fromPublicKey(libp2p::crypto::ProtobufKey{key}).value();
+    std::string protocol;
+    std::shared_ptr<NiceMock<StreamMock>> inbound =
+        std::make_shared<NiceMock<StreamMock>>();
+    std::shared_ptr<NiceMock<StreamMock>> outbound =
+        std::make_shared<NiceMock<StreamMock>>();
+    Bytes incoming;
+    BytesOut read_out;
+    libp2p::basic::Reader::ReadCallbackFunc read_cb;
+    Bytes written;
+  };
+
+  void SetUp() override {
+    config.rw_timeout_msec = 0ms;
+    ON_CALL(*host, getId()).WillByDefault(Return(local_id));
+    ON_CALL(*host, getPeerInfo())
+        .WillByDefault(Return(PeerInfo{local_id, {}}));
+    ON_CALL(*host, getPeerRepository()).WillByDefault(ReturnRef(peer_repo));
+    ON_CALL(peer_repo, getAddressRepository())
+        .WillByDefault(ReturnRef(address_repo));
+    ON_CALL(address_repo, updateAddresses(_, _))
+        .WillByDefault(Return(outcome::success()));
+    ON_CALL(*host, setProtocolHandler(_, _, _))
+        .WillByDefault(
+            [this](auto protocols, StreamAndProtocolCb cb, auto) {
+              advertised = std::move(protocols);
+              handler = std::move(cb);
+            });
+    ON_CALL(*host, newStream(_, _, _))
+        .WillByDefault([this](const PeerInfo &info, auto, auto cb) {
+          auto &r = remote(info.id);
+          cb(StreamAndProtocol{r.outbound, r.protocol});
+        });
+    ON_CALL(*key_marshaller, unmarshalPublicKey(_))
+        .WillByDefault(Return(libp2p::crypto::PublicKey{}));
+  }
+
+  void TearDown() override {
+    if (gossip) {
+      gossip->stop();
+    }
+  }
+
+  void start() {
+    gossip = std::make_shared<g::GossipCore>(
+        config, scheduler, host, nullptr, crypto_provider, key_marshaller);
+    sub = gossip->subscribe({kTopic}, [this](g::Gossip::SubscriptionData d) {
+      if (d) {
+        delivered.push_back(d->data);
+      }
+    });
+    gossip->start();
+  }
+
+  Remote &remote(const PeerId &id) {
+    for (auto &r : remotes) {
+      if (r->id == id) {
+        return *r;
+      }
+    }
+    throw std::logic_error("unknown peer");
+  }
+
+  /// Connects new remote peer by its inbound stream
+  Remote &connect(const std::string &protocol = "/meshsub/1.2.0") {
+    auto &r = *remotes.emplace_back(std::make_unique<Remote>());
+    r.protocol = protocol;
+    auto address = libp2p::multi::Multiaddress::create(
+                       "/ip4/10.0.0." + std::to_string(remotes.size())
+                       + "/tcp/4001")
+                       .value();
+    ON_CALL(*r.inbound, remotePeerId()).WillByDefault(Return(r.id));
+    ON_CALL(*r.inbound, remoteMultiaddr()).WillByDefault(Return(address));
+    ON_CALL(*r.inbound, readSome(_, _))
+        .WillByDefault([&r](BytesOut out, auto cb) {
+          r.read_out = out;
+          r.read_cb = std::move(cb);
+        });
+    ON_CALL(*r.outbound, remotePeerId()).WillByDefault(Return(r.id));
+    ON_CALL(*r.outbound, remoteMultiaddr()).WillByDefault(Return(address));
+    ON_CALL(*r.outbound, writeSome(_, _))
+        .WillByDefault([&r](BytesIn in, auto cb) {
+          r.written.insert(r.written.end(), in.begin(), in.end());
+          cb(in.size());
+        });
+    handler(StreamAndProtocol{r.inbound, r.protocol});
+    return r;
+  }
+
+  /// Delivers RPC to gossip as sent by remote peer
+  void receive(Remote &r, g::MessageBuilder &builder) {
+    auto buffers = builder.serialize().value();
+    for (auto &buffer : buffers) {
+      r.incoming.insert(r.incoming.end(), buffer->begin(), buffer->end());
+    }
+    while (r.read_cb && !r.incoming.empty()) {
+      auto n = std::min(r.read_out.size(), r.incoming.size());
+      std::copy_n(r.incoming.begin(), n, r.read_out.begin());
+      r.incoming.erase(r.incoming.begin(), r.incoming.begin() + n);
+      auto cb = std::move(r.read_cb);
+      r.read_cb = nullptr;
+      cb(n);
+    }
+  }
+
+  /// Remote peer joins the mesh of topic
+  void graft(Remote &r) {
+    g::MessageBuilder builder;
+    builder.addSubscription(true, kTopic);
+    builder.addGraft(kTopic);
+    receive(r, builder);
+    std::ignore = sent(r);
+  }
+
+  /// Parses RPCs written to remote peer since previous call
+  Rpcs sent(Remote &r) {
+    Rpcs rpcs;
+    auto ctx = std::make_shared<g::PeerContext>(local_id);
+    BytesIn rest{r.written};
+    while (!rest.empty()) {
+      auto length = libp2p::multi::UVarint::create(rest);
+      if (!length) {
+        ADD_FAILURE() << "bad RPC length";
+        break;
+      }
+      rest = rest.subspan(length->size());
+      auto n = length->toUInt64();
+      g::MessageParser parser{config.rpc_limits};
+      EXPECT_TRUE(parser.parse(rest.first(n)));
+      parser.dispatch(ctx, rpcs);
+      rest = rest.subspan(n);
+    }
+    r.written.clear();
+    return rpcs;
+  }
+
+  /// Message authored by remote peer
+  g::TopicMessage::Ptr message(const Remote &author,
+                               uint64_t seq,
+                               std::string_view data) {
+    return std::make_shared<g::TopicMessage>(
+        author.id, seq, toBytes(data), kTopic);
+  }
+
+  g::MessageId messageId(const g::TopicMessage &msg) {
+    return g::createMessageId(msg.from, msg.seq_no, msg.data);
+  }
+
+  /// Runs gossip heartbeat
+  void heartbeat() {
+    auto until = scheduler->now() + config.heartbeat_interval_msec;
+    while (scheduler->now() < until) {
+      backend->shiftToTimer();
+    }
+  }
+
+  /// Delivers messages in one RPC
+  void receiveMessages(Remote &r,
+                       const std::vector<g::TopicMessage::Ptr> &msgs) {
+    g::MessageBuilder builder;
+    for (auto &msg : msgs) {
+      builder.addMessage(*msg, messageId(*msg));
+    }
+    receive(r, builder);
+  }
+
+  /// Sets async validator which saves its callbacks to `validations`
+  void setAsyncValidator() {
+    gossip->setAsyncValidator(
+        kTopic,
+        [this](const Bytes &, const Bytes &data, auto done) {
+          validated.push_back(data);
+          validations.push_back(std::move(done));
+        });
+  }
+
+  g::Config config;
+  std::shared_ptr<ManualSchedulerBackend> backend =
+      std::make_shared<ManualSchedulerBackend>();
+  std::shared_ptr<Scheduler> scheduler =
+      std::make_shared<SchedulerImpl>(backend, Scheduler::Config{});
+  PeerId local_id = testutil::randomPeerId();
+  std::shared_ptr<NiceMock<HostMock>> host =
+      std::make_shared<NiceMock<HostMock>>();
+  NiceMock<PeerRepositoryMock> peer_repo;
+  NiceMock<AddressRepositoryMock> address_repo;
+  std::shared_ptr<CryptoProviderMock> crypto_provider =
+      std::make_shared<CryptoProviderMock>();
+  std::shared_ptr<NiceMock<KeyMarshallerMock>> key_marshaller =
+      std::make_shared<NiceMock<KeyMarshallerMock>>();
+  libp2p::StreamProtocols advertised;
+  StreamAndProtocolCb handler;
+  std::vector<std::unique_ptr<Remote>> remotes;
+  std::shared_ptr<g::Gossip> gossip;
+  libp2p::protocol::Subscription sub;
+  std::vector<Bytes> delivered;
+  std::vector<Bytes> validated;
+  std::vector<g::Gossip::ValidationCallback> validations;
+};
+
+/**
+ * @given gossip verifying signatures, and a mesh peer
+ * @when three signed messages arrive in one RPC, the middle one with bad
+ * signature
+ * @then they are verified as one batch, the bad one is neither delivered nor
+ * forwarded, the others are delivered and forwarded in order
+ */
+TEST_F(GossipCoreTest, BadSignatureRejectsOnlyItsMessage) {
+  config.verify_signatures = true;
+  start();
+  auto &author = connect();
+  auto &mesh_peer = connect();
+  graft(mesh_peer);
+
+  EXPECT_CALL(*crypto_provider, verifyBatch(_))
+      .WillOnce([](std::span<const SignatureBatchItem> items) {
+        std::vector<bool> result;
+        for (auto &item : items) {
+          result.push_back(Bytes(item.signature.begin(), item.signature.end())
+                           == toBytes("good"));
+        }
+        EXPECT_EQ(result.size(), 3);
+        return result;
+      });
+
+  g::MessageBuilder builder;
+  for (auto [seq, data, signature] : {std::tuple{1, "first", "good"},
+                                      std::tuple{2, "second", "bad"},
+                                      std::tuple{3, "third", "good"}}) {
+    auto msg = message(author, seq, data);
+    msg->signature = toBytes(signature);
+    msg->key = author.key;
+    builder.addMessage(*msg, messageId(*msg));
+  }
+  receive(author, builder);
+  backend->shift(0ms);
+
+  std::vector<Bytes> expected{toBytes("first"), toBytes("third")};
+  EXPECT_EQ(delivered, expected);
+  EXPECT_EQ(sent(mesh_peer).messages, expected);
+  EXPECT_TRUE(sent(author).messages.empty());
+}
+
+/**
+ * @given gossip verifying signatures and scoring peers, and a mesh peer
+ * @when the peer sends a message of another author signed with its own key
+ * @then the message is rejected without verifying its signature, and the
+ * peer is penalized and pruned on heartbeat
+ */
+TEST_F(GossipCoreTest, KeyOfAnotherPeerRejected) {
+  config.verify_signatures = true;
+  config.score.enabled = true;
+  start();
+  auto &author = connect();
+  auto &impostor = connect();
+  graft(impostor);
+
+  EXPECT_CALL(*crypto_provider, verifyBatch(_)).Times(0);
+  auto msg = message(author, 1, "data");
+  msg->signature = toBytes("good");
+  msg->key = impostor.key;
+  receiveMessages(impostor, {msg});
+  backend->shift(0ms);
+  EXPECT_TRUE(delivered.empty());
+
+  heartbeat();
+  EXPECT_EQ(sent(impostor).prunes, std::vector<g::TopicId>{kTopic});
+}
+
+/**
+ * @given gossip verifying signatures
+ * @when batch verification fails as a whole
+ * @then signatures are verified one by one and only the bad one is rejected
+ */
+TEST_F(GossipCoreTest, BatchErrorFallsBackToSingleVerify) {
+  config.verify_signatures = true;
+  start();
+  auto &author = connect();
+
+  EXPECT_CALL(*crypto_provider, verifyBatch(_))
+      .WillOnce(Return(std::make_error_code(std::errc::not_supported)));
+  EXPECT_CALL(*crypto_provider, verify(_, _, _))
+      .Times(2)
+      .WillRepeatedly([](BytesIn, BytesIn signature, auto &) {
+        return Bytes(signature.begin(), signature.end()) == toBytes("good");
+      });
+  std::vector<g::TopicMessage::Ptr> msgs;
+  for (auto [seq, data, signature] : {std::tuple{1, "first", "good"},
+                                      std::tuple{2, "second", "bad"}}) {
+    auto msg = message(author, seq, data);
+    msg->signature = toBytes(signature);
+    msg->key = author.key;
+    msgs.push_back(msg);
+  }
+  receiveMessages(author, msgs);
+  backend->shift(0ms);
+
+  EXPECT_EQ(delivered, std::vector<Bytes>{toBytes("first")});
+}
+
+/**
+ * @given gossip with peer scoring disabled and subscribed peers out of mesh
+ * @when heartbeats pass
+ * @then exactly D_min random peers are grafted, and no more after that
+ */
+TEST_F(GossipCoreTest, HeartbeatGraftsDMinWithoutScore) {
+  config.D_min = 2;
+  start();
+  std::vector<Remote *> peers;
+  for (auto i = 0; i < 4; ++i) {
+    auto &r = connect();
+    g::MessageBuilder builder;
+    builder.addSubscription(true, kTopic);
+    receive(r, builder);
+    peers.push_back(&r);
+  }
+
+  auto grafted = [&] {
+    size_t n = 0;
+    for (auto *r : peers) {
+      n += sent(*r).grafts.size();
+    }
+    return n;
+  };
+
+  std::ignore = grafted();
+  heartbeat();
+  EXPECT_EQ(grafted(), config.D_min);
+
+  heartbeat();
+  EXPECT_EQ(grafted(), 0);
+}
+
+/**
+ * @given mesh peers of gossipsub v1.2 and v1.0
+ * @when small and large messages arrive
+ * @then IDONTWANT is sent only for the large one and only to the v1.2 peer
+ */
+TEST_F(GossipCoreTest, IDontWantSentToV12PeersAboveThreshold) {
+  config.idontwant_message_size_threshold = 16;
+  config.score.enabled = true;
+  start();
+  EXPECT_EQ(advertised,
+            libp2p::StreamProtocols(
+                {"/meshsub/1.2.0", "/meshsub/1.1.0", "/meshsub/1.0.0"}));
+  auto &author = connect();
+  auto &v12 = connect("/meshsub/1.2.0");
+  auto &v10 = connect("/meshsub/1.0.0");
+  graft(v12);
+  graft(v10);
+
+  auto small = message(author, 1, "small");
+  auto large = message(author, 2, std::string(16, 'x'));
+  g::MessageBuilder builder;
+  builder.addMessage(*small, messageId(*small));
+  builder.addMessage(*large, messageId(*large));
+  receive(author, builder);
+
+  EXPECT_EQ(sent(v12).idontwant, std::vector<g::MessageId>{messageId(*large)});
+  EXPECT_TRUE(sent(v10).idontwant.empty());
+}
+
+/**
+ * @given mesh peer which sent IDONTWANT for a message
+ * @when the message arrives
+ * @then it is forwarded to other mesh peers, but not to that peer
+ */
+TEST_F(GossipCoreTest, IDontWantSuppressesForwarding) {
+  start();
+  auto &author = connect();
+  auto &wants = connect();
+  auto &dont_want = connect();
+  graft(wants);
+  graft(dont_want);
+
+  auto msg = message(author, 1, "data");
+  g::MessageBuilder idontwant;
+  idontwant.addIDontWant(messageId(*msg));
+  receive(dont_want, idontwant);
+
+  g::MessageBuilder builder;
+  builder.addMessage(*msg, messageId(*msg));
+  receive(author, builder);
+
+  EXPECT_EQ(sent(wants).messages, std::vector<Bytes>{toBytes("data")});
+  EXPECT_TRUE(sent(dont_want).messages.empty());
+}
+
+/**
+ * @given mesh peer which sent IDONTWANT for a message
+ * @when the message arrives after IDONTWANT lifetime
+ * @then it is forwarded to that peer
+ */
+TEST_F(GossipCoreTest, IDontWantExpires) {
+  start();
+  auto &author = connect();
+  auto &dont_want = connect();
+  graft(dont_want);
+
+  auto msg = message(author, 1, "data");
+  g::MessageBuilder idontwant;
+  idontwant.addIDontWant(messageId(*msg));
+  receive(dont_want, idontwant);
+
+  auto until = scheduler->now() + config.idontwant_lifetime_msec;
+  while (scheduler->now() <= until) {
+    backend->shiftToTimer();
+  }
+  std::ignore = sent(dont_want);
+
+  g::MessageBuilder builder;
+  builder.addMessage(*msg, messageId(*msg));
+  receive(author, builder);
+
+  EXPECT_EQ(sent(dont_want).messages, std::vector<Bytes>{toBytes("data")});
+}
+
+/**
+ * @given gossip with async validator and a mesh peer
+ * @when a message arrives
+ * @then it is neither delivered nor forwarded until accepted
+ */
+TEST_F(GossipCoreTest, NotForwardedUntilAccepted) {
+  start();
+  setAsyncValidator();
+  auto &author = connect();
+  auto &mesh_peer = connect();
+  graft(mesh_peer);
+
+  receiveMessages(author, {message(author, 1, "data")});
+  ASSERT_EQ(validations.size(), 1);
+  EXPECT_TRUE(delivered.empty());
+  EXPECT_TRUE(sent(mesh_peer).messages.empty());
+
+  validations[0](g::Gossip::ValidationResult::ACCEPT);
+  EXPECT_EQ(delivered, std::vector<Bytes>{toBytes("data")});
+  EXPECT_EQ(sent(mesh_peer).messages, std::vector<Bytes>{toBytes("data")});
+}
+
+/**
+ * @given gossip with peer scoring and async validator, mesh peers
+ * @when their messages are accepted, rejected and ignored
+ * @then only the accepted one is delivered, only the rejecting peer is
+ * penalized and pruned on heartbeat
+ */
+TEST_F(GossipCoreTest, ValidationResults) {
+  config.score.enabled = true;
+  start();
+  setAsyncValidator();
+  auto &accepted = connect();
+  auto &rejected = connect();
+  auto &ignored = connect();
+  graft(accepted);
+  graft(rejected);
+  graft(ignored);
+
+  receiveMessages(accepted, {message(accepted, 1, "accepted")});
+  receiveMessages(rejected, {message(rejected, 1, "rejected")});
+  receiveMessages(ignored, {message(ignored, 1, "ignored")});
+  ASSERT_EQ(validations.size(), 3);
+  validations[0](g::Gossip::ValidationResult::ACCEPT);
+  validations[1](g::Gossip::ValidationResult::REJECT);
+  validations[2](g::Gossip::ValidationResult::IGNORE);
+  EXPECT_EQ(delivered, std::vector<Bytes>{toBytes("accepted")});
+
+  std::ignore = sent(accepted);
+  std::ignore = sent(rejected);
+  std::ignore = sent(ignored);
+  heartbeat();
+  EXPECT_TRUE(sent(accepted).prunes.empty());
+  EXPECT_EQ(sent(rejected).prunes, std::vector<g::TopicId>{kTopic});
+  EXPECT_TRUE(sent(ignored).prunes.empty());
+}
+
+/**
+ * @given gossip with async validator limited by max_pending_validations
+ * @when more messages of the topic arrive than the limit
+ * @then messages above the limit are dropped, and accepted after the limit
+ * frees up
+ */
+TEST_F(GossipCoreTest, MaxPendingValidations) {
+  config.max_pending_validations = 2;
+  start();
+  setAsyncValidator();
+  auto &author = connect();
+
+  receiveMessages(author,
+                  {message(author, 1, "first"),
+                   message(author, 2, "second"),
+                   message(author, 3, "dropped")});
+  ASSERT_EQ(validations.size(), 2);
+
+  validations[0](g::Gossip::ValidationResult::ACCEPT);
+  receiveMessages(author, {message(author, 4, "fourth")});
+  ASSERT_EQ(validations.size(), 3);
+  validations[1](g::Gossip::ValidationResult::ACCEPT);
+  validations[2](g::Gossip::ValidationResult::ACCEPT);
+
+  EXPECT_EQ(delivered,
+            (std::vector<Bytes>{
+                toBytes("first"), toBytes("second"), toBytes("fourth")}));
+}
+
+/**
+ * @given gossip with async validator
+ * @when the same message arrives from another peer while being validated
+ * @then the duplicate is dropped, the message is validated and delivered
+ * once
+ */
+TEST_F(GossipCoreTest, DuplicateWhileValidating) {
+  start();
+  setAsyncValidator();
+  auto &author = connect();
+  auto &relay = connect();
+  auto &mesh_peer = connect();
+  graft(mesh_peer);
+
+  auto msg = message(author, 1, "data");
+  receiveMessages(author, {msg});
+  receiveMessages(relay, {msg});
+  ASSERT_EQ(validations.size(), 1);
+
+  validations[0](g::Gossip::ValidationResult::ACCEPT);
+  EXPECT_EQ(delivered, std::vector<Bytes>{toBytes("data")});
+  EXPECT_EQ(sent(mesh_peer).messages, std::vector<Bytes>{toBytes("data")});
+
+  receiveMessages(relay, {msg});
+  EXPECT_EQ(validations.size(), 1);
+  EXPECT_EQ(delivered.size(), 1);
+}
+
+/**
+ * @given gossip with validations in flight
+ * @when gossip stops and validations complete after that
+ * @then their results are dropped
+ */
+TEST_F(GossipCoreTest, StopWithValidationsInFlight) {
+  start();
+  setAsyncValidator();
+  auto &author = connect();
+  auto &mesh_peer = connect();
+  graft(mesh_peer);
+
+  receiveMessages(author,
+                  {message(author, 1, "first"), message(author, 2, "second")});
+  ASSERT_EQ(validations.size(), 2);
+
+  gossip->stop();
+  validations[0](g::Gossip::ValidationResult::ACCEPT);
+  validations[1](g::Gossip::ValidationResult::REJECT);
+
+  EXPECT_TRUE(delivered.empty());
+  EXPECT_TRUE(sent(mesh_peer).messages.empty());
+}
+
+/**
+ * @given gossip with thread pool validation executor and sync validator
+ * @when messages arrive
+ * @then the validator runs on a worker thread, and results are applied on
+ * the io thread after it completes
+ */
+TEST_F(GossipCoreTest, ValidationExecutor) {
+  auto io = std::make_shared<boost::asio::io_context>();
+  auto work_guard = boost::asio::make_work_guard(*io);
+  config.validation_executor =
+      std::make_shared<libp2p::security::CryptoThreadPool>(
+          io, libp2p::security::CryptoThreadPool::Config{.threads = 1});
+  start();
+  auto io_thread = std::this_thread::get_id();
+  std::vector<std::thread::id> validator_threads;
+  gossip->setValidator(kTopic, [&](const Bytes &, const Bytes &data) {
+    validator_threads.push_back(std::this_thread::get_id());
+    return data == toBytes("valid");
+  });
+  auto &author = connect();
+  auto &mesh_peer = connect();
+  graft(mesh_peer);
+
+  receiveMessages(author,
+                  {message(author, 1, "valid"), message(author, 2, "invalid")});
+  EXPECT_TRUE(delivered.empty());
+
+  // results of both validations are posted to io_context
+  for (auto i = 0; i < 2; ++i) {
+    ASSERT_EQ(io->run_one_for(std::chrono::seconds(10)), 1);
+  }
+  ASSERT_EQ(validator_threads.size(), 2);
+  for (auto &id : validator_threads) {
+    EXPECT_NE(id, io_thread);
+  }
+  EXPECT_EQ(delivered, std::vector<Bytes>{toBytes("valid")});
+  EXPECT_EQ(sent(mesh_peer).messages, std::vector<Bytes>{toBytes("valid")});
+}
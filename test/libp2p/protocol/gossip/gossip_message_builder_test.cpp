@@ -0,0 +1,107 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "protocol/gossip/protobuf/rpc.pb.h"
+#include "src/protocol/gossip/impl/message_builder.hpp"
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+#include <libp2p/multi/uvarint.hpp>
+
+#include "testutil/libp2p/peer.hpp"
+
+namespace g = libp2p::protocol::gossip;
+
+using libp2p::Bytes;
+
+namespace {
+  /// Joins buffers written to stream and parses RPC they contain
+  pubsub::pb::RPC parse(const g::SharedBuffers &buffers) {
+    Bytes bytes;
+    for (auto &buffer : buffers) {
+      bytes.insert(bytes.end(), buffer->begin(), buffer->end());
+    }
+    auto varint = libp2p::multi::UVarint::create(bytes);
+    EXPECT_TRUE(varint);
+    EXPECT_EQ(varint->toUInt64(), bytes.size() - varint->size());
+    pubsub::pb::RPC rpc;
+    EXPECT_TRUE(rpc.ParseFromArray(bytes.data() + varint->size(),
+                                   bytes.size() - varint->size()));
+    return rpc;
+  }
+
+  std::string toString(const Bytes &bytes) {
+    return {bytes.begin(), bytes.end()};
+  }
+}  // namespace
+
+/**
+ * @given Small and large messages forwarded to two peers with different
+ * control parts
+ * @when Per peer RPCs are serialized
+ * @then Each message is encoded once, large message buffer is shared between
+ * peers, and RPCs are parsed back with all their fields
+ */
+TEST(Gossip, MessageBuilderSharesEncodedMessages) {
+  auto peer = testutil::randomPeerId();
+  auto small = std::make_shared<g::TopicMessage>(
+      peer, 1, g::fromString("small"), "topic");
+  small->signature = g::fromString("signature");
+  auto large = std::make_shared<g::TopicMessage>(
+      peer, 2, Bytes(1 << 20, 0x55), "topic");
+  auto small_id = g::createMessageId(small->from, small->seq_no, small->data);
+  auto large_id = g::createMessageId(large->from, large->seq_no, large->data);
+
+  g::MessageBuilder a;
+  a.addSubscription(true, "topic");
+  a.addMessage(*small, small_id);
+  a.addMessage(*large, large_id);
+  a.addMessage(*small, small_id);
+  a.addGraft("topic");
+
+  g::MessageBuilder b;
+  b.addIHave("topic", small_id);
+  b.addIDontWant(small_id);
+  b.addMessage(*large, large_id);
+
+  ASSERT_TRUE(large->encoded);
+  auto encoded = large->encoded;
+
+  auto buffers_a = a.serialize();
+  ASSERT_TRUE(buffers_a);
+  auto buffers_b = b.serialize();
+  ASSERT_TRUE(buffers_b);
+  ASSERT_TRUE(a.empty());
+
+  auto shares = [&](const g::SharedBuffers &buffers) {
+    return std::find(buffers.begin(), buffers.end(), encoded)
+        != buffers.end();
+  };
+  EXPECT_TRUE(shares(buffers_a.value()));
+  EXPECT_TRUE(shares(buffers_b.value()));
+  EXPECT_EQ(large->encoded, encoded);
+
+  auto rpc_a = parse(buffers_a.value());
+  ASSERT_EQ(rpc_a.subscriptions_size(), 1);
+  EXPECT_EQ(rpc_a.subscriptions(0).topicid(), "topic");
+  ASSERT_EQ(rpc_a.publish_size(), 2);
+  EXPECT_EQ(rpc_a.publish(0).data(), "small");
+  EXPECT_EQ(rpc_a.publish(0).seqno(), toString(small->seq_no));
+  EXPECT_EQ(rpc_a.publish(0).from(), toString(small->from));
+  EXPECT_EQ(rpc_a.publish(0).signature(), "signature");
+  EXPECT_FALSE(rpc_a.publish(1).has_signature());
+  EXPECT_EQ(rpc_a.publish(1).data(), toString(large->data));
+  ASSERT_EQ(rpc_a.control().graft_size(), 1);
+
+  auto rpc_b = parse(buffers_b.value());
+  ASSERT_EQ(rpc_b.publish_size(), 1);
+  EXPECT_EQ(rpc_b.publish(0).data(), toString(large->data));
+  ASSERT_EQ(rpc_b.control().ihave_size(), 1);
+  EXPECT_EQ(rpc_b.control().ihave(0).messageids(0), toString(small_id));
+  ASSERT_EQ(rpc_b.control().idontwant_size(), 1);
+  EXPECT_EQ(rpc_b.control().idontwant(0).messageids(0), toString(small_id));
+}
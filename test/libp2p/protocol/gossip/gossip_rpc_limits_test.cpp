@@ -52,6 +52,11 @@ namespace {
       total_iwant_message_Ids_processed++;
     }
 
+    void onIDontWant(const g::PeerContextPtr &from,
+                     const g::MessageId &msg_id) {
+      idontwant_message_ids_processed++;
+    }
+
     void onGraft(const g::PeerContextPtr &from, const g::TopicId &topic) {
       graft_processed++;
     }
@@ -79,6 +84,8 @@ namespace {
     /// message group cannot be uniquely identified
     size_t total_iwant_message_Ids_processed = 0;
 
+    size_t idontwant_message_ids_processed = 0;
+
     size_t graft_processed = 0;
 
     /// NOTE: Add Peer Info count after MessageParser Update
@@ -185,6 +192,33 @@ TEST(Gossip, RPCIWantLimit) {
             limits.max_iwant_messages * limits.max_iwant_message_ids);
 }
 
+/**
+ * @given Limit on IDONTWANT control messages and their message ids on RPC
+ * @when we parse the RPC message
+ * @then messages and message ids after the limit are ignored
+ */
+TEST(Gossip, RPCIDontWantLimit) {
+  srand(0);
+  g::RPCLimits limits{};
+  limits.max_idontwant_messages = rand() % 10;
+  limits.max_idontwant_message_ids = rand() % 10;
+
+  pubsub::pb::RPC rpc;
+  auto *control = rpc.mutable_control();
+  for (int i = 0; i < 100; i++) {
+    auto *idontwant = control->add_idontwant();
+    for (int j = 0; j < 100; j++) {
+      idontwant->add_messageids(std::to_string(j));
+    }
+  }
+
+  g::MessageParser parser{std::make_shared<g::RPCLimits>(limits)};
+  TestMessageReceiver receiver;
+  serializeAndDispatch(rpc, parser, receiver);
+  ASSERT_EQ(receiver.idontwant_message_ids_processed,
+            limits.max_idontwant_messages * limits.max_idontwant_message_ids);
+}
+
 /**
  * @given Limit on GRAFT control messages on RPC
  * @when we parse the RPC message
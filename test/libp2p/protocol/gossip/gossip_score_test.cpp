@@ -0,0 +1,132 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/protocol/gossip/impl/score.hpp"
+
+#include <gtest/gtest.h>
+
+#include "testutil/libp2p/peer.hpp"
+
+namespace g = libp2p::protocol::gossip;
+
+using std::chrono_literals::operator""ms;
+using std::chrono_literals::operator""s;
+
+class GossipScoreTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    config.enabled = true;
+    config.default_topic_params.time_in_mesh_weight = 0;
+    config.default_topic_params.mesh_message_deliveries_weight = -1;
+    config.default_topic_params.mesh_message_deliveries_threshold = 2;
+    config.default_topic_params.mesh_message_deliveries_activation = 1s;
+    config.default_topic_params.mesh_failure_penalty_weight = -1;
+  }
+
+  g::ScoreConfig config;
+  g::Score score{config};
+  libp2p::peer::PeerId peer = testutil::randomPeerId();
+  libp2p::peer::PeerId other = testutil::randomPeerId();
+  g::TopicId topic = "topic";
+  g::MessageId msg_id{1, 2, 3};
+};
+
+/**
+ * @given Scoring is disabled
+ * @when Peer delivers invalid messages
+ * @then Its score is 0
+ */
+TEST_F(GossipScoreTest, Disabled) {
+  config.enabled = false;
+  score.connect(peer, "");
+  score.rejectMessage(peer, topic);
+  EXPECT_EQ(score.score(peer), 0);
+}
+
+/**
+ * @given Connected peer
+ * @when It delivers valid message first, then invalid one
+ * @then Its score grows, then decreases, and counters decay with time
+ */
+TEST_F(GossipScoreTest, Deliveries) {
+  score.connect(peer, "");
+  EXPECT_EQ(score.score(peer), 0);
+
+  score.deliverMessage(peer, topic, msg_id, 0ms);
+  EXPECT_EQ(score.score(peer), 1);
+
+  score.rejectMessage(peer, topic);
+  score.rejectMessage(peer, topic);
+  EXPECT_EQ(score.score(peer), 1 - 4);
+
+  score.onHeartbeat(1s);
+  score.onHeartbeat(2s);
+  EXPECT_DOUBLE_EQ(score.score(peer), 0.5 - 0.6 * 0.6);
+}
+
+/**
+ * @given Peer in mesh
+ * @when It delivers less messages than threshold after activation
+ * @then Deficit is penalized, and is kept as mesh failure penalty on prune
+ */
+TEST_F(GossipScoreTest, MeshDeliveries) {
+  score.connect(peer, "");
+  score.connect(other, "");
+  score.graft(peer, topic, 0ms);
+
+  score.deliverMessage(other, topic, msg_id, 0ms);
+  score.duplicateMessage(peer, topic, msg_id, 5ms);
+  score.duplicateMessage(peer, topic, msg_id, 6ms);
+  EXPECT_EQ(score.score(peer), 0);
+
+  config.decay_interval = 1000s;
+  score.onHeartbeat(1s);
+  // 1 delivery of 2 required
+  EXPECT_EQ(score.score(peer), -1);
+
+  score.prune(peer, topic);
+  EXPECT_EQ(score.score(peer), -1);
+}
+
+/**
+ * @given Several peers on one IP address
+ * @when They connect and disconnect
+ * @then Each of them is penalized while they share the address
+ */
+TEST_F(GossipScoreTest, IpColocation) {
+  score.connect(peer, "1.2.3.4");
+  EXPECT_EQ(score.score(peer), 0);
+
+  score.connect(other, "1.2.3.4");
+  EXPECT_EQ(score.score(peer), -1);
+  EXPECT_EQ(score.score(other), -1);
+
+  score.disconnect(other, 0ms);
+  EXPECT_EQ(score.score(peer), 0);
+}
+
+/**
+ * @given Misbehaving peer
+ * @when It disconnects
+ * @then Its score is retained for a while and then forgotten
+ */
+TEST_F(GossipScoreTest, RetainScore) {
+  config.retain_score = 10s;
+  score.connect(peer, "");
+  score.addPenalty(peer, 2);
+  EXPECT_EQ(score.score(peer), -4);
+
+  score.disconnect(peer, 0ms);
+  score.connect(peer, "");
+  EXPECT_EQ(score.score(peer), -4);
+
+  score.disconnect(peer, 0ms);
+  config.decay_interval = 1000s;
+  score.onHeartbeat(5s);
+  EXPECT_EQ(score.score(peer), -4);
+  score.onHeartbeat(11s);
+  EXPECT_EQ(score.score(peer), 0);
+}
@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "src/protocol/gossip/impl/common.hpp"
 #include "src/protocol/gossip/impl/message_cache.hpp"
 #include "src/protocol/gossip/impl/peer_set.hpp"
+#include "src/protocol/gossip/impl/seen_table.hpp"
 
 #include <gtest/gtest.h>
 
@@ -208,3 +210,67 @@ TEST(Gossip, MessageCache) {
     }
   }
 }
+
+/**
+ * @given SeenTable with lifetime of 4 buckets
+ * @when Ids are inserted at different times and the table is expired
+ * @then Ids live for lifetime at least and lifetime plus bucket at most,
+ * duplicates are rejected and ids are iterated from the newest
+ */
+TEST(Gossip, SeenTable) {
+  g::SeenTable<int> table{g::Time{40}, 4};
+  auto id = [](uint8_t i) { return g::MessageId{i}; };
+
+  ASSERT_TRUE(table.insert(id(1), 1, g::Time{100}));
+  ASSERT_TRUE(table.insert(id(2), 2, g::Time{109}));
+  ASSERT_FALSE(table.insert(id(1), 3, g::Time{109}));
+  ASSERT_TRUE(table.insert(id(3), 3, g::Time{110}));
+  ASSERT_EQ(*table.find(id(1)), 1);
+
+  std::vector<g::MessageId> newest;
+  table.forEachNewest([&](const g::MessageId &msg_id) {
+    newest.push_back(msg_id);
+    return newest.size() < 2;
+  });
+  ASSERT_EQ(newest, (std::vector{id(3), id(2)}));
+
+  table.expire(g::Time{149});
+  ASSERT_EQ(table.size(), 3);
+
+  // the first bucket [100, 110) expires
+  table.expire(g::Time{150});
+  ASSERT_FALSE(table.contains(id(1)));
+  ASSERT_FALSE(table.contains(id(2)));
+  ASSERT_EQ(table.find(id(2)), nullptr);
+  ASSERT_TRUE(table.contains(id(3)));
+
+  table.expire(g::Time{160});
+  ASSERT_EQ(table.size(), 0);
+}
+
+/**
+ * @given gossip configs
+ * @when protocol versions to advertise are chosen
+ * @then v1.1 and v1.2 are advertised only with the features they imply,
+ * explicit versions and the deprecated single version take precedence
+ */
+TEST(Gossip, ProtocolVersions) {
+  using libp2p::StreamProtocols;
+  g::Config config;
+  EXPECT_EQ(g::protocolVersions(config), StreamProtocols{"/meshsub/1.0.0"});
+
+  config.score.enabled = true;
+  EXPECT_EQ(g::protocolVersions(config),
+            (StreamProtocols{
+                "/meshsub/1.2.0", "/meshsub/1.1.0", "/meshsub/1.0.0"}));
+
+  config.idontwant_message_size_threshold = 0;
+  EXPECT_EQ(g::protocolVersions(config),
+            (StreamProtocols{"/meshsub/1.1.0", "/meshsub/1.0.0"}));
+
+  config.protocol_versions = {"/meshsub/1.2.0"};
+  EXPECT_EQ(g::protocolVersions(config), StreamProtocols{"/meshsub/1.2.0"});
+
+  config.protocol_version = "/meshsub/1.0.0";
+  EXPECT_EQ(g::protocolVersions(config), StreamProtocols{"/meshsub/1.0.0"});
+}
@@ -0,0 +1,59 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/crypto_thread_pool.hpp>
+
+#include <thread>
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <gtest/gtest.h>
+
+using libp2p::security::CryptoThreadPool;
+using libp2p::security::runCrypto;
+
+/**
+ * @given crypto thread pool with worker threads
+ * @when computation is run on it
+ * @then work is done off the io thread and result is delivered on io thread
+ */
+TEST(CryptoThreadPoolTest, ResultOnIoThread) {
+  auto io = std::make_shared<boost::asio::io_context>();
+  auto work_guard = boost::asio::make_work_guard(*io);
+  auto pool = std::make_shared<CryptoThreadPool>(
+      io, CryptoThreadPool::Config{.threads = 2});
+  auto io_thread = std::this_thread::get_id();
+  std::thread::id work_thread;
+  std::optional<int> result;
+  runCrypto(
+      pool,
+      [&] {
+        work_thread = std::this_thread::get_id();
+        return 42;
+      },
+      [&](int value) {
+        EXPECT_EQ(std::this_thread::get_id(), io_thread);
+        result = value;
+      });
+  while (!result) {
+    io->run_one();
+  }
+  EXPECT_NE(work_thread, io_thread);
+  EXPECT_EQ(result, 42);
+}
+
+/**
+ * @given crypto thread pool without worker threads
+ * @when computation is run on it
+ * @then work and result callback are called inline
+ */
+TEST(CryptoThreadPoolTest, Inline) {
+  auto io = std::make_shared<boost::asio::io_context>();
+  auto pool =
+      std::make_shared<CryptoThreadPool>(io, CryptoThreadPool::Config{});
+  std::optional<int> result;
+  runCrypto(pool, [] { return 1; }, [&](int value) { result = value; });
+  EXPECT_EQ(result, 1);
+}
@@ -0,0 +1,121 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/noise/crypto/state.hpp>
+
+#include <gtest/gtest.h>
+#include <libp2p/security/noise/handshake.hpp>
+
+using libp2p::Bytes;
+using libp2p::BytesIn;
+using libp2p::security::noise::CipherState;
+using libp2p::security::noise::kLengthPrefixSize;
+using libp2p::security::noise::kMaxPlainText;
+using libp2p::security::noise::kTagSize;
+using libp2p::security::noise::Key32;
+
+class NoiseCipherStateTest : public testing::TestWithParam<size_t> {
+ public:
+  static std::shared_ptr<CipherState> makeState() {
+    Key32 key{};
+    key.fill(1);
+    return std::make_shared<CipherState>(
+        libp2p::security::noise::defaultCipherSuite(), key);
+  }
+
+  /// Splits sealFrames() output into frames without length prefixes
+  static std::vector<BytesIn> splitFrames(BytesIn framed) {
+    std::vector<BytesIn> frames;
+    while (!framed.empty()) {
+      EXPECT_GE(framed.size(), kLengthPrefixSize);
+      auto size = (size_t{framed[0]} << 8) | framed[1];
+      EXPECT_GE(framed.size(), kLengthPrefixSize + size);
+      frames.emplace_back(framed.subspan(kLengthPrefixSize, size));
+      framed = framed.subspan(kLengthPrefixSize + size);
+    }
+    return frames;
+  }
+};
+
+/**
+ * @given plaintext of given size
+ * @when it is sealed into frames
+ * @then output size is framedSize(), each frame is at most kMaxPlainText
+ * bytes of plaintext and frames are opened with consecutive nonces
+ */
+TEST_P(NoiseCipherStateTest, SealFramesRoundTrip) {
+  auto size = GetParam();
+  Bytes plaintext(size);
+  for (size_t i = 0; i < size; ++i) {
+    plaintext[i] = static_cast<uint8_t>(i);
+  }
+  auto encoder = makeState();
+  auto decoder = makeState();
+
+  Bytes framed(CipherState::framedSize(size));
+  auto written = encoder->sealFrames(plaintext, framed);
+  ASSERT_TRUE(written.has_value()) << written.error().message();
+  EXPECT_EQ(written.value(), framed.size());
+
+  auto frames = splitFrames(framed);
+  auto expected_frames =
+      std::max<size_t>(1, (size + kMaxPlainText - 1) / kMaxPlainText);
+  ASSERT_EQ(frames.size(), expected_frames);
+
+  Bytes opened;
+  for (auto &frame : frames) {
+    EXPECT_LE(frame.size(), kMaxPlainText + kTagSize);
+    Bytes out(frame.size() - kTagSize);
+    auto n = decoder->open(frame, {}, out);
+    ASSERT_TRUE(n.has_value()) << n.error().message();
+    EXPECT_EQ(n.value(), out.size());
+    opened.insert(opened.end(), out.begin(), out.end());
+  }
+  EXPECT_EQ(opened, plaintext);
+
+  // encoder nonce advanced once per frame, so decoder opens the next one
+  Bytes next(1 + kTagSize);
+  ASSERT_TRUE(encoder->seal(BytesIn{next}.first(1), {}, next).has_value());
+  EXPECT_TRUE(decoder->open(next, {}, next).has_value());
+}
+
+INSTANTIATE_TEST_SUITE_P(Sizes,
+                         NoiseCipherStateTest,
+                         testing::Values(0,
+                                         1,
+                                         kMaxPlainText,
+                                         kMaxPlainText + 1,
+                                         3 * kMaxPlainText + 100));
+
+/**
+ * @given frames sealed by sealFrames()
+ * @when second frame is opened with the first nonce
+ * @then open fails
+ */
+TEST(NoiseCipherState, FramesUseDistinctNonces) {
+  auto encoder = NoiseCipherStateTest::makeState();
+  Bytes plaintext(kMaxPlainText + 1);
+  Bytes framed(CipherState::framedSize(plaintext.size()));
+  ASSERT_TRUE(encoder->sealFrames(plaintext, framed).has_value());
+  auto frames = NoiseCipherStateTest::splitFrames(framed);
+  ASSERT_EQ(frames.size(), 2);
+
+  Bytes out(frames[1].size());
+  EXPECT_FALSE(
+      NoiseCipherStateTest::makeState()->open(frames[1], {}, out).has_value());
+}
+
+/**
+ * @given output buffer smaller than framedSize()
+ * @when plaintext is sealed into frames
+ * @then error is returned
+ */
+TEST(NoiseCipherState, SealFramesNeedsFramedSize) {
+  auto encoder = NoiseCipherStateTest::makeState();
+  Bytes plaintext(100);
+  Bytes framed(CipherState::framedSize(plaintext.size()) - 1);
+  EXPECT_FALSE(encoder->sealFrames(plaintext, framed).has_value());
+}
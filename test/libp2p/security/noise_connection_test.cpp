@@ -0,0 +1,237 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/noise/noise_connection.hpp>
+
+#include <optional>
+
+#include <gtest/gtest.h>
+#include <boost/asio/error.hpp>
+#include <libp2p/security/noise/handshake.hpp>
+
+#include "mock/libp2p/connection/layer_connection_mock.hpp"
+#include "mock/libp2p/crypto/key_marshaller_mock.hpp"
+
+using libp2p::Bytes;
+using libp2p::BytesIn;
+using libp2p::BytesOut;
+using libp2p::connection::LayerConnectionMock;
+using libp2p::connection::NoiseConnection;
+using libp2p::security::noise::CipherState;
+using libp2p::security::noise::kLengthPrefixSize;
+using libp2p::security::noise::kMaxMsgLen;
+using libp2p::security::noise::kMaxPlainText;
+using libp2p::security::noise::kTagSize;
+using libp2p::security::noise::Key32;
+using testing::_;
+
+/// Noise connections over an in-memory pipe: frames written by `writer`
+/// are kept in `wire` and read from it by `reader`
+class NoiseConnectionTest : public testing::Test {
+ public:
+  void SetUp() override {
+    auto suite = libp2p::security::noise::defaultCipherSuite();
+    Key32 k1{};
+    Key32 k2{};
+    k1.fill(1);
+    k2.fill(2);
+    encoder = std::make_shared<CipherState>(suite, k1);
+
+    EXPECT_CALL(*raw_writer, writeSome(_, _))
+        .WillRepeatedly([this](BytesIn in, auto cb) {
+          ++raw_writes;
+          wire.insert(wire.end(), in.begin(), in.end());
+          cb(in.size());
+        });
+    EXPECT_CALL(*raw_reader, readSome(_, _))
+        .WillRepeatedly([this](BytesOut out, auto cb) {
+          ++raw_reads;
+          if (wire_offset == wire.size()) {
+            return cb(make_error_code(boost::asio::error::eof));
+          }
+          auto n = std::min(out.size(), wire.size() - wire_offset);
+          std::copy_n(wire.begin() + static_cast<ptrdiff_t>(wire_offset),
+                      n,
+                      out.begin());
+          wire_offset += n;
+          cb(n);
+        });
+
+    writer = std::make_shared<NoiseConnection>(
+        raw_writer,
+        libp2p::crypto::PublicKey{},
+        libp2p::crypto::PublicKey{},
+        marshaller,
+        encoder,
+        std::make_shared<CipherState>(suite, k2));
+    reader = std::make_shared<NoiseConnection>(
+        raw_reader,
+        libp2p::crypto::PublicKey{},
+        libp2p::crypto::PublicKey{},
+        marshaller,
+        std::make_shared<CipherState>(suite, k2),
+        std::make_shared<CipherState>(suite, k1));
+  }
+
+  /// Writes all bytes, returns # of bytes reported by each writeSome
+  std::vector<size_t> writeAll(BytesIn in) {
+    std::vector<size_t> written;
+    while (!in.empty()) {
+      writer->writeSome(in, [&](outcome::result<size_t> r) {
+        ASSERT_TRUE(r.has_value()) << r.error().message();
+        written.push_back(r.value());
+      });
+      if (written.empty() || written.back() == 0) {
+        break;
+      }
+      in = in.subspan(written.back());
+    }
+    return written;
+  }
+
+  /// Reads n bytes by readSome calls of at most chunk bytes each
+  Bytes readAll(size_t n, size_t chunk = kMaxMsgLen) {
+    Bytes out;
+    while (out.size() < n) {
+      Bytes buffer(std::min(chunk, n - out.size()));
+      bool done = false;
+      reader->readSome(buffer, [&](outcome::result<size_t> r) {
+        ASSERT_TRUE(r.has_value()) << r.error().message();
+        out.insert(out.end(), buffer.begin(), buffer.begin() + r.value());
+        ++reads;
+        done = true;
+      });
+      if (!done) {
+        break;
+      }
+    }
+    return out;
+  }
+
+  static Bytes makeData(size_t size) {
+    Bytes data(size);
+    for (size_t i = 0; i < size; ++i) {
+      data[i] = static_cast<uint8_t>(i * 7);
+    }
+    return data;
+  }
+
+  std::shared_ptr<LayerConnectionMock> raw_writer =
+      std::make_shared<LayerConnectionMock>();
+  std::shared_ptr<LayerConnectionMock> raw_reader =
+      std::make_shared<LayerConnectionMock>();
+  std::shared_ptr<libp2p::crypto::marshaller::KeyMarshallerMock> marshaller =
+      std::make_shared<libp2p::crypto::marshaller::KeyMarshallerMock>();
+  std::shared_ptr<CipherState> encoder;
+  std::shared_ptr<NoiseConnection> writer;
+  std::shared_ptr<NoiseConnection> reader;
+  Bytes wire;
+  size_t wire_offset = 0;
+  size_t raw_writes = 0;
+  size_t raw_reads = 0;
+  size_t reads = 0;
+};
+
+/**
+ * @given one frame of 1000 bytes
+ * @when it is read by 100 bytes
+ * @then the frame is read from the wire once and served by 10 reads
+ */
+TEST_F(NoiseConnectionTest, ShortReadsServedFromOneFrame) {
+  auto data = makeData(1000);
+  EXPECT_EQ(writeAll(data), std::vector<size_t>{data.size()});
+  EXPECT_EQ(wire.size(), kLengthPrefixSize + data.size() + kTagSize);
+
+  EXPECT_EQ(readAll(data.size(), 100), data);
+  EXPECT_EQ(reads, 10);
+  // length prefix and frame
+  EXPECT_EQ(raw_reads, 2);
+}
+
+/**
+ * @given zero length frame followed by a data frame
+ * @when data is read
+ * @then the empty frame is skipped
+ */
+TEST_F(NoiseConnectionTest, ZeroLengthFrameSkipped) {
+  wire.resize(CipherState::framedSize(0));
+  ASSERT_EQ(encoder->sealFrames({}, wire).value(), wire.size());
+  EXPECT_EQ(wire.size(), kLengthPrefixSize + kTagSize);
+  auto data = makeData(10);
+  writeAll(data);
+
+  EXPECT_EQ(readAll(data.size()), data);
+  EXPECT_EQ(reads, 1);
+  EXPECT_EQ(wire_offset, wire.size());
+}
+
+/**
+ * @given several buffers which don't fit into one frame together
+ * @when they are written with writeSomeV
+ * @then one full frame is written, the rest is written by the next call
+ */
+TEST_F(NoiseConnectionTest, WriteSomeVCrossesFrameBoundary) {
+  auto data = makeData(kMaxPlainText + 100);
+  std::array<BytesIn, 3> buffers{
+      BytesIn{data}.first(10),
+      BytesIn{data}.subspan(10, kMaxPlainText - 60),
+      BytesIn{data}.subspan(kMaxPlainText - 50),
+  };
+  size_t written = 0;
+  writer->writeSomeV(buffers, [&](outcome::result<size_t> r) {
+    written = r.value();
+  });
+  EXPECT_EQ(written, kMaxPlainText);
+  EXPECT_EQ(wire.size(), kLengthPrefixSize + kMaxMsgLen);
+
+  std::array<BytesIn, 2> rest{
+      BytesIn{data}.subspan(kMaxPlainText, 50),
+      BytesIn{data}.subspan(kMaxPlainText + 50),
+  };
+  writer->writeSomeV(rest, [&](outcome::result<size_t> r) {
+    written = r.value();
+  });
+  EXPECT_EQ(written, 100);
+  EXPECT_EQ(raw_writes, 2);
+
+  EXPECT_EQ(readAll(data.size()), data);
+}
+
+/**
+ * @given data larger than kMaxFramesPerWrite frames
+ * @when it is written
+ * @then the first write takes kMaxFramesPerWrite frames in one raw write
+ */
+TEST_F(NoiseConnectionTest, LargeWriteSplitIntoBatches) {
+  constexpr auto kBatch = NoiseConnection::kMaxFramesPerWrite * kMaxPlainText;
+  auto data = makeData(kBatch + kMaxPlainText + 5);
+  EXPECT_EQ(writeAll(data),
+            (std::vector<size_t>{kBatch, kMaxPlainText + 5}));
+  EXPECT_EQ(raw_writes, 2);
+  EXPECT_EQ(wire.size(),
+            data.size()
+                + (NoiseConnection::kMaxFramesPerWrite + 2)
+                      * (kLengthPrefixSize + kTagSize));
+
+  EXPECT_EQ(readAll(data.size(), 1000), data);
+}
+
+/**
+ * @given frame with tampered ciphertext
+ * @when it is read
+ * @then read fails
+ */
+TEST_F(NoiseConnectionTest, TamperedFrameFailsRead) {
+  auto data = makeData(100);
+  writeAll(data);
+  wire[kLengthPrefixSize + 5] ^= 1;
+
+  Bytes out(data.size());
+  std::optional<outcome::result<size_t>> result;
+  reader->readSome(out, [&](outcome::result<size_t> r) { result = r; });
+  ASSERT_TRUE(result);
+  EXPECT_TRUE(result->has_error());
+}
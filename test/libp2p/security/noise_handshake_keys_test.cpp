@@ -0,0 +1,83 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/noise/handshake_keys.hpp>
+
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <libp2p/security/crypto_thread_pool.hpp>
+#include <qtils/test/outcome.hpp>
+
+using libp2p::Bytes;
+using libp2p::crypto::Key;
+using libp2p::crypto::PublicKey;
+using libp2p::security::CryptoThreadPool;
+using libp2p::security::noise::DHKey;
+using libp2p::security::noise::HandshakeKeys;
+
+namespace {
+  PublicKey identity(uint8_t seed) {
+    return PublicKey{{Key::Type::Ed25519, Bytes(32, seed)}};
+  }
+}  // namespace
+
+/**
+ * @given handshake keys
+ * @when static key is requested several times for one identity
+ * @then payload is made once, new identity gets new static key
+ */
+TEST(NoiseHandshakeKeysTest, StaticKeyCached) {
+  auto keys = std::make_shared<HandshakeKeys>(nullptr);
+  size_t made = 0;
+  auto make = [&](const DHKey &keypair) -> outcome::result<Bytes> {
+    ++made;
+    return keypair.pub;
+  };
+  ASSERT_OUTCOME_SUCCESS(first, keys->staticKey(identity(1), make));
+  ASSERT_OUTCOME_SUCCESS(second, keys->staticKey(identity(1), make));
+  EXPECT_EQ(made, 1);
+  EXPECT_EQ(first.keypair.pub, second.keypair.pub);
+  EXPECT_EQ(first.payload, first.keypair.pub);
+
+  ASSERT_OUTCOME_SUCCESS(other, keys->staticKey(identity(2), make));
+  EXPECT_EQ(made, 2);
+  EXPECT_NE(other.keypair.pub, first.keypair.pub);
+}
+
+/**
+ * @given handshake keys with crypto executor, inline or with worker threads
+ * @when ephemeral keys are taken
+ * @then pool is refilled only by worker threads, each key is returned once
+ */
+TEST(NoiseHandshakeKeysTest, EphemeralKeysPooled) {
+  auto io = std::make_shared<boost::asio::io_context>();
+
+  auto inline_pool =
+      std::make_shared<CryptoThreadPool>(io, CryptoThreadPool::Config{});
+  auto inline_keys = std::make_shared<HandshakeKeys>(inline_pool, 4);
+  ASSERT_OUTCOME_SUCCESS(inline_key, inline_keys->ephemeralKey());
+  EXPECT_EQ(inline_keys->pooled(), 0);
+  EXPECT_EQ(inline_key.priv.size(), 32);
+
+  auto pool = std::make_shared<CryptoThreadPool>(
+      io, CryptoThreadPool::Config{.threads = 1});
+  auto keys = std::make_shared<HandshakeKeys>(pool, 4);
+  auto wait_pooled = [&] {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (keys->pooled() != 4 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return keys->pooled();
+  };
+  EXPECT_EQ(keys->pooled(), 0);
+  ASSERT_OUTCOME_SUCCESS(first, keys->ephemeralKey());
+  EXPECT_EQ(wait_pooled(), 4);
+  ASSERT_OUTCOME_SUCCESS(second, keys->ephemeralKey());
+  EXPECT_EQ(wait_pooled(), 4);
+  EXPECT_NE(first.pub, second.pub);
+  EXPECT_EQ(first.priv.size(), 32);
+}
@@ -0,0 +1,67 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/secio/secio_connection.hpp>
+
+#include <gtest/gtest.h>
+#include <libp2p/common/byteutil.hpp>
+#include <libp2p/crypto/aes_ctr/aes_ctr_impl.hpp>
+#include <libp2p/crypto/hmac_provider/hmac_provider_impl.hpp>
+
+#include "mock/libp2p/connection/layer_connection_mock.hpp"
+#include "mock/libp2p/crypto/key_marshaller_mock.hpp"
+
+using libp2p::Bytes;
+using libp2p::BytesIn;
+using libp2p::connection::LayerConnectionMock;
+using libp2p::connection::SecioConnection;
+using testing::_;
+
+/**
+ * @given initialized SECIO connection
+ * @when frame header and payload are written with one writeSomeV
+ * @then they reach the wire as one secured frame
+ */
+TEST(SecioConnection, WriteSomeVWritesOneFrame) {
+  auto raw = std::make_shared<LayerConnectionMock>();
+  libp2p::crypto::StretchedKey key{
+      Bytes(16, 1), Bytes(16, 2), Bytes(20, 3)};
+  auto connection = std::make_shared<SecioConnection>(
+      raw,
+      std::make_shared<libp2p::crypto::hmac::HmacProviderImpl>(),
+      std::make_shared<libp2p::crypto::marshaller::KeyMarshallerMock>(),
+      libp2p::crypto::PublicKey{},
+      libp2p::crypto::PublicKey{},
+      libp2p::crypto::common::HashType::SHA256,
+      libp2p::crypto::common::CipherType::AES128,
+      key,
+      key);
+  ASSERT_TRUE(connection->init());
+
+  std::vector<Bytes> frames;
+  EXPECT_CALL(*raw, writeSome(_, _))
+      .WillRepeatedly([&](BytesIn in, auto cb) {
+        frames.emplace_back(in.begin(), in.end());
+        cb(in.size());
+      });
+
+  Bytes header(12, 0xaa), payload(100, 0xbb);
+  std::array<BytesIn, 2> buffers{header, payload};
+  size_t written = 0;
+  connection->writeSomeV(buffers, [&](outcome::result<size_t> r) {
+    written = r.value();
+  });
+
+  EXPECT_EQ(written, header.size() + payload.size());
+  ASSERT_EQ(frames.size(), 1);
+  constexpr size_t kMacSize = 32;
+  const auto &frame = frames[0];
+  ASSERT_EQ(frame.size(),
+            SecioConnection::kLenMarkerSize + written + kMacSize);
+  Bytes length;
+  libp2p::common::putUint32BE(length, written + kMacSize);
+  EXPECT_TRUE(std::equal(length.begin(), length.end(), frame.begin()));
+}
@@ -0,0 +1,80 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/tls/tls_details.hpp>
+
+#include <gtest/gtest.h>
+#include <openssl/x509.h>
+#include <libp2p/crypto/ed25519_provider/ed25519_provider_impl.hpp>
+#include <libp2p/crypto/key_marshaller/key_marshaller_impl.hpp>
+
+#include "mock/libp2p/crypto/key_validator_mock.hpp"
+
+using libp2p::crypto::Key;
+using libp2p::crypto::KeyPair;
+using libp2p::crypto::PublicKey;
+using libp2p::crypto::marshaller::KeyMarshallerImpl;
+using libp2p::crypto::validator::KeyValidatorMock;
+using libp2p::security::tls_details::CertificateCache;
+using libp2p::security::tls_details::kCertificateCacheSize;
+using libp2p::security::tls_details::makeCertificate;
+using libp2p::security::tls_details::verifyPeerAndExtractIdentity;
+using testing::An;
+using testing::Return;
+
+class TlsDetailsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ON_CALL(*validator, validate(An<const PublicKey &>()))
+        .WillByDefault(Return(outcome::success()));
+  }
+
+  /// Makes libp2p certificate of random host key
+  std::shared_ptr<X509> certificate() {
+    auto keys = libp2p::crypto::ed25519::Ed25519ProviderImpl{}.generate();
+    KeyPair host_keys{
+        {{Key::Type::Ed25519,
+          {keys.value().public_key.begin(), keys.value().public_key.end()}}},
+        {{Key::Type::Ed25519,
+          {keys.value().private_key.begin(),
+           keys.value().private_key.end()}}}};
+    auto der = makeCertificate(host_keys, marshaller).certificate;
+    const uint8_t *data = der.data();
+    return {d2i_X509(nullptr, &data, static_cast<long>(der.size())),
+            X509_free};
+  }
+
+  std::shared_ptr<KeyValidatorMock> validator =
+      std::make_shared<testing::NiceMock<KeyValidatorMock>>();
+  KeyMarshallerImpl marshaller{validator};
+  CertificateCache cache{kCertificateCacheSize};
+};
+
+/**
+ * @given certificate cache
+ * @when same certificate is verified twice, then other one
+ * @then second verification is cache hit, other certificate misses
+ */
+TEST_F(TlsDetailsTest, CertificateCacheStats) {
+  auto cert = certificate();
+  auto id = verifyPeerAndExtractIdentity(cert.get(), marshaller, &cache);
+  ASSERT_TRUE(id);
+  EXPECT_EQ(cache.stats().misses, 1);
+  EXPECT_EQ(cache.stats().hits, 0);
+
+  auto cached = verifyPeerAndExtractIdentity(cert.get(), marshaller, &cache);
+  ASSERT_TRUE(cached);
+  EXPECT_EQ(cached.value().peer_id, id.value().peer_id);
+  EXPECT_EQ(cache.stats().misses, 1);
+  EXPECT_EQ(cache.stats().hits, 1);
+
+  auto other = verifyPeerAndExtractIdentity(
+      certificate().get(), marshaller, &cache);
+  ASSERT_TRUE(other);
+  EXPECT_NE(other.value().peer_id, id.value().peer_id);
+  EXPECT_EQ(cache.stats().misses, 2);
+  EXPECT_EQ(cache.stats().hits, 1);
+}
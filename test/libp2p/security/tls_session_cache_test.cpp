@@ -0,0 +1,58 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/security/tls/tls_session_cache.hpp>
+
+#include <gtest/gtest.h>
+#include <openssl/ssl.h>
+#include <testutil/libp2p/peer.hpp>
+
+using libp2p::crypto::Key;
+using libp2p::crypto::PublicKey;
+using libp2p::multi::Multiaddress;
+using libp2p::security::TlsSessionCache;
+
+class TlsSessionCacheTest : public ::testing::Test {
+ protected:
+  TlsSessionCache::Entry entry(const libp2p::peer::PeerId &peer) {
+    return {.session = {SSL_SESSION_new(), SSL_SESSION_free},
+            .identity = {.public_key = PublicKey{{Key::Type::Ed25519, {}}},
+                         .peer_id = peer}};
+  }
+
+  libp2p::peer::PeerId peer = testutil::randomPeerId();
+  Multiaddress address =
+      Multiaddress::create("/ip4/127.0.0.1/tcp/4001").value();
+  TlsSessionCache cache;
+};
+
+/**
+ * @given session cached for peer and address
+ * @when it is taken twice
+ * @then it is returned only once
+ */
+TEST_F(TlsSessionCacheTest, TakeOnce) {
+  auto key = TlsSessionCache::key(peer, address);
+  auto stored = entry(peer);
+  cache.put(key, stored);
+  auto taken = cache.take(key, peer);
+  ASSERT_TRUE(taken);
+  EXPECT_EQ(taken->session, stored.session);
+  EXPECT_FALSE(cache.take(key, peer));
+}
+
+/**
+ * @given session cached for peer
+ * @when it is taken for connection which expects other peer id
+ * @then no session is returned and cached one is dropped
+ */
+TEST_F(TlsSessionCacheTest, IdentityMismatch) {
+  auto other = testutil::randomPeerId();
+  auto key = TlsSessionCache::key(other, address);
+  cache.put(key, entry(peer));
+  EXPECT_FALSE(cache.take(key, other));
+  EXPECT_FALSE(cache.take(key, peer));
+}
@@ -88,6 +88,11 @@ namespace libp2p::connection {
       return real_->writeSome(in, f);
     }
 
+    void writeSomeV(std::span<const BytesIn> in,
+                    Writer::WriteCallbackFunc f) override {
+      return real_->writeSomeV(in, f);
+    }
+
     bool isClosed() const override {
       return real_->isClosed();
     }